@@ -0,0 +1,210 @@
+/*
+ * Copyright (C) 2021 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef ESPRESSO_CORE_BOND_LISTS_HPP
+#define ESPRESSO_CORE_BOND_LISTS_HPP
+
+#include "Particle.hpp"
+#include "bond_error.hpp"
+
+#include <utils/Span.hpp>
+
+#include <boost/container/static_vector.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Bonds of the local particles with resolved partners.
+ *
+ * The bonds are grouped by bond id. For every bond of a group,
+ * the particle holding the bond and its partners are stored
+ * consecutively as particle pointers, so a group can be evaluated
+ * in a single loop without id lookups, and the interaction type
+ * has to be dispatched only once per group. Bonds whose partners
+ * could not be resolved are kept separately, so that they are
+ * reported on every evaluation, like @ref bond_broken_error does
+ * for the lookup on the fly.
+ *
+ * The lists hold pointers to the particles, so they are only
+ * valid as long as the particles are not resorted and the bonds
+ * do not change. @ref BondLists::clear keeps the allocated memory,
+ * so that the lists can be rebuilt without new allocations.
+ */
+class BondLists {
+public:
+  /** @brief Bonds with the same bond id and number of partners. */
+  class Group {
+    int m_bond_id;
+    int m_n_partners;
+    std::vector<Particle *> m_particles;
+
+  public:
+    Group(int bond_id, int n_partners)
+        : m_bond_id(bond_id), m_n_partners(n_partners) {}
+
+    int bond_id() const { return m_bond_id; }
+    int n_partners() const { return m_n_partners; }
+    /** Number of bonds */
+    std::size_t size() const {
+      return m_particles.size() / (m_n_partners + 1);
+    }
+    /** Particle holding bond @p i, followed by its partners */
+    Utils::Span<Particle *> operator[](std::size_t i) {
+      return {m_particles.data() + i * (m_n_partners + 1),
+              static_cast<std::size_t>(m_n_partners + 1)};
+    }
+
+    void clear() { m_particles.clear(); }
+    void add(Particle &p, Utils::Span<Particle *const> partners) {
+      assert(partners.size() == static_cast<std::size_t>(m_n_partners));
+      m_particles.push_back(&p);
+      m_particles.insert(m_particles.end(), partners.begin(), partners.end());
+    }
+  };
+
+private:
+  struct BrokenBond {
+    int id;
+    boost::container::static_vector<int, 4> partner_ids;
+  };
+
+  std::vector<Group> m_groups;
+  /** Index of the first group of a bond id, -1 if there is none */
+  std::vector<int> m_first_group;
+  std::vector<BrokenBond> m_broken;
+  bool m_valid = false;
+
+  Group &group(int bond_id, int n_partners) {
+    if (static_cast<std::size_t>(bond_id) >= m_first_group.size())
+      m_first_group.resize(bond_id + 1, -1);
+
+    auto &first = m_first_group[bond_id];
+    if (first == -1) {
+      first = static_cast<int>(m_groups.size());
+      m_groups.emplace_back(bond_id, n_partners);
+      return m_groups.back();
+    }
+
+    /* Bonds with the same id and a different number of
+     * partners are not expected, but kept apart anyway. */
+    auto const it = std::find_if(
+        m_groups.begin() + first, m_groups.end(), [=](Group const &g) {
+          return g.bond_id() == bond_id and g.n_partners() == n_partners;
+        });
+    if (it != m_groups.end())
+      return *it;
+
+    m_groups.emplace_back(bond_id, n_partners);
+    return m_groups.back();
+  }
+
+public:
+  /** @brief Whether the lists reflect the current particles. */
+  bool valid() const { return m_valid; }
+  /** @brief Mark the lists for a rebuild. */
+  void invalidate() { m_valid = false; }
+
+  /** @brief Remove all bonds, and mark the lists as valid. */
+  void clear() {
+    for (auto &g : m_groups) {
+      g.clear();
+    }
+    m_broken.clear();
+    m_valid = true;
+  }
+
+  /**
+   * @brief Add a bond.
+   *
+   * @param p Particle holding the bond.
+   * @param bond_id Id of the bond.
+   * @param partners Resolved bond partners.
+   */
+  void add(Particle &p, int bond_id, Utils::Span<Particle *const> partners) {
+    group(bond_id, static_cast<int>(partners.size())).add(p, partners);
+  }
+
+  /**
+   * @brief Add a bond whose partners could not be resolved.
+   *
+   * @param id Id of the particle holding the bond.
+   * @param partner_ids Ids of the bond partners.
+   */
+  void add_broken(int id, Utils::Span<const int> partner_ids) {
+    m_broken.push_back({id, {partner_ids.begin(), partner_ids.end()}});
+  }
+
+  /** @brief Groups of bonds, possibly empty. */
+  std::vector<Group> &groups() { return m_groups; }
+
+  /** @brief Report the bonds whose partners could not be resolved. */
+  void report_broken_bonds() const {
+    for (auto const &b : m_broken) {
+      bond_broken_error(b.id, Utils::make_const_span(b.partner_ids));
+    }
+  }
+
+  /**
+   * @brief Execute kernel for every bond.
+   *
+   * This has the same interface as
+   * CellStructure::execute_bond_handler.
+   *
+   * @tparam Handler Callable, which can be invoked with
+   *                 (Particle, int, Utils::Span<Particle *>),
+   *                 returning a bool.
+   * @param handler is called for every bond, and handed
+   *                the particle holding the bond, the bond id
+   *                and a span with the bond partners as arguments.
+   *                Its return value should indicate if the bond
+   *                was broken.
+   */
+  template <class Handler> void for_each_bond(Handler handler) {
+    for (auto &g : m_groups) {
+      for (std::size_t i = 0; i < g.size(); i++) {
+        auto const bond = g[i];
+        auto const partners =
+            Utils::Span<Particle *>(bond.data() + 1, bond.size() - 1);
+        if (handler(*bond[0], g.bond_id(), partners)) {
+          report_broken_bond(bond);
+        }
+      }
+    }
+
+    report_broken_bonds();
+  }
+
+  /**
+   * @brief Report a bond as broken.
+   *
+   * @param bond Particle holding the bond, followed by its partners.
+   */
+  static void report_broken_bond(Utils::Span<Particle *> bond) {
+    boost::container::static_vector<int, 4> partner_ids;
+    for (std::size_t i = 1; i < bond.size(); i++) {
+      partner_ids.push_back(bond[i]->identity());
+    }
+    bond_broken_error(bond[0]->identity(),
+                      Utils::make_const_span(partner_ids));
+  }
+};
+
+#endif
@@ -21,6 +21,8 @@
 
 #include "Particle.hpp"
 #include "ParticleList.hpp"
+#include "ParticleSoA.hpp"
+#include "VerletList.hpp"
 
 #include <utils/Span.hpp>
 
@@ -107,7 +109,11 @@ public:
   neighbors_type m_neighbors;
 
   /** Interaction pairs */
-  std::vector<std::pair<Particle *, Particle *>> m_verlet_list;
+  VerletList m_verlet_list;
+
+  /** Structure-of-arrays mirror of the particles, only
+   *  filled if the cell system uses it. */
+  ParticleSoA m_soa;
 
   /**
    * @brief All neighbors of the cell.
@@ -23,9 +23,20 @@
 
 #include "AtomDecomposition.hpp"
 #include "DomainDecomposition.hpp"
+#include "algorithm/colored_cells.hpp"
+#include "config.hpp"
+#include "timings.hpp"
 
 #include <utils/contains.hpp>
 
+#include <boost/iterator/indirect_iterator.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
 Cell *CellStructure::particle_to_cell(const Particle &p) {
   return decomposition().particle_to_cell(p);
 }
@@ -83,10 +94,7 @@ Particle *CellStructure::add_particle(Particle &&p) {
 }
 
 int CellStructure::get_max_local_particle_id() const {
-  auto it = std::find_if(m_particle_index.rbegin(), m_particle_index.rend(),
-                         [](const Particle *p) { return p != nullptr; });
-
-  return (it != m_particle_index.rend()) ? (*it)->identity() : -1;
+  return m_particle_index.max_id();
 }
 
 void CellStructure::remove_all_particles() {
@@ -95,6 +103,47 @@ void CellStructure::remove_all_particles() {
   }
 
   m_particle_index.clear();
+  m_bond_lists.invalidate();
+}
+
+BondLists &CellStructure::bond_lists() {
+  if (m_bond_lists.valid())
+    return m_bond_lists;
+
+  m_bond_lists.clear();
+  for (auto &p : local_particles()) {
+    for (const BondView bond : p.bonds()) {
+      auto const partner_ids = bond.partner_ids();
+
+      try {
+        auto const partners = resolve_bond_partners(partner_ids);
+        m_bond_lists.add(p, bond.bond_id(), Utils::make_const_span(partners));
+      } catch (const BondResolutionError &) {
+        m_bond_lists.add_broken(p.identity(), partner_ids);
+      }
+    }
+  }
+
+  return m_bond_lists;
+}
+
+void CellStructure::set_use_sparse_particle_index(bool sparse) {
+  auto const local = local_particles();
+  auto const ghosts = ghost_particles();
+
+  m_particle_index.set_sparse(sparse);
+  m_particle_index.reserve(local.size() + ghosts.size());
+
+  for (auto &p : local) {
+    update_particle_index(p);
+  }
+  /* Ghosts are only indexed if there is no real particle
+   * with the same id, see cells_update_ghosts_begin(). */
+  for (auto &p : ghosts) {
+    if (not get_local_particle(p.identity())) {
+      update_particle_index(p);
+    }
+  }
 }
 
 /* Map the data parts flags from cells to those used internally
@@ -113,18 +162,95 @@ static unsigned map_data_parts(unsigned data_parts) {
 }
 
 void CellStructure::ghosts_update(unsigned data_parts) {
+  ghosts_wait();
+  Timings::ScopedTimer timer(Timings::Section::GHOST_COMMUNICATION);
   ghost_communicator(decomposition().exchange_ghosts_comm(),
                      map_data_parts(data_parts));
 }
+void CellStructure::ghosts_update_begin(unsigned data_parts) {
+  if (overlap_ghost_communication) {
+    Timings::ScopedTimer timer(Timings::Section::GHOST_COMMUNICATION);
+    m_ghost_update.begin(decomposition().exchange_ghosts_comm(),
+                         map_data_parts(data_parts));
+  } else {
+    ghosts_update(data_parts);
+  }
+}
+void CellStructure::ghosts_wait() {
+  if (m_ghost_update.pending()) {
+    Timings::ScopedTimer timer(Timings::Section::GHOST_COMMUNICATION);
+    m_ghost_update.wait();
+  }
+}
 void CellStructure::ghosts_reduce_forces() {
+  ghosts_wait();
+  Timings::ScopedTimer timer(Timings::Section::GHOST_COMMUNICATION);
   ghost_communicator(decomposition().collect_ghost_force_comm(),
                      GHOSTTRANS_FORCE);
 }
 
+void CellStructure::update_soa_mirror(Utils::Span<Cell *> cells) {
+  auto const n_cells = static_cast<long>(cells.size());
+#ifdef OPENMP
+#pragma omp parallel for num_threads(n_threads)
+#endif
+  for (long i = 0; i < n_cells; i++) {
+    cells[i]->m_soa.pack(cells[i]->particles());
+  }
+}
+
+void CellStructure::scatter_soa_forces() {
+  for (auto cells : {decomposition().local_cells(),
+                     decomposition().ghost_cells()}) {
+    auto const n_cells = static_cast<long>(cells.size());
+#ifdef OPENMP
+#pragma omp parallel for num_threads(n_threads)
+#endif
+    for (long i = 0; i < n_cells; i++) {
+      cells[i]->m_soa.scatter_forces();
+    }
+  }
+}
+
+CellColors const &CellStructure::cell_colors() {
+  if (m_cell_colors.interior.empty() and m_cell_colors.boundary.empty()) {
+    auto const cells = decomposition().local_cells();
+    auto const colors =
+        Algorithm::color_cells(boost::make_indirect_iterator(cells.begin()),
+                               boost::make_indirect_iterator(cells.end()));
+
+    std::unordered_set<Cell const *> const local(cells.begin(), cells.end());
+    auto const is_interior = [&local](Cell *cell) {
+      auto const red = cell->neighbors().red();
+      return std::all_of(red.begin(), red.end(), [&local](Cell *neighbor) {
+        return local.count(neighbor) != 0;
+      });
+    };
+
+    for (auto const &color : colors) {
+      std::vector<Cell *> interior, boundary;
+      std::partition_copy(color.begin(), color.end(),
+                          std::back_inserter(interior),
+                          std::back_inserter(boundary), is_interior);
+
+      if (not interior.empty())
+        m_cell_colors.interior.push_back(std::move(interior));
+      if (not boundary.empty())
+        m_cell_colors.boundary.push_back(std::move(boundary));
+    }
+  }
+
+  return m_cell_colors;
+}
+
 Utils::Span<Cell *> CellStructure::local_cells() {
   return decomposition().local_cells();
 }
 
+Utils::Span<Cell *> CellStructure::ghost_cells() {
+  return decomposition().ghost_cells();
+}
+
 ParticleRange CellStructure::local_particles() {
   return Cells::particles(decomposition().local_cells());
 }
@@ -152,7 +278,10 @@ struct UpdateParticleIndexVisitor {
 } // namespace
 
 void CellStructure::resort_particles(int global_flag) {
+  ghosts_wait();
+  Timings::ScopedTimer timer(Timings::Section::RESORT);
   invalidate_ghosts();
+  m_bond_lists.invalidate();
 
   static std::vector<ParticleChange> diff;
   diff.clear();
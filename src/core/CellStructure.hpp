@@ -23,11 +23,13 @@
 #define ESPRESSO_CELLSTRUCTURE_HPP
 
 #include "AtomDecomposition.hpp"
+#include "BondLists.hpp"
 #include "BoxGeometry.hpp"
 #include "Cell.hpp"
 #include "LocalBox.hpp"
 #include "Particle.hpp"
 #include "ParticleDecomposition.hpp"
+#include "ParticleIndex.hpp"
 #include "ParticleList.hpp"
 #include "ParticleRange.hpp"
 #include "bond_error.hpp"
@@ -80,6 +82,16 @@ inline ParticleRange particles(Utils::Span<Cell *> cells) {
 }
 } // namespace Cells
 
+/**
+ * @brief Local cells grouped by color, see @ref CellStructure::cell_colors.
+ */
+struct CellColors {
+  /** Cells whose red neighbors are all local cells */
+  std::vector<std::vector<Cell *>> interior;
+  /** Cells with ghost cells among their red neighbors */
+  std::vector<std::vector<Cell *>> boundary;
+};
+
 /** Describes a cell structure / cell system. Contains information
  *  about the communication of cell contents (particles, ghosts, ...)
  *  between different nodes and the relation between particle
@@ -90,7 +102,7 @@ inline ParticleRange particles(Utils::Span<Cell *> cells) {
 struct CellStructure {
 private:
   /** The local id-to-particle index */
-  std::vector<Particle *> m_particle_index;
+  ParticleIndex m_particle_index;
   /** Implementation of the primary particle decomposition */
   std::unique_ptr<ParticleDecomposition> m_decomposition =
       std::make_unique<AtomDecomposition>();
@@ -99,9 +111,26 @@ private:
   /** One of @ref Cells::Resort, announces the level of resort needed.
    */
   unsigned m_resort_particles = Cells::RESORT_NONE;
+  /** Local cells grouped by color, see @ref CellStructure::cell_colors */
+  CellColors m_cell_colors;
+  /** Ghost update in flight, see @ref CellStructure::ghosts_update_begin */
+  AsyncGhostCommunication m_ghost_update;
+  /** Bonds of the local particles, see @ref CellStructure::bond_lists */
+  BondLists m_bond_lists;
 
 public:
   bool use_verlet_list = true;
+  /** Number of times the Verlet lists were rebuilt */
+  int verlet_list_rebuilds = 0;
+  /** Use the structure-of-arrays mirror of the cells for
+   *  the non-bonded pair loop, if the active interactions allow it. */
+  bool use_soa_mirror = false;
+  /** Number of threads for the pair loop on the
+   *  structure-of-arrays mirror. */
+  int n_threads = 1;
+  /** Overlap the ghost update before the force calculation
+   *  with the pair loop on the structure-of-arrays mirror. */
+  bool overlap_ghost_communication = false;
 
   /**
    * @brief Update local particle index.
@@ -116,10 +145,8 @@ public:
     assert(id >= 0);
     assert(not p or id == p->identity());
 
-    if (id >= m_particle_index.size())
-      m_particle_index.resize(id + 1);
-
-    m_particle_index[id] = p;
+    m_particle_index.set(id, p);
+    m_bond_lists.invalidate();
   }
 
   /**
@@ -148,7 +175,31 @@ public:
   /**
    * @brief Clear the particles index.
    */
-  void clear_particle_index() { m_particle_index.clear(); }
+  void clear_particle_index() {
+    m_particle_index.clear();
+    m_bond_lists.invalidate();
+  }
+
+  /** Whether the local particle index is a hash table
+   *  instead of a vector indexed by the particle id. */
+  bool use_sparse_particle_index() const { return m_particle_index.sparse(); }
+
+  /**
+   * @brief Select the layout of the local particle index.
+   *
+   * The dense index needs memory for all ids up to the largest
+   * id seen on this node, the sparse index only for the local
+   * and ghost particles, at the cost of slower lookups.
+   * The index is rebuilt from the particles.
+   *
+   * @param sparse Use the sparse index.
+   */
+  void set_use_sparse_particle_index(bool sparse);
+
+  /** Memory allocated by the local particle index in bytes */
+  std::size_t particle_index_memory() const {
+    return m_particle_index.memory();
+  }
 
 private:
   /**
@@ -181,23 +232,11 @@ public:
    * @return Pointer to particle if it is local,
    *         nullptr otherwise.
    */
-  Particle *get_local_particle(int id) {
-    assert(id >= 0);
-
-    if (id >= m_particle_index.size())
-      return nullptr;
-
-    return m_particle_index[id];
-  }
+  Particle *get_local_particle(int id) { return m_particle_index.get(id); }
 
   /** @overload */
   const Particle *get_local_particle(int id) const {
-    assert(id >= 0);
-
-    if (id >= m_particle_index.size())
-      return nullptr;
-
-    return m_particle_index[id];
+    return m_particle_index.get(id);
   }
 
   template <class InputRange, class OutputIterator>
@@ -214,6 +253,8 @@ public:
 
   /** Return the global local_cells */
   Utils::Span<Cell *> local_cells();
+  /** Return the ghost cells */
+  Utils::Span<Cell *> ghost_cells();
   ParticleRange local_particles();
   ParticleRange ghost_particles();
 
@@ -327,11 +368,60 @@ public:
    * Cells::DataPart
    */
   void ghosts_update(unsigned data_parts);
+  /**
+   * @brief Start an update of the ghost particles.
+   *
+   * If @ref overlap_ghost_communication is set, the update may
+   * still be in flight on return. It then has to be completed by
+   * @ref ghosts_wait before the updated parts of the ghost particles
+   * are accessed. Otherwise this is the same as @ref ghosts_update.
+   *
+   * @param data_parts Particle parts to update, combination of @ref
+   * Cells::DataPart
+   */
+  void ghosts_update_begin(unsigned data_parts);
+  /**
+   * @brief Advance a ghost update started by @ref ghosts_update_begin,
+   *        without blocking.
+   */
+  void ghosts_progress() { m_ghost_update.progress(); }
+  /**
+   * @brief Complete a ghost update started by @ref ghosts_update_begin.
+   */
+  void ghosts_wait();
   /**
    * @brief Add forces from ghost particles to real particles.
    */
   void ghosts_reduce_forces();
 
+  /**
+   * @brief Pack the structure-of-arrays mirror of cells.
+   *
+   * Has to be called after the positions of the particles
+   * in the cells are updated, and before the mirror is used
+   * in a pair loop.
+   *
+   * @param cells Cells to pack.
+   */
+  void update_soa_mirror(Utils::Span<Cell *> cells);
+  /**
+   * @brief Add the forces accumulated in the structure-of-arrays
+   *        mirror to the local and ghost particles.
+   */
+  void scatter_soa_forces();
+
+  /**
+   * @brief Local cells grouped into colors, such that
+   *        the pair loops over the cells of one color
+   *        do not write to the same cells.
+   *
+   * Every color is split into the interior cells, whose
+   * pairs do not involve ghost particles, and the boundary
+   * cells. The coloring is computed on first use after the
+   * particle decomposition was changed.
+   */
+  CellColors const &cell_colors();
+
 private:
   /**
    * @brief Resolve ids to particles.
@@ -356,6 +446,19 @@ private:
   }
 
 public:
+  /**
+   * @brief Bonds of the local particles with resolved partners.
+   *
+   * The lists are rebuilt on first use after the particles were
+   * resorted or the local particle index changed. Changes of
+   * the bonds of a particle that do not go along with a resort
+   * have to be announced by @ref invalidate_bond_lists.
+   */
+  BondLists &bond_lists();
+
+  /** @brief Rebuild the bond lists on their next use. */
+  void invalidate_bond_lists() { m_bond_lists.invalidate(); }
+
   /**
    * @brief Execute kernel for every bond on particle.
    * @tparam Handler Callable, which can be invoked with
@@ -408,12 +511,15 @@ private:
   /** @brief Set the particle decomposition, keeping the particles. */
   void set_particle_decomposition(
       std::unique_ptr<ParticleDecomposition> &&decomposition) {
+    ghosts_wait();
     clear_particle_index();
 
     auto local_parts = local_particles();
     std::vector<Particle> particles(local_parts.begin(), local_parts.end());
+    m_particle_index.reserve(particles.size());
 
     m_decomposition = std::move(decomposition);
+    m_cell_colors = {};
 
     for (auto &p : particles) {
       add_particle(std::move(p));
@@ -0,0 +1,163 @@
+/*
+ * Copyright (C) 2021 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef CORE_CUBIC_SPLINE_TABLE_HPP
+#define CORE_CUBIC_SPLINE_TABLE_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+/** Evaluate a function by cubic spline interpolation.
+ *
+ *  The function is sampled uniformly between @ref minval and
+ *  @ref maxval and interpolated by a twice continuously
+ *  differentiable cubic spline with not-a-knot end conditions,
+ *  so that the interpolation error is of fourth order in the
+ *  sampling distance also at the ends of the table. The
+ *  polynomial coefficients are stored per interval, so an
+ *  evaluation is one lookup and a polynomial of degree three.
+ */
+class CubicSplineTable {
+  double m_minval = 0.;
+  double m_maxval = 0.;
+  double m_invstepsize = 0.;
+  /** Coefficients of the polynomials in the interval coordinate,
+   *  four per interval, lowest order first. */
+  std::vector<double> m_coefficients;
+
+public:
+  CubicSplineTable() = default;
+
+  /** Sample and interpolate a function.
+   *  @param f             Function to interpolate.
+   *  @param minval        Start of the table.
+   *  @param maxval        End of the table.
+   *  @param n_intervals   Number of intervals, at least four.
+   */
+  template <class F>
+  CubicSplineTable(F f, double minval, double maxval, int n_intervals)
+      : m_minval(minval), m_maxval(maxval),
+        m_invstepsize(n_intervals / (maxval - minval)) {
+    assert(n_intervals >= 4);
+    assert(maxval > minval);
+
+    auto const n = static_cast<std::size_t>(n_intervals);
+    auto const step = (maxval - minval) / n_intervals;
+    std::vector<double> y(n + 1);
+    for (std::size_t i = 0; i <= n; i++) {
+      y[i] = f((i == n) ? maxval : minval + i * step);
+    }
+
+    /* Second derivatives with respect to the interval coordinate,
+     * m[i-1] + 4 m[i] + m[i+1] = 6 (y[i-1] - 2 y[i] + y[i+1]).
+     * The not-a-knot conditions m[0] - 2 m[1] + m[2] = 0 and
+     * m[n-2] - 2 m[n-1] + m[n] = 0 decouple m[1] and m[n-1],
+     * the others follow from a tridiagonal system. */
+    std::vector<double> m(n + 1);
+    auto const rhs = [&y](std::size_t i) {
+      return 6. * (y[i - 1] - 2. * y[i] + y[i + 1]);
+    };
+    m[1] = rhs(1) / 6.;
+    m[n - 1] = rhs(n - 1) / 6.;
+
+    std::vector<double> diag(n, 4.);
+    for (std::size_t i = 2; i <= n - 2; i++) {
+      m[i] = rhs(i);
+    }
+    m[2] -= m[1];
+    m[n - 2] -= m[n - 1];
+    for (std::size_t i = 3; i <= n - 2; i++) {
+      auto const w = 1. / diag[i - 1];
+      diag[i] -= w;
+      m[i] -= w * m[i - 1];
+    }
+    for (std::size_t i = n - 2; i >= 2; i--) {
+      if (i < n - 2)
+        m[i] -= m[i + 1];
+      m[i] /= diag[i];
+    }
+    m[0] = 2. * m[1] - m[2];
+    m[n] = 2. * m[n - 1] - m[n - 2];
+
+    m_coefficients.resize(4 * n);
+    for (std::size_t i = 0; i < n; i++) {
+      auto c = m_coefficients.data() + 4 * i;
+      c[0] = y[i];
+      c[1] = y[i + 1] - y[i] - (2. * m[i] + m[i + 1]) / 6.;
+      c[2] = 0.5 * m[i];
+      c[3] = (m[i + 1] - m[i]) / 6.;
+    }
+  }
+
+  /** Position on the x-axis of the first tabulated value. */
+  double minval() const { return m_minval; }
+  /** Position on the x-axis of the last tabulated value. */
+  double maxval() const { return m_maxval; }
+  /** Number of intervals, 0 for an empty table. */
+  int n_intervals() const {
+    return static_cast<int>(m_coefficients.size() / 4);
+  }
+
+  /** Evaluate the interpolation at position @p x.
+   *  @param x  Position in [@ref minval, @ref maxval].
+   */
+  double operator()(double x) const {
+    assert(not m_coefficients.empty());
+    auto const pos = (x - m_minval) * m_invstepsize;
+    auto const i = std::min(static_cast<std::size_t>(pos),
+                            m_coefficients.size() / 4 - 1);
+    auto const t = pos - static_cast<double>(i);
+    auto const c = m_coefficients.data() + 4 * i;
+    return c[0] + t * (c[1] + t * (c[2] + t * c[3]));
+  }
+
+  /** Largest deviation from @p f in the middle of the intervals,
+   *  where the interpolation error of a spline is largest.
+   *
+   *  The deviation is relative to the largest magnitude of @p f at
+   *  the interval middle and ends, so that it is also meaningful
+   *  close to zeros of the function.
+   *  @param f  Interpolated function.
+   */
+  template <class F> double max_relative_deviation(F f) const {
+    double deviation = 0.;
+    auto const step = 1. / m_invstepsize;
+    auto f_left = f(m_minval);
+    for (int i = 0; i < n_intervals(); i++) {
+      auto const x = m_minval + (i + 0.5) * step;
+      auto const f_mid = f(x);
+      auto const f_right =
+          f((i + 1 == n_intervals()) ? m_maxval : m_minval + (i + 1) * step);
+      auto const error = std::abs((*this)(x)-f_mid);
+      if (error > 0.) {
+        auto const scale = std::max(
+            {std::abs(f_left), std::abs(f_mid), std::abs(f_right),
+             std::numeric_limits<double>::min()});
+        deviation = std::max(deviation, error / scale);
+      }
+      f_left = f_right;
+    }
+    return deviation;
+  }
+};
+
+#endif
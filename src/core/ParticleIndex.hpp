@@ -0,0 +1,243 @@
+/*
+ * Copyright (C) 2021 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef ESPRESSO_CORE_PARTICLE_INDEX_HPP
+#define ESPRESSO_CORE_PARTICLE_INDEX_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+struct Particle;
+
+/**
+ * @brief Map from particle ids to local particles.
+ *
+ * In the dense layout, the index is a vector of pointers indexed
+ * by the id. Lookups are a single load, but the memory grows with
+ * the largest id seen on this node, independent of the number of
+ * particles the node holds.
+ *
+ * In the sparse layout, the index is a hash table with open
+ * addressing and linear probing, whose memory is proportional
+ * to the number of indexed particles. Removed entries are
+ * filled by shifting back the following entries of their probe
+ * sequence, so that the table never contains tombstones.
+ *
+ * In both layouts, @ref ParticleIndex::clear keeps the allocated
+ * memory, so that the index can be rebuilt without new allocations.
+ */
+class ParticleIndex {
+  struct Entry {
+    int id;
+    Particle *p;
+  };
+
+  /** Dense layout: particle by id */
+  std::vector<Particle *> m_dense;
+  /** Sparse layout: hash table, free entries have id -1 */
+  std::vector<Entry> m_table;
+  /** Sparse layout: number of occupied entries */
+  std::size_t m_size = 0;
+  bool m_sparse = false;
+
+  std::size_t mask() const { return m_table.size() - 1; }
+
+  /* Fibonacci hashing, consecutive ids are spread over the table */
+  std::size_t bucket(int id) const {
+    auto const h = static_cast<std::uint64_t>(id) * 0x9E3779B97F4A7C15ull;
+    return static_cast<std::size_t>(h >> 32) & mask();
+  }
+
+  /** Position of @p id in the table, or of the free entry
+   *  terminating its probe sequence. */
+  std::size_t find(int id) const {
+    auto i = bucket(id);
+    while (m_table[i].id != id and m_table[i].id != -1) {
+      i = (i + 1) & mask();
+    }
+    return i;
+  }
+
+  void rehash(std::size_t capacity) {
+    auto old = std::move(m_table);
+    m_table.assign(capacity, Entry{-1, nullptr});
+    for (auto const &e : old) {
+      if (e.id != -1) {
+        m_table[find(e.id)] = e;
+      }
+    }
+  }
+
+  void erase_sparse(std::size_t i) {
+    /* Backward shift: move every following entry of the cluster
+     * whose home bucket is not between the hole and itself into
+     * the hole. */
+    auto j = i;
+    while (true) {
+      j = (j + 1) & mask();
+      if (m_table[j].id == -1)
+        break;
+      auto const home = bucket(m_table[j].id);
+      auto const movable = (i <= j) ? (home <= i or home > j)
+                                    : (home <= i and home > j);
+      if (movable) {
+        m_table[i] = m_table[j];
+        i = j;
+      }
+    }
+    m_table[i] = Entry{-1, nullptr};
+    m_size--;
+  }
+
+  void set_sparse_entry(int id, Particle *p) {
+    if (m_table.empty()) {
+      if (not p)
+        return;
+      rehash(16);
+    }
+
+    auto const i = find(id);
+    if (m_table[i].id == id) {
+      if (p) {
+        m_table[i].p = p;
+      } else {
+        erase_sparse(i);
+      }
+    } else if (p) {
+      /* Keep the load factor below one half */
+      if (2 * (m_size + 1) > m_table.size()) {
+        rehash(2 * m_table.size());
+        m_table[find(id)] = Entry{id, p};
+      } else {
+        m_table[i] = Entry{id, p};
+      }
+      m_size++;
+    }
+  }
+
+public:
+  /** @brief Whether the sparse layout is used. */
+  bool sparse() const { return m_sparse; }
+
+  /**
+   * @brief Select the layout.
+   *
+   * This clears the index and releases the memory of the
+   * other layout, the index has to be rebuilt by the caller.
+   */
+  void set_sparse(bool sparse) {
+    m_sparse = sparse;
+    m_dense = {};
+    m_table = {};
+    m_size = 0;
+  }
+
+  /**
+   * @brief Get a particle by id.
+   *
+   * @return Pointer to the particle, nullptr if the id is not indexed.
+   */
+  Particle *get(int id) const {
+    assert(id >= 0);
+
+    if (not m_sparse) {
+      return (static_cast<std::size_t>(id) < m_dense.size()) ? m_dense[id]
+                                                             : nullptr;
+    }
+
+    if (m_table.empty())
+      return nullptr;
+
+    return m_table[find(id)].p;
+  }
+
+  /**
+   * @brief Set the entry of a particle.
+   *
+   * @param id Id of the particle.
+   * @param p Pointer to the particle, nullptr removes the entry.
+   */
+  void set(int id, Particle *p) {
+    assert(id >= 0);
+
+    if (m_sparse) {
+      set_sparse_entry(id, p);
+      return;
+    }
+
+    if (static_cast<std::size_t>(id) >= m_dense.size()) {
+      if (not p)
+        return;
+      m_dense.resize(id + 1);
+    }
+    m_dense[id] = p;
+  }
+
+  /**
+   * @brief Prepare the index for @p n particles.
+   *
+   * In the sparse layout this avoids rehashing while the
+   * index is rebuilt, in the dense layout it has no effect.
+   */
+  void reserve(std::size_t n) {
+    if (not m_sparse)
+      return;
+
+    std::size_t capacity = 16;
+    while (capacity < 2 * n)
+      capacity *= 2;
+    if (capacity > m_table.size())
+      rehash(capacity);
+  }
+
+  /** @brief Remove all entries, keeping the memory. */
+  void clear() {
+    m_dense.clear();
+    std::fill(m_table.begin(), m_table.end(), Entry{-1, nullptr});
+    m_size = 0;
+  }
+
+  /** @brief Largest indexed id, -1 if the index is empty. */
+  int max_id() const {
+    if (not m_sparse) {
+      auto const it =
+          std::find_if(m_dense.rbegin(), m_dense.rend(),
+                       [](Particle const *p) { return p != nullptr; });
+      return static_cast<int>(std::distance(it, m_dense.rend())) - 1;
+    }
+
+    int max_id = -1;
+    for (auto const &e : m_table) {
+      max_id = std::max(max_id, e.id);
+    }
+    return max_id;
+  }
+
+  /** @brief Allocated memory in bytes. */
+  std::size_t memory() const {
+    return m_dense.capacity() * sizeof(Particle *) +
+           m_table.capacity() * sizeof(Entry);
+  }
+};
+
+#endif
@@ -0,0 +1,152 @@
+/*
+ * Copyright (C) 2020 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef ESPRESSO_CORE_PARTICLE_SOA_HPP
+#define ESPRESSO_CORE_PARTICLE_SOA_HPP
+
+#include "Particle.hpp"
+
+#include <utils/Vector.hpp>
+
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Structure-of-arrays mirror of the particle data needed
+ *        by central pair potentials.
+ *
+ * Holds packed copies of the positions, types and charges of
+ * the particles of one cell, together with force accumulators.
+ * The mirror is filled by @ref ParticleSoA::pack, the pair kernels
+ * then only touch the dense arrays, and the accumulated forces are
+ * added to the particles by @ref ParticleSoA::scatter_forces.
+ * Pointers to the original particles are kept, so the mirror is
+ * only valid as long as the particle storage of the cell is not
+ * modified.
+ */
+class ParticleSoA {
+  std::vector<double> m_pos[3];
+  std::vector<double> m_force[3];
+  std::vector<int> m_type;
+  std::vector<double> m_q;
+  std::vector<Particle *> m_particles;
+  Utils::Vector3d m_virial = {};
+
+public:
+  std::size_t size() const { return m_particles.size(); }
+  bool empty() const { return m_particles.empty(); }
+
+  /**
+   * @brief Copy the data of a particle range into the mirror.
+   *
+   * The force and virial accumulators are set to zero.
+   *
+   * @param particles Range of particles to pack.
+   */
+  template <class ParticleRange> void pack(ParticleRange &&particles) {
+    clear();
+
+    for (auto &p : particles) {
+      for (int i = 0; i < 3; i++) {
+        m_pos[i].push_back(p.r.p[i]);
+        m_force[i].push_back(0.);
+      }
+      m_type.push_back(p.p.type);
+      m_q.push_back(p.p.q);
+      m_particles.push_back(&p);
+    }
+  }
+
+  /**
+   * @brief Update only the positions of an already packed mirror.
+   *
+   * Can be used if the particle storage was not changed since
+   * the last call to @ref ParticleSoA::pack. The force and virial
+   * accumulators are set to zero.
+   */
+  void update_positions() {
+    m_virial = {};
+    for (std::size_t j = 0; j < size(); j++) {
+      auto const &pos = m_particles[j]->r.p;
+      for (int i = 0; i < 3; i++) {
+        m_pos[i][j] = pos[i];
+        m_force[i][j] = 0.;
+      }
+    }
+  }
+
+  /**
+   * @brief Add the accumulated forces to the particles.
+   */
+  void scatter_forces() const {
+    for (std::size_t j = 0; j < size(); j++) {
+      auto &f = m_particles[j]->f.f;
+      for (int i = 0; i < 3; i++) {
+        f[i] += m_force[i][j];
+      }
+    }
+  }
+
+  void clear() {
+    for (int i = 0; i < 3; i++) {
+      m_pos[i].clear();
+      m_force[i].clear();
+    }
+    m_type.clear();
+    m_q.clear();
+    m_particles.clear();
+    m_virial = {};
+  }
+
+  Utils::Vector3d pos(std::size_t j) const {
+    assert(j < size());
+    return {m_pos[0][j], m_pos[1][j], m_pos[2][j]};
+  }
+  int type(std::size_t j) const { return m_type[j]; }
+  double q(std::size_t j) const { return m_q[j]; }
+  Particle &particle(std::size_t j) const { return *m_particles[j]; }
+
+  /** Add @p f to the force accumulator of entry @p j. */
+  void add_force(std::size_t j, Utils::Vector3d const &f) {
+    assert(j < size());
+    m_force[0][j] += f[0];
+    m_force[1][j] += f[1];
+    m_force[2][j] += f[2];
+  }
+
+  Utils::Vector3d force(std::size_t j) const {
+    return {m_force[0][j], m_force[1][j], m_force[2][j]};
+  }
+
+  /** Add @p v to the virial accumulator of the mirror. */
+  void add_virial(Utils::Vector3d const &v) { m_virial += v; }
+  /** Virial of the pairs evaluated with the first particle in
+   *  this mirror, i.e. the component-wise product of force and
+   *  distance vector. */
+  Utils::Vector3d const &virial() const { return m_virial; }
+
+  /** @brief Raw access to the position component @p i. */
+  double const *pos_data(int i) const { return m_pos[i].data(); }
+  /** @brief Raw access to the force component @p i. */
+  double *force_data(int i) { return m_force[i].data(); }
+  int const *type_data() const { return m_type.data(); }
+  double const *q_data() const { return m_q.data(); }
+};
+
+#endif
@@ -0,0 +1,149 @@
+/*
+ * Copyright (C) 2020 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef ESPRESSO_CORE_VERLET_LIST_HPP
+#define ESPRESSO_CORE_VERLET_LIST_HPP
+
+#include "Particle.hpp"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+/**
+ * @brief Verlet list of a cell in compressed sparse row format.
+ *
+ * The interaction partners of the particles of a cell are taken
+ * from the cell itself and its red neighbors, called the sources.
+ * The particles of all sources are numbered consecutively, and
+ * for every particle of the cell the partners are stored as 32-bit
+ * indices into this numbering, in ascending order. This needs
+ * 4 bytes per pair plus 4 bytes per particle, and the partners
+ * are visited in the order they are stored in memory.
+ *
+ * The list holds pointers to the particle storage of the sources,
+ * so it is only valid as long as the particles are not resorted.
+ * @ref VerletList::clear keeps the allocated memory, so that the
+ * list can be rebuilt without new allocations.
+ */
+class VerletList {
+public:
+  using index_type = std::uint32_t;
+
+private:
+  /** First particle of every source */
+  std::vector<Particle *> m_sources;
+  /** Index of the first particle of every source, and the
+   *  total number of particles in the sources. */
+  std::vector<index_type> m_source_offsets;
+  /** Index of the first partner of every particle of the cell */
+  std::vector<index_type> m_row_offsets;
+  /** Partner indices */
+  std::vector<index_type> m_partners;
+
+public:
+  /** @brief Number of pairs in the list. */
+  std::size_t size() const { return m_partners.size(); }
+  /** @brief Number of particles with a (possibly empty) partner list. */
+  std::size_t n_rows() const { return m_row_offsets.size(); }
+
+  /** @brief Memory allocated by the list in bytes. */
+  std::size_t memory() const {
+    return m_sources.capacity() * sizeof(Particle *) +
+           (m_source_offsets.capacity() + m_row_offsets.capacity() +
+            m_partners.capacity()) *
+               sizeof(index_type);
+  }
+
+  /** @brief Remove all pairs and sources, keeping the memory. */
+  void clear() {
+    m_sources.clear();
+    m_source_offsets.assign(1, 0);
+    m_row_offsets.clear();
+    m_partners.clear();
+  }
+
+  /**
+   * @brief Add the particles of a source.
+   *
+   * The cell itself has to be added first, followed
+   * by its neighbors.
+   *
+   * @param particles Particles of the source, have to be stored
+   *                  contiguously.
+   * @return Index of the first particle of the source.
+   */
+  template <class ParticleRange>
+  index_type add_source(ParticleRange &particles) {
+    if (m_source_offsets.empty())
+      m_source_offsets.push_back(0);
+
+    auto const first = m_source_offsets.back();
+    assert(first + particles.size() <=
+           std::numeric_limits<index_type>::max());
+
+    m_sources.push_back(particles.begin());
+    m_source_offsets.push_back(
+        static_cast<index_type>(first + particles.size()));
+
+    return first;
+  }
+
+  /** @brief Start the partner list of the next particle of the cell. */
+  void begin_row() {
+    m_row_offsets.push_back(static_cast<index_type>(m_partners.size()));
+  }
+
+  /**
+   * @brief Add a partner to the current row.
+   *
+   * @param partner Index of the partner, has to be larger
+   *                than the previous one in this row.
+   */
+  void add_partner(index_type partner) {
+    assert(not m_row_offsets.empty());
+    assert(partner < m_source_offsets.back());
+    m_partners.push_back(partner);
+  }
+
+  /**
+   * @brief Call kernel(p1, p2) for all pairs in the list.
+   */
+  template <class Kernel> void for_each_pair(Kernel &&kernel) const {
+    auto const n = n_rows();
+
+    for (std::size_t row = 0; row < n; row++) {
+      auto &p1 = m_sources[0][row];
+      auto const end = (row + 1 < n) ? m_row_offsets[row + 1] : size();
+
+      /* The partners are sorted, so the source can only advance */
+      std::size_t source = 0;
+      for (std::size_t k = m_row_offsets[row]; k < end; k++) {
+        auto const partner = m_partners[k];
+        while (partner >= m_source_offsets[source + 1])
+          source++;
+
+        kernel(p1, m_sources[source][partner - m_source_offsets[source]]);
+      }
+    }
+  }
+};
+
+#endif
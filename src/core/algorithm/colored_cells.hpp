@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2020 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef ALGORITHM_COLORED_CELLS_HPP
+#define ALGORITHM_COLORED_CELLS_HPP
+
+#include "config.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace Algorithm {
+
+/**
+ * @brief Partition cells into groups that can be processed
+ *        concurrently by a half-shell pair loop.
+ *
+ * A pair loop over a cell writes to the cell itself and to
+ * its red neighbors. The cells are colored greedily in the order
+ * of the range, such that the write sets of all cells of one color
+ * are disjoint.
+ *
+ * @return The cells, grouped by color.
+ */
+template <typename CellIterator>
+auto color_cells(CellIterator first, CellIterator last) {
+  using CellType = std::remove_reference_t<decltype(*first)>;
+
+  std::vector<std::vector<CellType *>> colors;
+  /* Colors that already write to a cell */
+  std::unordered_map<CellType const *, std::vector<std::size_t>> writers;
+
+  for (; first != last; ++first) {
+    auto &cell = *first;
+
+    std::vector<CellType const *> write_set = {&cell};
+    for (auto const &neighbor : cell.neighbors().red()) {
+      write_set.push_back(&(*neighbor));
+    }
+
+    std::vector<bool> taken(colors.size(), false);
+    for (auto c : write_set) {
+      for (auto color : writers[c]) {
+        taken[color] = true;
+      }
+    }
+
+    auto const free_color = std::find(taken.begin(), taken.end(), false);
+    auto const color =
+        static_cast<std::size_t>(std::distance(taken.begin(), free_color));
+    if (color == colors.size()) {
+      colors.emplace_back();
+    }
+
+    colors[color].push_back(&cell);
+    for (auto c : write_set) {
+      writers[c].push_back(color);
+    }
+  }
+
+  return colors;
+}
+
+/**
+ * @brief Run a kernel on all cells, color by color.
+ *
+ * The cells of one color are distributed over @p n_threads
+ * threads, if OpenMP is available. The colors are processed
+ * one after another, so the order of the updates of any cell
+ * does not depend on the number of threads.
+ *
+ * @param colors Cells grouped by color, as returned by @ref color_cells.
+ * @param n_threads Number of threads to use.
+ * @param cell_kernel Called with every cell.
+ * @param after_color Called by the calling thread after every color.
+ */
+template <typename Colors, typename CellKernel, typename ColorCallback>
+void for_each_colored_cell(Colors const &colors, int n_threads,
+                           CellKernel &&cell_kernel,
+                           ColorCallback &&after_color) {
+  for (auto const &color : colors) {
+    auto const n_cells = static_cast<long>(color.size());
+#ifdef OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(n_threads)
+#endif
+    for (long i = 0; i < n_cells; i++) {
+      cell_kernel(*color[i]);
+    }
+    after_color();
+  }
+}
+
+template <typename Colors, typename CellKernel>
+void for_each_colored_cell(Colors const &colors, int n_threads,
+                           CellKernel &&cell_kernel) {
+  for_each_colored_cell(colors, n_threads,
+                        std::forward<CellKernel>(cell_kernel), []() {});
+}
+} // namespace Algorithm
+
+#endif
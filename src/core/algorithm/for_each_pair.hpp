@@ -40,7 +40,7 @@ namespace Algorithm {
  * The Cell type has to provide a function %neighbors() that returns
  * a cell range comprised of the topological neighbors of the cell,
  * excluding the cell itself. The cells have to provide a %m_verlet_list
- * container that can be used to store particle pairs. It can be empty and is
+ * member with the interface of @ref VerletList. It can be empty and is
  * not touched if @p use_verlet_list is false.
  *
  * verlet_criterion(p1, p2, distance_function(p1, p2)) has to be valid and
@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2020 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef ALGORITHM_LINK_CELL_SOA_HPP
+#define ALGORITHM_LINK_CELL_SOA_HPP
+
+#include <cstddef>
+
+namespace Algorithm {
+
+/**
+ * @brief Iterates over all pairs within a cell and with
+ *        its neighbors, using the structure-of-arrays
+ *        mirror of the cells.
+ *
+ * The Cell type has to provide a member %m_soa with the
+ * interface of @ref ParticleSoA, which has to be packed
+ * for the cell and its neighbors.
+ *
+ * PairKernel has to provide an %operator() member that can be called
+ * as pair_kernel(soa1, i, soa2, j, distance_function(soa1.pos(i),
+ * soa2.pos(j))).
+ */
+template <typename Cell, typename PairKernel, typename DistanceFunction>
+void link_cell_soa(Cell &cell, PairKernel &&pair_kernel,
+                   DistanceFunction &&distance_function) {
+  auto &soa1 = cell.m_soa;
+
+  for (std::size_t i = 0; i < soa1.size(); i++) {
+    auto const pos1 = soa1.pos(i);
+
+    /* Pairs in this cell */
+    for (std::size_t j = i + 1; j < soa1.size(); j++) {
+      auto const dist = distance_function(pos1, soa1.pos(j));
+      pair_kernel(soa1, i, soa1, j, dist);
+    }
+
+    /* Pairs with neighbors */
+    for (auto &neighbor : cell.neighbors().red()) {
+      auto &soa2 = neighbor->m_soa;
+      for (std::size_t j = 0; j < soa2.size(); j++) {
+        auto const dist = distance_function(pos1, soa2.pos(j));
+        pair_kernel(soa1, i, soa2, j, dist);
+      }
+    }
+  }
+}
+
+/**
+ * @brief Iterates over all pairs within the cells and with
+ *        their neighbors, using the structure-of-arrays
+ *        mirror of the cells.
+ *
+ * See the single cell version of link_cell_soa for the
+ * requirements on the arguments.
+ */
+template <typename CellIterator, typename PairKernel,
+          typename DistanceFunction>
+void link_cell_soa(CellIterator first, CellIterator last,
+                   PairKernel &&pair_kernel,
+                   DistanceFunction &&distance_function) {
+  for (; first != last; ++first) {
+    link_cell_soa(*first, pair_kernel, distance_function);
+  }
+}
+
+/**
+ * @brief Iterates over all particles in the structure-of-arrays
+ *        mirror of a cell, handing blocks of pair candidates
+ *        to the kernel.
+ *
+ * Same pairs as @ref link_cell_soa, but for every particle
+ * the kernel is called once for the rest of its own cell and
+ * once for each neighbor cell, as
+ * block_kernel(soa1, i, soa2, first, last), where [first, last)
+ * is the range of candidates in soa2.
+ */
+template <typename Cell, typename BlockKernel>
+void link_cell_soa_batched(Cell &cell, BlockKernel &&block_kernel) {
+  auto &soa1 = cell.m_soa;
+
+  for (std::size_t i = 0; i < soa1.size(); i++) {
+    /* Pairs in this cell */
+    if (i + 1 < soa1.size()) {
+      block_kernel(soa1, i, soa1, i + 1, soa1.size());
+    }
+
+    /* Pairs with neighbors */
+    for (auto &neighbor : cell.neighbors().red()) {
+      auto &soa2 = neighbor->m_soa;
+      if (not soa2.empty()) {
+        block_kernel(soa1, i, soa2, 0, soa2.size());
+      }
+    }
+  }
+}
+
+/**
+ * @brief Batched pair loop over a range of cells,
+ *        see the single cell version of link_cell_soa_batched.
+ */
+template <typename CellIterator, typename BlockKernel>
+void link_cell_soa_batched(CellIterator first, CellIterator last,
+                           BlockKernel &&block_kernel) {
+  for (; first != last; ++first) {
+    link_cell_soa_batched(*first, block_kernel);
+  }
+}
+} // namespace Algorithm
+
+#endif
@@ -19,6 +19,8 @@
 #ifndef CORE_ALGORITHM_VERLET_IA_HPP
 #define CORE_ALGORITHM_VERLET_IA_HPP
 
+#include <cstdint>
+#include <iterator>
 #include <utility>
 
 namespace Algorithm {
@@ -33,31 +35,44 @@ void update_and_kernel(CellIterator first, CellIterator last,
                        VerletCriterion &&verlet_criterion) {
   for (; first != last; ++first) {
     /* Clear the VL */
-    first->m_verlet_list.clear();
+    auto &verlet_list = first->m_verlet_list;
+    verlet_list.clear();
+
+    /* Number the candidates: the cell itself first, then the neighbors */
+    verlet_list.add_source(first->particles());
+    for (auto &neighbor : first->neighbors().red()) {
+      verlet_list.add_source(neighbor->particles());
+    }
 
     for (auto it = first->particles().begin(); it != first->particles().end();
          ++it) {
       auto &p1 = *it;
 
       particle_kernel(p1);
+      verlet_list.begin_row();
 
       /* Pairs in this cell */
+      auto candidate = static_cast<std::uint32_t>(
+          std::distance(first->particles().begin(), it));
       for (auto jt = std::next(it); jt != first->particles().end(); ++jt) {
+        ++candidate;
         auto const dist = distance_function(p1, *jt);
         if (verlet_criterion(p1, *jt, dist)) {
           pair_kernel(p1, *jt, dist);
-          first->m_verlet_list.emplace_back(&p1, &(*jt));
+          verlet_list.add_partner(candidate);
         }
       }
 
       /* Pairs with neighbors */
+      candidate = static_cast<std::uint32_t>(first->particles().size());
       for (auto &neighbor : first->neighbors().red()) {
         for (auto &p2 : neighbor->particles()) {
           auto dist = distance_function(p1, p2);
           if (verlet_criterion(p1, p2, dist)) {
             pair_kernel(p1, p2, dist);
-            first->m_verlet_list.emplace_back(&p1, &p2);
+            verlet_list.add_partner(candidate);
           }
+          ++candidate;
         }
       }
     }
@@ -74,10 +89,10 @@ void kernel(CellIterator first, CellIterator last,
       particle_kernel(p);
     }
 
-    for (auto &pair : first->m_verlet_list) {
-      auto const dist = distance_function(*pair.first, *pair.second);
-      pair_kernel(*pair.first, *pair.second, dist);
-    }
+    first->m_verlet_list.for_each_pair([&](auto &p1, auto &p2) {
+      auto const dist = distance_function(p1, p2);
+      pair_kernel(p1, p2, dist);
+    });
   }
 }
 } // namespace detail
@@ -41,10 +41,15 @@
 #include <utils/NoOp.hpp>
 #include <utils/mpi/gather_buffer.hpp>
 
+#include <boost/mpi/operations.hpp>
 #include <boost/range/adaptor/uniqued.hpp>
+#include <boost/range/algorithm/min_element.hpp>
 #include <boost/range/algorithm/sort.hpp>
 
+#include <algorithm>
+#include <cmath>
 #include <cstdio>
+#include <limits>
 
 /** Type of cell structure in use */
 CellStructure cell_structure;
@@ -110,6 +115,76 @@ std::vector<std::pair<int, int>> mpi_get_pairs(double distance) {
   return pairs;
 }
 
+static double nearest_neighbor_distance_local(int pid) {
+  on_observable_calc();
+
+  auto min_dist2 = std::numeric_limits<double>::infinity();
+  auto const p = cell_structure.get_local_particle(pid);
+  if (p and not p->l.ghost) {
+    particle_neighbor_loop(*p, [&min_dist2](Particle const &, Particle const &,
+                                            Distance const &d) {
+      min_dist2 = std::min(min_dist2, d.dist2);
+    });
+  }
+
+  return std::sqrt(min_dist2);
+}
+
+REGISTER_CALLBACK_REDUCTION(nearest_neighbor_distance_local,
+                            boost::mpi::minimum<double>())
+
+double mpi_get_nearest_neighbor_distance(int pid) {
+  return mpi_call(Communication::Result::reduction,
+                  boost::mpi::minimum<double>(),
+                  nearest_neighbor_distance_local, pid);
+}
+
+double cells_neighbor_search_range() {
+  if (cell_structure.decomposition_type() == CELL_STRUCTURE_DOMDEC) {
+    /* Particles may have moved by half the skin since the last resort. */
+    auto const &cell_size = get_domain_decomposition()->cell_size;
+    return std::max(0., *boost::min_element(cell_size) - skin);
+  }
+
+  return std::numeric_limits<double>::infinity();
+}
+
+/**
+ * @brief Number of pairs, particles and allocated bytes
+ *        of the local Verlet lists.
+ */
+static Utils::Vector3d verlet_list_stats_local() {
+  Utils::Vector3d stats{};
+  for (auto const cell : cell_structure.local_cells()) {
+    stats[0] += static_cast<double>(cell->m_verlet_list.size());
+    stats[1] += static_cast<double>(cell->particles().size());
+    stats[2] += static_cast<double>(cell->m_verlet_list.memory());
+  }
+
+  return stats;
+}
+
+REGISTER_CALLBACK_REDUCTION(verlet_list_stats_local, std::plus<>())
+
+VerletListStats mpi_get_verlet_list_stats() {
+  auto const stats = mpi_call(Communication::Result::reduction, std::plus<>(),
+                              verlet_list_stats_local);
+
+  return {cell_structure.verlet_list_rebuilds,
+          (stats[1] > 0.) ? stats[0] / stats[1] : 0., stats[2]};
+}
+
+static double particle_index_memory_local() {
+  return static_cast<double>(cell_structure.particle_index_memory());
+}
+
+REGISTER_CALLBACK_REDUCTION(particle_index_memory_local, std::plus<>())
+
+double mpi_get_particle_index_memory() {
+  return mpi_call(Communication::Result::reduction, std::plus<>(),
+                  particle_index_memory_local);
+}
+
 /************************************************************
  *            Exported Functions                            *
  ************************************************************/
@@ -165,7 +240,7 @@ void check_resort_particles() {
 }
 
 /*************************************************/
-void cells_update_ghosts(unsigned data_parts) {
+void cells_update_ghosts_begin(unsigned data_parts) {
   /* data parts that are only updated on resort */
   auto constexpr resort_only_parts =
       Cells::DATA_PART_PROPERTIES | Cells::DATA_PART_BONDS;
@@ -196,10 +271,15 @@ void cells_update_ghosts(unsigned data_parts) {
     cell_structure.clear_resort_particles();
   } else {
     /* Communication step: ghost information */
-    cell_structure.ghosts_update(data_parts & ~resort_only_parts);
+    cell_structure.ghosts_update_begin(data_parts & ~resort_only_parts);
   }
 }
 
+void cells_update_ghosts(unsigned data_parts) {
+  cells_update_ghosts_begin(data_parts);
+  cell_structure.ghosts_wait();
+}
+
 Cell *find_current_cell(const Particle &p) {
   assert(not cell_structure.get_resort_particles());
 
@@ -217,4 +297,20 @@ const DomainDecomposition *get_domain_decomposition() {
 
 void cells_set_use_verlet_lists(bool use_verlet_lists) {
   cell_structure.use_verlet_list = use_verlet_lists;
-}
\ No newline at end of file
+}
+
+void cells_set_use_soa_mirror(bool use_soa_mirror) {
+  cell_structure.use_soa_mirror = use_soa_mirror;
+}
+
+void cells_set_n_threads(int n_threads) {
+  cell_structure.n_threads = n_threads;
+}
+
+void cells_set_overlap_ghost_communication(bool overlap) {
+  cell_structure.overlap_ghost_communication = overlap;
+}
+
+void cells_set_use_sparse_particle_index(bool sparse) {
+  cell_structure.set_use_sparse_particle_index(sparse);
+}
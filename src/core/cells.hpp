@@ -91,6 +91,38 @@ void cells_re_init(int new_cs);
  */
 void cells_set_use_verlet_lists(bool use_verlet_lists);
 
+/**
+ * @brief Set use_soa_mirror
+ *
+ * @param use_soa_mirror Should the structure-of-arrays mirror
+ *                       be used in the pair loop?
+ */
+void cells_set_use_soa_mirror(bool use_soa_mirror);
+
+/**
+ * @brief Set n_threads
+ *
+ * @param n_threads Number of threads for the pair loop on the
+ *                  structure-of-arrays mirror.
+ */
+void cells_set_n_threads(int n_threads);
+
+/**
+ * @brief Set overlap_ghost_communication
+ *
+ * @param overlap Should the ghost update be overlapped
+ *                with the pair loop?
+ */
+void cells_set_overlap_ghost_communication(bool overlap);
+
+/**
+ * @brief Set the layout of the local particle index
+ *
+ * @param sparse Should the index be a hash table instead of
+ *               a vector indexed by the particle id?
+ */
+void cells_set_use_sparse_particle_index(bool sparse);
+
 /** Sort the particles into the cells and initialize the ghost particle
  *  structures.
  */
@@ -101,6 +133,11 @@ void cells_resort_particles(int global_flag);
  */
 void cells_update_ghosts(unsigned data_parts);
 
+/** Like @ref cells_update_ghosts, but the ghost update may still be
+ *  in flight on return, see @ref CellStructure::ghosts_update_begin.
+ */
+void cells_update_ghosts_begin(unsigned data_parts);
+
 /**
  * @brief Get pairs closer than @p distance from the cells.
  *
@@ -108,6 +145,42 @@ void cells_update_ghosts(unsigned data_parts);
  */
 std::vector<std::pair<int, int>> mpi_get_pairs(double distance);
 
+/**
+ * @brief Distance of a particle to its nearest neighbor.
+ *
+ * Only the cell of the particle and the neighbor cells are searched,
+ * so the result is exact if it is smaller than
+ * @ref cells_neighbor_search_range, and infinite if there is no other
+ * particle in these cells.
+ */
+double mpi_get_nearest_neighbor_distance(int pid);
+
+/**
+ * @brief Range within which @ref mpi_get_nearest_neighbor_distance
+ *        finds all neighbors of a particle.
+ */
+double cells_neighbor_search_range();
+
+/** @brief Statistics of the Verlet lists. */
+struct VerletListStats {
+  /** Number of rebuilds since the start of the simulation */
+  int n_rebuilds;
+  /** Average number of pairs per particle in the current lists */
+  double pairs_per_particle;
+  /** Memory used by the lists on all nodes in bytes */
+  double memory;
+};
+
+/**
+ * @brief Collect the Verlet list statistics from all nodes.
+ */
+VerletListStats mpi_get_verlet_list_stats();
+
+/**
+ * @brief Memory used by the local particle indices of all nodes in bytes.
+ */
+double mpi_get_particle_index_memory();
+
 /** Check if a particle resorting is required. */
 void check_resort_particles();
 
@@ -18,168 +18,232 @@
  */
 #include "ClusterStructure.hpp"
 #include "Cluster.hpp"
+#include "cells.hpp"
+#include "communication.hpp"
+#include "errorhandling.hpp"
+#include "event.hpp"
 #include "nonbonded_interactions/nonbonded_interaction_data.hpp"
 #include "partCfg_global.hpp"
+#include "short_range_loop.hpp"
+
+#include <utils/for_each_pair.hpp>
+#include <utils/mpi/gather_buffer.hpp>
+
+#include <boost/iterator/indirect_iterator.hpp>
+#include <boost/mpi/collectives/all_reduce.hpp>
+#include <boost/mpi/operations.hpp>
+
 #include <algorithm>
 #include <stdexcept>
-#include <utils/for_each_pair.hpp>
+#include <unordered_map>
 
 namespace ClusterAnalysis {
+namespace {
+/**
+ * @brief Disjoint-set forest over particle ids.
+ *
+ * The representative of each set is its smallest particle id, so that
+ * it does not depend on the order in which the pairs are visited.
+ */
+class ParticleForest {
+public:
+  void unite(int id1, int id2) {
+    auto const root1 = find(id1);
+    auto const root2 = find(id2);
+    if (root1 < root2) {
+      m_parent[root2] = root1;
+    } else if (root2 < root1) {
+      m_parent[root1] = root2;
+    }
+  }
+
+  /** @brief Flat list of (particle id, representative id) pairs. */
+  std::vector<int> labels() {
+    std::vector<int> res;
+    res.reserve(2 * m_parent.size());
+    for (auto const &kv : m_parent) {
+      res.push_back(kv.first);
+      res.push_back(find(kv.first));
+    }
+    return res;
+  }
+
+private:
+  /** Parent of each particle id in the forest, roots are their own parents */
+  std::unordered_map<int, int> m_parent;
+
+  int find(int id) {
+    auto root = m_parent.emplace(id, id).first->second;
+    while (m_parent.at(root) != root) {
+      root = m_parent.at(root);
+    }
+    /* Path compression */
+    while (id != root) {
+      auto &parent = m_parent.at(id);
+      id = parent;
+      parent = root;
+    }
+    return root;
+  }
+};
+
+/**
+ * @brief Merge the partial forests of all nodes on the head node.
+ *
+ * Two particles in the same local set are connected by a path of
+ * neighbors, so the global sets are the union of the (particle id,
+ * representative id) edges of all nodes.
+ *
+ * @param labels Local labels, as returned by @ref ParticleForest::labels.
+ * @return Labels of the merged forest on the head node, empty elsewhere.
+ */
+std::vector<int> merge_forests(std::vector<int> labels) {
+  Utils::Mpi::gather_buffer(labels, comm_cart);
+  if (this_node != 0) {
+    return {};
+  }
+
+  ParticleForest forest;
+  for (std::size_t i = 0; i + 1 < labels.size(); i += 2) {
+    forest.unite(labels[i], labels[i + 1]);
+  }
+  return forest.labels();
+}
+
+/** Update the ghosts including the properties and bonds, on which the pair
+ *  criteria may depend. */
+void update_ghosts() {
+  on_observable_calc();
+  cell_structure.ghosts_update(Cells::DATA_PART_PROPERTIES |
+                               Cells::DATA_PART_BONDS);
+}
+} // namespace
 
 ClusterStructure::ClusterStructure() { clear(); }
 
 void ClusterStructure::clear() {
   clusters.clear();
   cluster_id.clear();
-  m_cluster_identities.clear();
 }
 
 inline bool ClusterStructure::part_of_cluster(const Particle &p) {
   return cluster_id.find(p.p.identity) != cluster_id.end();
 }
 
+bool ClusterStructure::check_pair_criterion() const {
+  if (!m_pair_criterion) {
+    if (this_node == 0) {
+      runtimeErrorMsg() << "No cluster criterion defined";
+    }
+    return false;
+  }
+  return true;
+}
+
 // Analyze the cluster structure of the given particles
 void ClusterStructure::run_for_all_pairs() {
   // clear data structs
   clear();
+  if (!check_pair_criterion()) {
+    return;
+  }
 
-  // Iterate over pairs
-  Utils::for_each_pair(partCfg().begin(), partCfg().end(),
-                       [this](const Particle &p1, const Particle &p2) {
-                         this->add_pair(p1, p2);
-                       });
-  merge_clusters();
-}
+  auto const &criterion = *m_pair_criterion;
+  auto const cells_range =
+      boost::mpi::all_reduce(comm_cart, cells_neighbor_search_range(),
+                             boost::mpi::minimum<double>());
 
-void ClusterStructure::run_for_bonded_particles() {
-  clear();
-  for (const auto &p : partCfg()) {
-    for (auto const &bond : p.bonds()) {
-      if (bond.partner_ids().size() == 1) {
-        add_pair(p, get_particle_data(bond.partner_ids()[0]));
+  if (criterion.max_range() <= cells_range) {
+    /* All neighbors are found in the local and neighbor cells. */
+    update_ghosts();
+
+    ParticleForest forest;
+    auto const kernel = [&criterion, &forest](Particle const &p1,
+                                              Particle const &p2, int) {
+      if (criterion.decide(p1, p2)) {
+        forest.unite(p1.identity(), p2.identity());
       }
-    }
+    };
+
+    auto first =
+        boost::make_indirect_iterator(cell_structure.local_cells().begin());
+    auto last =
+        boost::make_indirect_iterator(cell_structure.local_cells().end());
+    Algorithm::link_cell(first, last, [](Particle const &) {}, kernel,
+                         [](Particle const &, Particle const &) { return 0; });
+
+    set_clusters(merge_forests(forest.labels()));
+  } else if (this_node == 0) {
+    /* The criterion reaches beyond the cells, fall back to all pairs. */
+    ParticleForest forest;
+    Utils::for_each_pair(partCfg().begin(), partCfg().end(),
+                         [&criterion, &forest](const Particle &p1,
+                                               const Particle &p2) {
+                           if (criterion.decide(p1, p2)) {
+                             forest.unite(p1.identity(), p2.identity());
+                           }
+                         });
+    set_clusters(forest.labels());
   }
-
-  merge_clusters();
 }
 
-void ClusterStructure::add_pair(const Particle &p1, const Particle &p2) {
-  // * check, if there's a neighbor
-  //   * No: Then go on to the next particle
-  // * Yes: Then if
-  //   * One of them belongs to a cluster, give the other one the same cluster
-  //     id.
-  //   * None of them belongs to a cluster: Give them both a new cluster id
-  //   * Both belong to different clusters: Mark the clusters as identical
-  //   * so that they can be put together later
-  if (!m_pair_criterion) {
-    runtimeErrorMsg() << "No cluster criterion defined";
+void ClusterStructure::run_for_bonded_particles() {
+  clear();
+  if (!check_pair_criterion()) {
     return;
   }
-  // If the two particles are neighbors...
-  if (m_pair_criterion->decide(p1, p2)) {
-
-    if // None belongs to a cluster
-        ((!part_of_cluster(p1)) && (!part_of_cluster(p2))) {
-      // Both particles belong to the same, new cluster
-      const int cid = get_next_free_cluster_id();
-
-      // assign the cluster_ids
-      cluster_id[p1.p.identity] = cid;
-      cluster_id[p2.p.identity] = cid;
-    } else if // p2 belongs to a cluster but p1 doesn't
-        (part_of_cluster(p2) && !part_of_cluster(p1)) {
-      // Give p1 the same cluster id as p2
-      cluster_id[p1.p.identity] = find_id_for(cluster_id.at(p2.p.identity));
-    } else if // i belongs to a cluster but j doesn't
-        (part_of_cluster(p1) && !part_of_cluster(p2)) {
-      // give p2 the cluster id from p1
-      cluster_id[p2.p.identity] = find_id_for(cluster_id.at(p1.p.identity));
-    } else if // Both belong to different clusters
-        (part_of_cluster(p1) && part_of_cluster(p2) &&
-         cluster_id.at(p1.p.identity) != cluster_id.at(p2.p.identity)) {
-      // Clusters of p1 and p2 are one and the same. Add an identity to the list
-      // The higher number must be inserted as first value of the pair
-      // because the substitutions later have to be done in descending order
-      const int cid1 = find_id_for(cluster_id.at(p1.p.identity));
-      const int cid2 = find_id_for(cluster_id.at(p2.p.identity));
-      if (cid1 > cid2) {
-        m_cluster_identities[cid1] = cid2;
-      } else if (cid1 < cid2) {
-        m_cluster_identities[cid2] = cid1;
-      }
-      // else do nothing. The clusters are already noted for merging.
-      // Connected clusters will be merged later
-    }
-    // The case for both particles being in the same cluster does not need to be
-    // treated.
-  }
-}
 
-void ClusterStructure::merge_clusters() {
-  // Relabel particles according to the cluster identities map
-  // Also create empty cluster objects for the final cluster id
-
-  // Collect needed changes in a separate map, as doing the changes on the fly
-  // would screw up the iterators
-  std::vector<std::pair<int, int>> to_be_changed;
-
-  for (auto it : cluster_id) {
-    // particle id is in it.first and cluster id in it.second
-    // We change the cluster id according to the cluster identities
-    // map
-    const int cid = find_id_for(it.second);
-    // We note the list of changes here, so we don't modify the map
-    // while iterating
-    to_be_changed.emplace_back(it.first, cid);
-    // Empty cluster object
-    if (clusters.find(cid) == clusters.end()) {
-      clusters[cid] = std::make_shared<Cluster>();
+  /* Bond partners are always within the range of the cells. */
+  update_ghosts();
+
+  auto const &criterion = *m_pair_criterion;
+  ParticleForest forest;
+  for (auto const &p : cell_structure.local_particles()) {
+    for (auto const &bond : p.bonds()) {
+      if (bond.partner_ids().size() == 1) {
+        auto const partner_id = bond.partner_ids()[0];
+        auto const partner = cell_structure.get_local_particle(partner_id);
+        if (!partner) {
+          runtimeErrorMsg() << "bond partner " << partner_id
+                            << " of particle " << p.identity()
+                            << " not found";
+          continue;
+        }
+        if (criterion.decide(p, *partner)) {
+          forest.unite(p.identity(), partner_id);
+        }
+      }
     }
   }
 
-  // Now act on the changes marke in above iteration
-  for (auto it : to_be_changed) {
-    cluster_id[it.first] = it.second;
-  }
+  set_clusters(merge_forests(forest.labels()));
+}
 
-  // Now fill the cluster objects with particle ids
-  // Iterate over particles, fill in the cluster map
-  // to each cluster particle the corresponding cluster id
-  for (auto it : cluster_id) {
-    // If this is the first particle in this cluster, instance a new cluster
-    // object
-    if (clusters.find(it.second) == clusters.end()) {
-      clusters[it.second] = std::make_shared<Cluster>();
-    }
-    clusters[it.second]->particles.push_back(it.first);
+void ClusterStructure::set_clusters(std::vector<int> const &labels) {
+  // Number the clusters in the order of their smallest particle id,
+  // which is the representative of the set
+  std::map<int, int> cid_for_root;
+  for (std::size_t i = 1; i < labels.size(); i += 2) {
+    cid_for_root.emplace(labels[i], 0);
   }
-
-  // Sort particles ids in the clusters
-  for (const auto &c : clusters) {
-    std::sort(c.second->particles.begin(), c.second->particles.end());
+  int cid = 0;
+  for (auto &it : cid_for_root) {
+    it.second = ++cid;
   }
-}
 
-int ClusterStructure::find_id_for(int x) {
-  int tmp = x;
-  while (m_cluster_identities.find(tmp) != m_cluster_identities.end()) {
-    tmp = m_cluster_identities[tmp];
+  for (std::size_t i = 0; i + 1 < labels.size(); i += 2) {
+    cluster_id[labels[i]] = cid_for_root.at(labels[i + 1]);
   }
-  return tmp;
-}
 
-int ClusterStructure::get_next_free_cluster_id() {
-  // iterate over cluster_id'
-  int max_seen_cluster = 0;
-  for (auto it : cluster_id) {
-    int cid = it.second;
-    if (max_seen_cluster < cid) {
-      max_seen_cluster = cid;
+  // Fill the cluster objects with particle ids. The map is ordered,
+  // so the particle ids in the clusters are sorted.
+  for (auto const &it : cluster_id) {
+    auto &cluster = clusters[it.second];
+    if (!cluster) {
+      cluster = std::make_shared<Cluster>();
     }
+    cluster->particles.push_back(it.first);
   }
-  return max_seen_cluster + 1;
 }
 
 } // namespace ClusterAnalysis
@@ -22,6 +22,8 @@
 
 #include "pair_criteria/pair_criteria.hpp"
 #include <map>
+#include <memory>
+#include <vector>
 
 #include "Cluster.hpp"
 #include "Particle.hpp"
@@ -40,10 +42,17 @@ public:
   std::map<int, int> cluster_id;
   /** @brief Clear data structures */
   void clear();
-  /** @brief Run cluster analysis, consider all particle pairs */
+  /** @brief Run cluster analysis, consider all particle pairs.
+   *  Has to be called on all nodes. If the range of the pair criterion
+   *  fits into the cell system, each node evaluates the criterion on the
+   *  pairs of its local cells, otherwise the head node loops over all pairs.
+   *  The results are only available on the head node.
+   */
   void run_for_all_pairs();
   /** @brief Run cluster analysis, consider pairs of particles connected by a
-   * bonded interaction */
+   * bonded interaction. Has to be called on all nodes, the results are only
+   * available on the head node.
+   */
   void run_for_bonded_particles();
   /** Is particle p part of a cluster */
   bool part_of_cluster(const Particle &p);
@@ -58,23 +67,15 @@ public:
   }
 
 private:
-  /** @brief Clusters that turn out to be the same during the analysis process
-   * (i.e., if two particles are neighbors that already belong to different
-   * clusters
-   */
-  std::map<int, int> m_cluster_identities;
-
   /** @brief pair criterion which decides whether two particles are neighbors */
   std::shared_ptr<PairCriteria::PairCriterion> m_pair_criterion;
 
-  /** @brief Consider an individual pair of particles during cluster analysis */
-  void add_pair(const Particle &p1, const Particle &p2);
-  /** Merge clusters and populate their structures */
-  void merge_clusters();
-  /** @brief Follow a chain of cluster identities during analysis */
-  inline int find_id_for(int x);
-  /** @brief Get next free cluster id */
-  inline int get_next_free_cluster_id();
+  /** @brief Check that a pair criterion is set, on all nodes */
+  bool check_pair_criterion() const;
+  /** @brief Populate the cluster structure from the final labels.
+   *  @param labels Flat list of (particle id, representative id) pairs.
+   */
+  void set_clusters(std::vector<int> const &labels);
 };
 
 } // namespace ClusterAnalysis
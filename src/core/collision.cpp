@@ -490,6 +490,9 @@ void three_particle_binding_domain_decomposition(
 
 // Handle the collisions stored in the queue
 void handle_collisions() {
+  /* The bonds added below are not accompanied by a resort
+   * in all modes, so the bond lists have to be rebuilt. */
+  cell_structure.invalidate_bond_lists();
 
   if (collision_params.exception_on_collision) {
     for (auto &c : local_collision_queue) {
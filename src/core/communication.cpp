@@ -314,6 +314,7 @@ int mpi_integrate(int n_steps, int reuse_forces) {
 /*************** BCAST IA ************/
 static void mpi_bcast_all_ia_params_slave() {
   boost::mpi::broadcast(comm_cart, ia_params, 0);
+  recalc_nonbonded_ia_params();
 }
 
 REGISTER_CALLBACK(mpi_bcast_all_ia_params_slave)
@@ -507,6 +508,30 @@ void mpi_set_use_verlet_lists(bool use_verlet_lists) {
   mpi_call_all(cells_set_use_verlet_lists, use_verlet_lists);
 }
 
+REGISTER_CALLBACK(cells_set_use_soa_mirror)
+
+void mpi_set_use_soa_mirror(bool use_soa_mirror) {
+  mpi_call_all(cells_set_use_soa_mirror, use_soa_mirror);
+}
+
+REGISTER_CALLBACK(cells_set_n_threads)
+
+void mpi_set_n_threads(int n_threads) {
+  mpi_call_all(cells_set_n_threads, n_threads);
+}
+
+REGISTER_CALLBACK(cells_set_overlap_ghost_communication)
+
+void mpi_set_overlap_ghost_communication(bool overlap) {
+  mpi_call_all(cells_set_overlap_ghost_communication, overlap);
+}
+
+REGISTER_CALLBACK(cells_set_use_sparse_particle_index)
+
+void mpi_set_use_sparse_particle_index(bool sparse) {
+  mpi_call_all(cells_set_use_sparse_particle_index, sparse);
+}
+
 /*************** BCAST NPTISO GEOM *****************/
 
 void mpi_bcast_nptiso_geom() {
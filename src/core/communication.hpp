@@ -244,6 +244,14 @@ void mpi_bcast_cell_structure(int cs);
 
 void mpi_set_use_verlet_lists(bool use_verlet_lists);
 
+void mpi_set_use_soa_mirror(bool use_soa_mirror);
+
+void mpi_set_n_threads(int n_threads);
+
+void mpi_set_overlap_ghost_communication(bool overlap);
+
+void mpi_set_use_sparse_particle_index(bool sparse);
+
 /** Broadcast nptiso geometry parameter to all nodes. */
 void mpi_bcast_nptiso_geom();
 
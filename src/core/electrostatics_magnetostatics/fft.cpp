@@ -37,6 +37,7 @@ using Utils::get_linear_index;
 #include <fftw3.h>
 #include <mpi.h>
 
+#include <algorithm>
 #include <cstdio>
 #include <cstring>
 
@@ -474,7 +475,7 @@ void calc_2d_grid(int n, int grid[3]) {
 int fft_init(const Utils::Vector3i &ca_mesh_dim, int const *ca_mesh_margin,
              int const *global_mesh_dim, double const *global_mesh_off,
              int &ks_pnum, fft_data_struct &fft, const Utils::Vector3i &grid,
-             const boost::mpi::communicator &comm) {
+             const boost::mpi::communicator &comm, bool real_to_complex) {
   int i, j;
   /* helpers */
   int mult[3];
@@ -522,12 +523,29 @@ int fft_init(const Utils::Vector3i &ca_mesh_dim, int const *ca_mesh_margin,
   fft.plan[2].row_dir = (fft.plan[1].row_dir - 1) % 3;
   fft.plan[3].row_dir = (fft.plan[1].row_dir - 2) % 3;
 
+  /* the first FFT runs along the fast index of its permuted mesh */
+  int dirs[3] = {0, 1, 2};
+  permute_ifield(dirs, 3, -(fft.plan[1].n_permute));
+  fft.first_dir = dirs[2];
+  fft.real_to_complex = real_to_complex;
+
+  /* global mesh after the first FFT, only the half spectrum
+   * remains for a real to complex FFT */
+  int ks_mesh_dim[3] = {global_mesh_dim[0], global_mesh_dim[1],
+                        global_mesh_dim[2]};
+  if (real_to_complex) {
+    ks_mesh_dim[fft.first_dir] = global_mesh_dim[fft.first_dir] / 2 + 1;
+  }
+
   /* === communication groups === */
   /* copy local mesh off real space charge assignment grid */
   for (i = 0; i < 3; i++)
     fft.plan[0].new_mesh[i] = ca_mesh_dim[i];
 
   for (i = 1; i < 4; i++) {
+    /* the first plan redistributes the real data */
+    auto const mesh_dim = (i == 1) ? global_mesh_dim : ks_mesh_dim;
+
     using Utils::make_span;
     auto group = find_comm_groups(
         {n_grid[i - 1][0], n_grid[i - 1][1], n_grid[i - 1][2]},
@@ -556,7 +574,7 @@ int fft_init(const Utils::Vector3i &ca_mesh_dim, int const *ca_mesh_margin,
     fft.plan[i].recv_size.resize(fft.plan[i].group.size());
 
     fft.plan[i].new_size =
-        calc_local_mesh(my_pos[i], n_grid[i], global_mesh_dim, global_mesh_off,
+        calc_local_mesh(my_pos[i], n_grid[i], mesh_dim, global_mesh_off,
                         fft.plan[i].new_mesh, fft.plan[i].start);
     permute_ifield(fft.plan[i].new_mesh, 3, -(fft.plan[i].n_permute));
     permute_ifield(fft.plan[i].start, 3, -(fft.plan[i].n_permute));
@@ -568,7 +586,7 @@ int fft_init(const Utils::Vector3i &ca_mesh_dim, int const *ca_mesh_margin,
       int node = fft.plan[i].group[j];
       fft.plan[i].send_size[j] = calc_send_block(
           my_pos[i - 1], n_grid[i - 1], &(n_pos[i][3 * node]), n_grid[i],
-          global_mesh_dim, global_mesh_off, &(fft.plan[i].send_block[6 * j]));
+          mesh_dim, global_mesh_off, &(fft.plan[i].send_block[6 * j]));
       permute_ifield(&(fft.plan[i].send_block[6 * j]), 3,
                      -(fft.plan[i - 1].n_permute));
       permute_ifield(&(fft.plan[i].send_block[6 * j + 3]), 3,
@@ -585,7 +603,7 @@ int fft_init(const Utils::Vector3i &ca_mesh_dim, int const *ca_mesh_margin,
       /* recv block: comm.rank() from comm-group-node i (identity: node) */
       fft.plan[i].recv_size[j] = calc_send_block(
           my_pos[i], n_grid[i], &(n_pos[i - 1][3 * node]), n_grid[i - 1],
-          global_mesh_dim, global_mesh_off, &(fft.plan[i].recv_block[6 * j]));
+          mesh_dim, global_mesh_off, &(fft.plan[i].recv_block[6 * j]));
       permute_ifield(&(fft.plan[i].recv_block[6 * j]), 3,
                      -(fft.plan[i].n_permute));
       permute_ifield(&(fft.plan[i].recv_block[6 * j + 3]), 3,
@@ -596,6 +614,9 @@ int fft_init(const Utils::Vector3i &ca_mesh_dim, int const *ca_mesh_margin,
 
     for (j = 0; j < 3; j++)
       fft.plan[i].old_mesh[j] = fft.plan[i - 1].new_mesh[j];
+    /* the rows of the first plan are shortened by the real to complex FFT */
+    if (i == 2)
+      fft.plan[2].old_mesh[2] = ks_mesh_dim[fft.first_dir];
     if (i == 1)
       fft.plan[i].element = 1;
     else {
@@ -610,9 +631,16 @@ int fft_init(const Utils::Vector3i &ca_mesh_dim, int const *ca_mesh_margin,
   /* Factor 2 for complex fields */
   fft.max_comm_size *= 2;
   fft.max_mesh_size = (ca_mesh_dim[0] * ca_mesh_dim[1] * ca_mesh_dim[2]);
-  for (i = 1; i < 4; i++)
-    if (2 * fft.plan[i].new_size > fft.max_mesh_size)
-      fft.max_mesh_size = 2 * fft.plan[i].new_size;
+  for (i = 1; i < 4; i++) {
+    auto mesh_size = 2 * fft.plan[i].new_size;
+    if (i == 1 and real_to_complex) {
+      /* real input and half spectrum output of the first FFT */
+      mesh_size = std::max(fft.plan[1].new_size,
+                           2 * fft.plan[1].n_ffts * ks_mesh_dim[fft.first_dir]);
+    }
+    if (mesh_size > fft.max_mesh_size)
+      fft.max_mesh_size = mesh_size;
+  }
 
   /* === pack function === */
   for (i = 1; i < 4; i++) {
@@ -632,6 +660,13 @@ int fft_init(const Utils::Vector3i &ca_mesh_dim, int const *ca_mesh_margin,
   fft.data_buf.resize(fft.max_mesh_size);
   auto *c_data = (fftw_complex *)(fft.data_buf.data());
 
+  /* the real to complex FFT is not in-place, its output goes to
+   * the mesh passed to fft_perform_forw() */
+  fft_vector<double> out_buf(real_to_complex ? fft.max_mesh_size : 0);
+  auto *c_out = (fftw_complex *)(out_buf.data());
+  auto const row_length = fft.plan[1].new_mesh[2];
+  auto const ks_row_length = ks_mesh_dim[fft.first_dir];
+
   /* === FFT Routines (Using FFTW / RFFTW package)=== */
   for (i = 1; i < 4; i++) {
     fft.plan[i].dir = FFTW_FORWARD;
@@ -639,10 +674,16 @@ int fft_init(const Utils::Vector3i &ca_mesh_dim, int const *ca_mesh_margin,
 
     if (fft.init_tag)
       fftw_destroy_plan(fft.plan[i].our_fftw_plan);
-    fft.plan[i].our_fftw_plan = fftw_plan_many_dft(
-        1, &fft.plan[i].new_mesh[2], fft.plan[i].n_ffts, c_data, nullptr, 1,
-        fft.plan[i].new_mesh[2], c_data, nullptr, 1, fft.plan[i].new_mesh[2],
-        fft.plan[i].dir, FFTW_PATIENT);
+    if (i == 1 and real_to_complex) {
+      fft.plan[1].our_fftw_plan = fftw_plan_many_dft_r2c(
+          1, &row_length, fft.plan[1].n_ffts, fft.data_buf.data(), nullptr, 1,
+          row_length, c_out, nullptr, 1, ks_row_length, FFTW_PATIENT);
+    } else {
+      fft.plan[i].our_fftw_plan = fftw_plan_many_dft(
+          1, &fft.plan[i].new_mesh[2], fft.plan[i].n_ffts, c_data, nullptr, 1,
+          fft.plan[i].new_mesh[2], c_data, nullptr, 1, fft.plan[i].new_mesh[2],
+          fft.plan[i].dir, FFTW_PATIENT);
+    }
   }
 
   /* === The BACK Direction === */
@@ -652,10 +693,16 @@ int fft_init(const Utils::Vector3i &ca_mesh_dim, int const *ca_mesh_margin,
 
     if (fft.init_tag)
       fftw_destroy_plan(fft.back[i].our_fftw_plan);
-    fft.back[i].our_fftw_plan = fftw_plan_many_dft(
-        1, &fft.plan[i].new_mesh[2], fft.plan[i].n_ffts, c_data, nullptr, 1,
-        fft.plan[i].new_mesh[2], c_data, nullptr, 1, fft.plan[i].new_mesh[2],
-        fft.back[i].dir, FFTW_PATIENT);
+    if (i == 1 and real_to_complex) {
+      fft.back[1].our_fftw_plan = fftw_plan_many_dft_c2r(
+          1, &row_length, fft.plan[1].n_ffts, c_out, nullptr, 1, ks_row_length,
+          fft.data_buf.data(), nullptr, 1, row_length, FFTW_PATIENT);
+    } else {
+      fft.back[i].our_fftw_plan = fftw_plan_many_dft(
+          1, &fft.plan[i].new_mesh[2], fft.plan[i].n_ffts, c_data, nullptr, 1,
+          fft.plan[i].new_mesh[2], c_data, nullptr, 1, fft.plan[i].new_mesh[2],
+          fft.back[i].dir, FFTW_PATIENT);
+    }
 
     fft.back[i].pack_function = pack_block_permute1;
   }
@@ -680,13 +727,19 @@ void fft_perform_forw(double *data, fft_data_struct &fft,
   /* communication to current dir row format (in is data) */
   forw_grid_comm(fft.plan[1], data, fft.data_buf.data(), fft, comm);
 
-  /* complexify the real data array (in is fft.data_buf) */
-  for (int i = 0; i < fft.plan[1].new_size; i++) {
-    data[2 * i + 0] = fft.data_buf[i]; /* real value */
-    data[2 * i + 1] = 0;               /* complex value */
+  if (fft.real_to_complex) {
+    /* perform FFT (in is fft.data_buf, out is data) */
+    fftw_execute_dft_r2c(fft.plan[1].our_fftw_plan, fft.data_buf.data(),
+                         c_data);
+  } else {
+    /* complexify the real data array (in is fft.data_buf) */
+    for (int i = 0; i < fft.plan[1].new_size; i++) {
+      data[2 * i + 0] = fft.data_buf[i]; /* real value */
+      data[2 * i + 1] = 0;               /* complex value */
+    }
+    /* perform FFT (in/out is data)*/
+    fftw_execute_dft(fft.plan[1].our_fftw_plan, c_data, c_data);
   }
-  /* perform FFT (in/out is data)*/
-  fftw_execute_dft(fft.plan[1].our_fftw_plan, c_data, c_data);
   /* ===== second direction ===== */
   /* communication to current dir row format (in is data) */
   forw_grid_comm(fft.plan[2], data, fft.data_buf.data(), fft, comm);
@@ -701,7 +754,7 @@ void fft_perform_forw(double *data, fft_data_struct &fft,
   /* REMARK: Result has to be in data. */
 }
 
-void fft_perform_back(double *data, bool check_complex, fft_data_struct &fft,
+void fft_perform_back(double *data, fft_data_struct &fft,
                       const boost::mpi::communicator &comm) {
 
   auto *c_data = (fftw_complex *)data;
@@ -723,17 +776,16 @@ void fft_perform_back(double *data, bool check_complex, fft_data_struct &fft,
                  comm);
 
   /* ===== first direction  ===== */
-  /* perform FFT (in is data) */
-  fftw_execute_dft(fft.back[1].our_fftw_plan, c_data, c_data);
-  /* throw away the (hopefully) empty complex component (in is data) */
-  for (int i = 0; i < fft.plan[1].new_size; i++) {
-    fft.data_buf[i] = data[2 * i]; /* real value */
-    // Vincent:
-    if (check_complex && (data[2 * i + 1] > 1e-5)) {
-      printf("Complex value is not zero (i=%d,data=%g)!!!\n", i,
-             data[2 * i + 1]);
-      if (i > 100)
-        throw std::runtime_error("Complex value is not zero");
+  if (fft.real_to_complex) {
+    /* perform FFT (in is data, out is fft.data_buf) */
+    fftw_execute_dft_c2r(fft.back[1].our_fftw_plan, c_data,
+                         fft.data_buf.data());
+  } else {
+    /* perform FFT (in is data) */
+    fftw_execute_dft(fft.back[1].our_fftw_plan, c_data, c_data);
+    /* throw away the (hopefully) empty complex component (in is data) */
+    for (int i = 0; i < fft.plan[1].new_size; i++) {
+      fft.data_buf[i] = data[2 * i]; /* real value */
     }
   }
   /* communicate (in is fft.data_buf) */
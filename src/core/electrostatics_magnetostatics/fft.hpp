@@ -31,9 +31,12 @@
  *  1D-FFT. After performing the FFT on that direction the data is
  *  redistributed.
  *
- *  For simplicity at the moment I have implemented a full complex to
- *  complex FFT (even though a real to complex FFT would be
- *  sufficient)
+ *  The first 1D-FFT is either a complex to complex FFT of the
+ *  complexified real data, or a real to complex FFT. In the latter
+ *  case, only the half spectrum (k >= 0 along the direction of the
+ *  first FFT) of the Hermitian k-space mesh is stored, which halves
+ *  the data of the second and third FFT and of the communication in
+ *  between. The backward FFT then expects a Hermitian k-space mesh.
  *
  *  \todo Combine the forward and backward structures.
  *  \todo The packing routines could be moved to utils.hpp when they are needed
@@ -152,6 +155,13 @@ struct fft_data_struct {
   /** Whether FFT is initialized or not. */
   bool init_tag = false;
 
+  /** Whether the first FFT is a real to complex FFT. */
+  bool real_to_complex = false;
+  /** Real space direction of the first FFT. For a real to complex FFT,
+   *  k-space only contains the mesh points with k >= 0 in this direction.
+   */
+  int first_dir = 2;
+
   /** Maximal size of the communication buffers. */
   int max_comm_size = 0;
 
@@ -176,12 +186,14 @@ struct fft_data_struct {
  *  \param[out] fft             FFT plan.
  *  \param[in]  grid            Number of nodes in each spatial dimension.
  *  \param[in]  comm            MPI communicator.
+ *  \param[in]  real_to_complex Use a real to complex FFT and store only
+ *                              the half spectrum in k-space.
  *  \return Maximal size of local fft mesh (needed for allocation of ca_mesh).
  */
 int fft_init(const Utils::Vector3i &ca_mesh_dim, int const *ca_mesh_margin,
              int const *global_mesh_dim, double const *global_mesh_off,
              int &ks_pnum, fft_data_struct &fft, const Utils::Vector3i &grid,
-             const boost::mpi::communicator &comm);
+             const boost::mpi::communicator &comm, bool real_to_complex);
 
 /** Perform an in-place forward 3D FFT.
  *  \warning The content of \a data is overwritten.
@@ -193,14 +205,13 @@ void fft_perform_forw(double *data, fft_data_struct &fft,
                       const boost::mpi::communicator &comm);
 
 /** Perform an in-place backward 3D FFT.
+ *  The imaginary part of the result is discarded.
  *  \warning The content of \a data is overwritten.
- *  \param[in,out] data           Mesh.
- *  \param[in]     check_complex  Throw an error if the complex component is
- *                                non-zero.
- *  \param[in,out] fft            FFT plan.
- *  \param[in]     comm           MPI communicator.
+ *  \param[in,out] data  Mesh.
+ *  \param[in,out] fft   FFT plan.
+ *  \param[in]     comm  MPI communicator.
  */
-void fft_perform_back(double *data, bool check_complex, fft_data_struct &fft,
+void fft_perform_back(double *data, fft_data_struct &fft,
                       const boost::mpi::communicator &comm);
 
 /** Pack a block (<tt>size[3]</tt> starting at <tt>start[3]</tt>) of an input
@@ -212,7 +212,8 @@ void dp3m_init() {
 
     int ca_mesh_size = fft_init(dp3m.local_mesh.dim, dp3m.local_mesh.margin,
                                 dp3m.params.mesh, dp3m.params.mesh_off,
-                                dp3m.ks_pnum, dp3m.fft, node_grid, comm_cart);
+                                dp3m.ks_pnum, dp3m.fft, node_grid, comm_cart,
+                                /* real_to_complex */ false);
     dp3m.rs_mesh.resize(ca_mesh_size);
     dp3m.ks_mesh.resize(ca_mesh_size);
 
@@ -607,7 +608,7 @@ double dp3m_calc_kspace_forces(bool force_flag, bool energy_flag,
         }
 
         /* Back FFT force component mesh */
-        fft_perform_back(dp3m.rs_mesh.data(), false, dp3m.fft, comm_cart);
+        fft_perform_back(dp3m.rs_mesh.data(), dp3m.fft, comm_cart);
         /* redistribute force component mesh */
         dp3m.sm.spread_grid(dp3m.rs_mesh.data(), comm_cart,
                             dp3m.local_mesh.dim);
@@ -688,12 +689,9 @@ double dp3m_calc_kspace_forces(bool force_flag, bool energy_flag,
           }
         }
         /* Back FFT force component mesh */
-        fft_perform_back(dp3m.rs_mesh_dip[0].data(), false, dp3m.fft,
-                         comm_cart);
-        fft_perform_back(dp3m.rs_mesh_dip[1].data(), false, dp3m.fft,
-                         comm_cart);
-        fft_perform_back(dp3m.rs_mesh_dip[2].data(), false, dp3m.fft,
-                         comm_cart);
+        fft_perform_back(dp3m.rs_mesh_dip[0].data(), dp3m.fft, comm_cart);
+        fft_perform_back(dp3m.rs_mesh_dip[1].data(), dp3m.fft, comm_cart);
+        fft_perform_back(dp3m.rs_mesh_dip[2].data(), dp3m.fft, comm_cart);
         /* redistribute force component mesh */
         std::array<double *, 3> meshes = {dp3m.rs_mesh_dip[0].data(),
                                           dp3m.rs_mesh_dip[1].data(),
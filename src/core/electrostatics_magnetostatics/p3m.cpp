@@ -36,6 +36,7 @@
 #include "fft.hpp"
 #include "grid.hpp"
 #include "integrate.hpp"
+#include "timings.hpp"
 #include "tuning.hpp"
 #ifdef CUDA
 #include "p3m_gpu_error.hpp"
@@ -188,7 +189,8 @@ void p3m_init() {
 
     int ca_mesh_size = fft_init(p3m.local_mesh.dim, p3m.local_mesh.margin,
                                 p3m.params.mesh, p3m.params.mesh_off,
-                                p3m.ks_pnum, p3m.fft, node_grid, comm_cart);
+                                p3m.ks_pnum, p3m.fft, node_grid, comm_cart,
+                                /* real_to_complex */ true);
     p3m.rs_mesh.resize(ca_mesh_size);
     for (auto &e : p3m.E_mesh) {
       e.resize(ca_mesh_size);
@@ -324,6 +326,7 @@ template <size_t cao> struct AssignCharge {
 } // namespace
 
 void p3m_charge_assign(const ParticleRange &particles) {
+  Timings::ScopedTimer timer(Timings::Section::P3M_CHARGE_ASSIGNMENT);
   p3m.inter_weights.reset(p3m.params.cao);
 
   /* prepare local FFT mesh */
@@ -390,6 +393,30 @@ auto calc_dipole_moment(boost::mpi::communicator const &comm,
   return boost::mpi::all_reduce(comm, local_dip, std::plus<>());
 }
 
+/** Index of the direction in k-space in which only the half spectrum
+ *  is stored, see @ref fft_data_struct::first_dir.
+ */
+int half_spectrum_dir() {
+  for (int d = 0; d < 3; d++) {
+    if ((d + p3m.ks_pnum) % 3 == p3m.fft.first_dir)
+      return d;
+  }
+  return -1;
+}
+
+/** Weight of a k-space mesh point in sums over the full spectrum.
+ *  The points whose partner at -k is not part of the half spectrum
+ *  count twice, since the Fourier transform of the real charge
+ *  density is Hermitian.
+ *
+ *  @param n Global index of the point in the direction of the half
+ *           spectrum.
+ */
+double hermitian_weight(int n) {
+  auto const mesh = p3m.params.mesh[p3m.fft.first_dir];
+  return (n == 0 or 2 * n == mesh) ? 1. : 2.;
+}
+
 void add_dipole_correction(Utils::Vector3d const &box_dipole,
                            const ParticleRange &particles) {
   auto const pref = coulomb.prefactor * 4 * Utils::pi() / box_geo.volume() /
@@ -426,6 +453,7 @@ Utils::Vector9d p3m_calc_kspace_pressure_tensor() {
     int ind = 0;
     int j[3];
     auto const half_alpha_inv_sq = Utils::sqr(1.0 / 2.0 / p3m.params.alpha);
+    auto const d_half = half_spectrum_dir();
     for (j[0] = 0; j[0] < p3m.fft.plan[3].new_mesh[RX]; j[0]++) {
       for (j[1] = 0; j[1] < p3m.fft.plan[3].new_mesh[RY]; j[1]++) {
         for (j[2] = 0; j[2] < p3m.fft.plan[3].new_mesh[RZ]; j[2]++) {
@@ -440,11 +468,13 @@ Utils::Vector9d p3m_calc_kspace_pressure_tensor() {
                           box_geo.length()[RZ];
           auto const sqk = Utils::sqr(kx) + Utils::sqr(ky) + Utils::sqr(kz);
 
+          auto const weight =
+              hermitian_weight(j[d_half] + p3m.fft.plan[3].start[d_half]);
           auto const node_k_space_energy =
-              (sqk == 0)
-                  ? 0.0
-                  : p3m.g_energy[ind] * (Utils::sqr(p3m.rs_mesh[2 * ind]) +
-                                         Utils::sqr(p3m.rs_mesh[2 * ind + 1]));
+              (sqk == 0) ? 0.0
+                         : weight * p3m.g_energy[ind] *
+                               (Utils::sqr(p3m.rs_mesh[2 * ind]) +
+                                Utils::sqr(p3m.rs_mesh[2 * ind + 1]));
           ind++;
 
           auto const vterm =
@@ -477,8 +507,11 @@ double p3m_calc_kspace_forces(bool force_flag, bool energy_flag,
                               const ParticleRange &particles) {
   /* Gather information for FFT grid inside the nodes domain (inner local mesh)
    * and perform forward 3D FFT (Charge Assignment Mesh). */
-  p3m.sm.gather_grid(p3m.rs_mesh.data(), comm_cart, p3m.local_mesh.dim);
-  fft_perform_forw(p3m.rs_mesh.data(), p3m.fft, comm_cart);
+  {
+    Timings::ScopedTimer timer(Timings::Section::P3M_FFT);
+    p3m.sm.gather_grid(p3m.rs_mesh.data(), comm_cart, p3m.local_mesh.dim);
+    fft_perform_forw(p3m.rs_mesh.data(), p3m.fft, comm_cart);
+  }
 
   // Note: after these calls, the grids are in the order yzx and not xyz
   // anymore!!!
@@ -519,23 +552,25 @@ double p3m_calc_kspace_forces(bool force_flag, bool energy_flag,
     }
 
     /* Back FFT force component mesh */
-    for (int d = 0; d < 3; d++) {
-      fft_perform_back(p3m.E_mesh[d].data(),
-                       /* check_complex */ !p3m.params.tuning, p3m.fft,
-                       comm_cart);
+    {
+      Timings::ScopedTimer timer(Timings::Section::P3M_FFT);
+      for (int d = 0; d < 3; d++) {
+        fft_perform_back(p3m.E_mesh[d].data(), p3m.fft, comm_cart);
+      }
     }
 
     {
+      Timings::ScopedTimer timer(Timings::Section::P3M_BACK_INTERPOLATION);
       std::array<double *, 3> E_fields = {
           p3m.E_mesh[0].data(), p3m.E_mesh[1].data(), p3m.E_mesh[2].data()};
       /* redistribute force component mesh */
       p3m.sm.spread_grid(Utils::make_span(E_fields), comm_cart,
                          p3m.local_mesh.dim);
-    }
 
-    auto const force_prefac = coulomb.prefactor / box_geo.volume();
-    Utils::integral_parameter<AssignForces, 1, 7>(p3m.params.cao, force_prefac,
-                                                  particles);
+      auto const force_prefac = coulomb.prefactor / box_geo.volume();
+      Utils::integral_parameter<AssignForces, 1, 7>(
+          p3m.params.cao, force_prefac, particles);
+    }
 
     if (p3m.params.epsilon != P3M_EPSILON_METALLIC) {
       add_dipole_correction(box_dipole.value(), particles);
@@ -546,11 +581,21 @@ double p3m_calc_kspace_forces(bool force_flag, bool energy_flag,
   if (energy_flag) {
     double node_k_space_energy = 0.;
 
-    for (int i = 0; i < p3m.fft.plan[3].new_size; i++) {
-      // Use the energy optimized influence function for energy!
-      node_k_space_energy +=
-          p3m.g_energy[i] *
-          (Utils::sqr(p3m.rs_mesh[2 * i]) + Utils::sqr(p3m.rs_mesh[2 * i + 1]));
+    auto const d_half = half_spectrum_dir();
+    int j[3];
+    int ind = 0;
+    for (j[0] = 0; j[0] < p3m.fft.plan[3].new_mesh[0]; j[0]++) {
+      for (j[1] = 0; j[1] < p3m.fft.plan[3].new_mesh[1]; j[1]++) {
+        for (j[2] = 0; j[2] < p3m.fft.plan[3].new_mesh[2]; j[2]++) {
+          auto const weight =
+              hermitian_weight(j[d_half] + p3m.fft.plan[3].start[d_half]);
+          // Use the energy optimized influence function for energy!
+          node_k_space_energy += weight * p3m.g_energy[ind] *
+                                 (Utils::sqr(p3m.rs_mesh[2 * ind]) +
+                                  Utils::sqr(p3m.rs_mesh[2 * ind + 1]));
+          ind++;
+        }
+      }
     }
     node_k_space_energy *= coulomb.prefactor / (2 * box_geo.volume());
 
@@ -38,6 +38,11 @@
 #include "electrostatics_magnetostatics/coulomb.hpp"
 #include "electrostatics_magnetostatics/dipole.hpp"
 
+#include <utils/contains.hpp>
+
+#include <algorithm>
+#include <functional>
+
 ActorList energyActors;
 
 /** Energy of the system */
@@ -71,12 +76,14 @@ void energy_calc(const double time) {
   }
 
   short_range_loop(
-      [](Particle &p) { add_bonded_energy(p, obs_energy); },
+      [](Particle &) {},
       [](Particle const &p1, Particle const &p2, Distance const &d) {
         add_non_bonded_pair_energy(p1, p2, d.vec21, sqrt(d.dist2), d.dist2,
                                    obs_energy);
       });
 
+  add_bonded_energies(cell_structure.bond_lists(), obs_energy);
+
   calc_long_range_energies(cell_structure.local_particles());
 
   auto local_parts = cell_structure.local_particles();
@@ -116,6 +123,94 @@ double calculate_current_potential_energy_of_system() {
   return obs_energy.accumulate(-obs_energy.kinetic[0]);
 }
 
+bool particle_energies_available() { return energyActors.empty(); }
+
+static double particle_energy_local(int pid) {
+  on_observable_calc();
+
+  Observable_stat obs{1};
+
+  auto const p = cell_structure.get_local_particle(pid);
+  if (p and not p->l.ghost) {
+    particle_neighbor_loop(
+        *p, [&obs](Particle const &p1, Particle const &p2, Distance const &d) {
+          add_non_bonded_pair_energy(p1, p2, d.vec21, sqrt(d.dist2), d.dist2,
+                                     obs);
+        });
+
+    auto const pos = folded_position(p->r.p, box_geo);
+    for (auto const &c : Constraints::constraints) {
+      c->add_energy(*p, pos, sim_time, obs);
+    }
+  }
+
+  /* The bonds of the particle are stored on it or on one of its
+   * partners, which may reside on any node. */
+  if (not bonded_ia_params.empty()) {
+    auto const involves_pid = [pid](Particle const &p1,
+                                    Utils::Span<Particle *> partners) {
+      return p1.identity() == pid or
+             std::any_of(partners.begin(), partners.end(),
+                         [pid](Particle const *p2) {
+                           return p2->identity() == pid;
+                         });
+    };
+
+    for (auto &part : cell_structure.local_particles()) {
+      auto const &bonds = part.bonds();
+      if (part.identity() != pid and
+          std::none_of(bonds.begin(), bonds.end(), [pid](BondView const &b) {
+            return Utils::contains(b.partner_ids(), pid);
+          }))
+        continue;
+
+      cell_structure.execute_bond_handler(
+          part, [&obs, &involves_pid](Particle &p1, int bond_id,
+                                    Utils::Span<Particle *> partners) {
+            if (not involves_pid(p1, partners))
+              return false;
+
+            auto const result =
+                calc_bonded_energy(bonded_ia_params[bond_id], p1, partners);
+            if (result) {
+              obs.bonded_contribution(bond_id)[0] += result.get();
+              return false;
+            }
+            return true;
+          });
+    }
+  }
+
+  return obs.accumulate(0.);
+}
+
+REGISTER_CALLBACK_REDUCTION(particle_energy_local, std::plus<>())
+
+double mpi_calculate_particle_energy(int pid) {
+  return mpi_call(Communication::Result::reduction, std::plus<>(),
+                  particle_energy_local, pid);
+}
+
+static double long_range_energy_local() {
+  on_observable_calc();
+
+  auto energy = 0.;
+#ifdef ELECTROSTATICS
+  energy += Coulomb::calc_energy_long_range(cell_structure.local_particles());
+#endif
+#ifdef DIPOLES
+  energy += Dipole::calc_energy_long_range(cell_structure.local_particles());
+#endif
+  return energy;
+}
+
+REGISTER_CALLBACK_REDUCTION(long_range_energy_local, std::plus<>())
+
+double mpi_calculate_long_range_energy() {
+  return mpi_call(Communication::Result::reduction, std::plus<>(),
+                  long_range_energy_local);
+}
+
 double observable_compute_energy() {
   update_energy();
   return obs_energy.accumulate(0);
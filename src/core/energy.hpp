@@ -48,6 +48,23 @@ void calc_long_range_energies(const ParticleRange &particles);
 /** Calculate the total energy of the system. */
 double calculate_current_potential_energy_of_system();
 
+/** Whether the short-range part of the potential energy can be calculated
+ *  particle by particle with @ref mpi_calculate_particle_energy. This is not
+ *  the case if energies are calculated by actors, e.g. on the GPU.
+ */
+bool particle_energies_available();
+
+/** Calculate the potential energy of all short-range, bonded and constraint
+ *  interactions a particle takes part in. Only the neighbor cells of the
+ *  particle are searched for interaction partners. The change of the
+ *  potential energy of the system by a change of this particle alone is
+ *  the change of this energy plus the change of the long-range energy.
+ */
+double mpi_calculate_particle_energy(int pid);
+
+/** Calculate the long-range energies (P3M, ...) of the system. */
+double mpi_calculate_long_range_energy();
+
 /** Helper function for @ref Observables::Energy. */
 double observable_compute_energy();
 
@@ -27,6 +27,7 @@
 #include "config.hpp"
 #include <boost/range/algorithm/find_if.hpp>
 
+#include "BondLists.hpp"
 #include "Observable_stat.hpp"
 #include "bonded_interactions/angle_cosine.hpp"
 #include "bonded_interactions/angle_cossquare.hpp"
@@ -301,14 +302,15 @@ inline double calc_kinetic_energy(Particle const &p1) {
   return res;
 }
 
-/** Add bonded energies for one particle to the energy observable.
- *  @param[in] p   particle for which to calculate energies
- *  @param[out]    obs_energy   energy observable
+/** Add the bonded energies of all local particles to the energy observable.
+ *  @param[in] bond_lists  bonds of the local particles
+ *  @param[out] obs_energy energy observable
  */
-inline void add_bonded_energy(Particle &p, Observable_stat &obs_energy) {
-  cell_structure.execute_bond_handler(
-      p, [&obs_energy](Particle &p1, int bond_id,
-                       Utils::Span<Particle *> partners) {
+inline void add_bonded_energies(BondLists &bond_lists,
+                                Observable_stat &obs_energy) {
+  bond_lists.for_each_bond(
+      [&obs_energy](Particle &p1, int bond_id,
+                    Utils::Span<Particle *> partners) {
         auto const &iaparams = bonded_ia_params[bond_id];
         auto const result = calc_bonded_energy(iaparams, p1, partners);
         if (result) {
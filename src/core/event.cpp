@@ -50,6 +50,7 @@
 #include "electrostatics_magnetostatics/coulomb.hpp"
 #include "electrostatics_magnetostatics/dipole.hpp"
 #include "nonbonded_interactions/nonbonded_interaction_data.hpp"
+#include "nonbonded_interactions/spline_tabulation.hpp"
 
 #ifdef SCAFACOS
 #include "electrostatics_magnetostatics/scafacos.hpp"
@@ -219,7 +220,9 @@ void on_coulomb_change() {
 }
 
 void on_short_range_ia_change() {
+  recalc_nonbonded_ia_params();
   cells_re_init(cell_structure.decomposition_type());
+  SplineTabulation::invalidate();
 
   recalc_forces = true;
 }
@@ -238,6 +241,7 @@ void on_boxl_change() {
   grid_changed_box_l(box_geo);
   /* Electrostatics cutoffs mostly depend on the system size,
      therefore recalculate them. */
+  recalc_nonbonded_ia_params();
   cells_re_init(cell_structure.decomposition_type());
 
 /* Now give methods a chance to react to the change in box length */
@@ -249,6 +253,9 @@ void on_boxl_change() {
   Dipole::on_boxl_change();
 #endif
 
+  /* The real-space electrostatics may depend on the box */
+  SplineTabulation::invalidate();
+
   lb_lbfluid_init();
 #ifdef LB_BOUNDARIES
   LBBoundaries::lb_init_boundaries();
@@ -330,6 +337,7 @@ void on_parameter_change(int field) {
   case FIELD_THERMALIZEDBONDS:
     break;
   case FIELD_SIMTIME:
+  case FIELD_LONG_RANGE_INTERVAL:
     recalc_forces = true;
     break;
   }
@@ -40,11 +40,15 @@
 #include "grid_based_algorithms/lb_interface.hpp"
 #include "grid_based_algorithms/lb_particle_coupling.hpp"
 #include "immersed_boundaries.hpp"
+#include "nonbonded_interactions/batched_pair_kernel.hpp"
+#include "nonbonded_interactions/spline_tabulation.hpp"
 #include "short_range_loop.hpp"
+#include "timings.hpp"
 
 #include <profiler/profiler.hpp>
 
 #include <cassert>
+#include <vector>
 
 ActorList forceActors;
 
@@ -79,8 +83,104 @@ void init_forces_ghosts(const ParticleRange &particles) {
   }
 }
 
-void force_calc(CellStructure &cell_structure) {
+/**
+ * @brief Check if the non-bonded pair forces can be evaluated
+ *        on the structure-of-arrays mirror of the cells.
+ *
+ * This is the case if only central potentials contribute,
+ * which only depend on the particle types and the distance.
+ */
+static bool soa_pair_loop_applicable(CellStructure &cell_structure,
+                                     double coulomb_cutoff,
+                                     double dipole_cutoff) {
+  if (not cell_structure.use_soa_mirror)
+    return false;
+
+  if (coulomb_cutoff != INACTIVE_CUTOFF or dipole_cutoff != INACTIVE_CUTOFF)
+    return false;
+
+#ifdef DPD
+  if (thermo_switch & THERMO_DPD)
+    return false;
+#endif
+
+#ifdef COLLISION_DETECTION
+  if (collision_params.mode != COLLISION_MODE_OFF)
+    return false;
+#endif
+
+  for (auto const &ia : ia_params) {
+#ifdef GAY_BERNE
+    if (ia.gay_berne.cut != INACTIVE_CUTOFF)
+      return false;
+#endif
+#ifdef THOLE
+    if (ia.thole.scaling_coeff != 0.)
+      return false;
+#endif
+  }
+
+#ifdef EXCLUSIONS
+  /* The exclusion lists are symmetric, so it is sufficient
+   * to check the local particles. */
+  for (auto const &p : cell_structure.local_particles()) {
+    if (not p.exclusions().empty())
+      return false;
+  }
+#endif
+
+  return true;
+}
+
+/**
+ * @brief Check if the ghost update can still be in flight at the
+ *        start of the force calculation.
+ *
+ * This is the case if the ghost particles are only needed
+ * in the pair loop on the structure-of-arrays mirror, which
+ * completes the update when it reaches the boundary cells.
+ */
+static bool ghost_update_overlappable(bool use_soa_mirror) {
+  if (not use_soa_mirror or not forceActors.empty())
+    return false;
+
+#ifdef ELECTROSTATICS
+  if (coulomb.method != COULOMB_NONE)
+    return false;
+#endif
+#ifdef DIPOLES
+  if (dipole.method != DIPOLAR_NONE)
+    return false;
+#endif
+
+  return true;
+}
+
+void force_calc(CellStructure &cell_structure, double long_range_weight) {
   ESPRESSO_PROFILER_CXX_MARK_FUNCTION;
+  Timings::ScopedTimer timer(Timings::Section::FORCE_CALC);
+
+#ifdef ELECTROSTATICS
+  auto const coulomb_cutoff = Coulomb::cutoff(box_geo.length());
+#else
+  auto const coulomb_cutoff = INACTIVE_CUTOFF;
+#endif
+
+#ifdef DIPOLES
+  auto const dipole_cutoff = Dipole::cutoff(box_geo.length());
+#else
+  auto const dipole_cutoff = INACTIVE_CUTOFF;
+#endif
+
+  auto const *const spline_tables = SplineTabulation::tables();
+  auto const use_soa_mirror =
+      not spline_tables and
+      soa_pair_loop_applicable(cell_structure, coulomb_cutoff, dipole_cutoff);
+
+  /* Complete a ghost update started by cells_update_ghosts_begin,
+   * unless it can be overlapped with the pair loop. */
+  if (not ghost_update_overlappable(use_soa_mirror))
+    cell_structure.ghosts_wait();
 
   espressoSystemInterface.update();
 
@@ -102,31 +202,60 @@ void force_calc(CellStructure &cell_structure) {
 #endif
   }
 
-  calc_long_range_forces(particles);
-
-#ifdef ELECTROSTATICS
-  auto const coulomb_cutoff = Coulomb::cutoff(box_geo.length());
-#else
-  auto const coulomb_cutoff = INACTIVE_CUTOFF;
+  calc_long_range_forces(particles, long_range_weight);
+
+  if (use_soa_mirror and BatchedPairKernel::applicable()) {
+    auto const mi = cell_structure.minimum_image_distance()
+                        ? BatchedPairKernel::minimal_image(box_geo)
+                        : BatchedPairKernel::MinimalImage{};
+    auto const virial = short_range_loop_soa_batched(
+        [](Particle &) {},
+        [&mi](ParticleSoA &soa1, std::size_t i, ParticleSoA &soa2,
+              std::size_t first, std::size_t last) {
+          soa1.add_virial(
+              BatchedPairKernel::add_forces(soa1, i, soa2, first, last, mi));
+        });
+#ifdef NPT
+    npt_add_virial_contribution(virial);
 #endif
-
-#ifdef DIPOLES
-  auto const dipole_cutoff = Dipole::cutoff(box_geo.length());
-#else
-  auto const dipole_cutoff = INACTIVE_CUTOFF;
+  } else if (use_soa_mirror) {
+    auto const virial = short_range_loop_soa(
+        [](Particle &) {},
+        [](ParticleSoA &soa1, std::size_t i, ParticleSoA &soa2, std::size_t j,
+           Distance const &d) {
+          IA_parameters const &ia_params =
+              *get_ia_param(soa1.type(i), soa2.type(j));
+          auto const dist = sqrt(d.dist2);
+          if (dist < ia_params.max_cut) {
+            auto const force =
+                calc_central_radial_force_factor(ia_params, dist) * d.vec21;
+            soa1.add_virial(Utils::hadamard_product(force, d.vec21));
+            soa1.add_force(i, force);
+            soa2.add_force(j, -force);
+          }
+        });
+#ifdef NPT
+    npt_add_virial_contribution(virial);
 #endif
-
-  short_range_loop(
-      [](Particle &p) { add_single_particle_force(p); },
-      [](Particle &p1, Particle &p2, Distance const &d) {
-        add_non_bonded_pair_force(p1, p2, d.vec21, sqrt(d.dist2), d.dist2);
+  } else {
+    short_range_loop(
+        [](Particle &) {},
+        [spline_tables](Particle &p1, Particle &p2, Distance const &d) {
+          if (not(spline_tables and add_splined_pair_force(*spline_tables, p1,
+                                                           p2, d.vec21,
+                                                           d.dist2)))
+            add_non_bonded_pair_force(p1, p2, d.vec21, sqrt(d.dist2),
+                                      d.dist2);
 #ifdef COLLISION_DETECTION
-        if (collision_params.mode != COLLISION_MODE_OFF)
-          detect_collision(p1, p2, d.dist2);
+          if (collision_params.mode != COLLISION_MODE_OFF)
+            detect_collision(p1, p2, d.dist2);
 #endif
-      },
-      VerletCriterion{skin, interaction_range(), coulomb_cutoff, dipole_cutoff,
-                      collision_detection_cutoff()});
+        },
+        VerletCriterion{skin, interaction_range(), coulomb_cutoff,
+                        dipole_cutoff, collision_detection_cutoff()});
+  }
+
+  add_bonded_forces(cell_structure.bond_lists());
 
   Constraints::constraints.add_forces(particles, sim_time);
 
@@ -173,8 +302,34 @@ void force_calc(CellStructure &cell_structure) {
   recalc_forces = false;
 }
 
-void calc_long_range_forces(const ParticleRange &particles) {
+void calc_long_range_forces(const ParticleRange &particles, double weight) {
   ESPRESSO_PROFILER_CXX_MARK_FUNCTION;
+  if (weight == 0.)
+    return;
+
+  if (weight != 1.) {
+    /* Evaluate the long range forces on zeroed forces, and add
+     * them to the forces so far with the weight. */
+    std::vector<ParticleForce> forces;
+    forces.reserve(particles.size());
+    for (auto &p : particles) {
+      forces.push_back(p.f);
+      p.f = {};
+    }
+
+    calc_long_range_forces(particles);
+
+    auto f = forces.begin();
+    for (auto &p : particles) {
+      p.f.f = f->f + weight * p.f.f;
+#ifdef ROTATION
+      p.f.torque = f->torque + weight * p.f.torque;
+#endif
+      ++f;
+    }
+    return;
+  }
+
 #ifdef ELECTROSTATICS
   /* calculate k-space part of electrostatic interaction. */
   Coulomb::calc_long_range_force(particles);
@@ -60,11 +60,24 @@ void init_forces_ghosts(const ParticleRange &particles);
  *  <li> Calculate non-bonded short range interaction forces
  *  <li> Calculate long range interaction forces
  *  </ol>
+ *
+ *  @param cell_structure     The cell structure.
+ *  @param long_range_weight  Factor of the long range forces,
+ *                            see @ref calc_long_range_forces.
  */
-void force_calc(CellStructure &cell_structure);
+void force_calc(CellStructure &cell_structure, double long_range_weight = 1.);
 
-/** Calculate long range forces (P3M, ...). */
-void calc_long_range_forces(const ParticleRange &particles);
+/** Calculate long range forces (P3M, ...).
+ *
+ *  For multiple time stepping, the long range forces and torques
+ *  are added with a weight: the number of inner steps on the steps
+ *  where they are evaluated, and zero on the other steps.
+ *
+ *  @param particles  The local particles.
+ *  @param weight     Factor of the long range forces and torques.
+ */
+void calc_long_range_forces(const ParticleRange &particles,
+                            double weight = 1.);
 /*@}*/
 
 #endif
@@ -23,6 +23,7 @@
 
 #include "config.hpp"
 
+#include "BondLists.hpp"
 #include "bonded_interactions/angle_cosine.hpp"
 #include "bonded_interactions/angle_cossquare.hpp"
 #include "bonded_interactions/angle_harmonic.hpp"
@@ -54,6 +55,7 @@
 #include "nonbonded_interactions/nonbonded_tab.hpp"
 #include "nonbonded_interactions/smooth_step.hpp"
 #include "nonbonded_interactions/soft_sphere.hpp"
+#include "nonbonded_interactions/spline_tabulation.hpp"
 #include "nonbonded_interactions/thole.hpp"
 #include "nonbonded_interactions/wca.hpp"
 #include "npt.hpp"
@@ -75,6 +77,11 @@
 #include "dpd.hpp"
 #endif
 
+#include <array>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+
 /** Initialize the forces for a ghost particle */
 inline ParticleForce init_ghost_force(Particle const &) { return {}; }
 
@@ -121,77 +128,165 @@ inline ParticleForce init_local_particle_force(Particle const &part) {
   return thermostat_force(part) + external_force(part);
 }
 
-inline Utils::Vector3d calc_non_bonded_pair_force_parts(
-    Particle const &p1, Particle const &p2, IA_parameters const &ia_params,
-    Utils::Vector3d const &d, double const dist,
-    Utils::Vector3d *torque1 = nullptr, Utils::Vector3d *torque2 = nullptr) {
-
-  Utils::Vector3d force{};
+/** Sum of the force factors of the central non-bonded potentials in
+ *  @p potentials, i.e. of potentials that only depend on the particle
+ *  types and the distance. The force is the force factor times the
+ *  distance vector.
+ *  @tparam Potentials  Bit mask of @ref NonBondedPotential, either
+ *                      known at runtime, or at compile time as
+ *                      @c std::integral_constant, in which case the
+ *                      inactive potentials are not compiled in.
+ */
+template <class Potentials>
+inline double calc_central_radial_force_factor(IA_parameters const &ia_params,
+                                               double const dist,
+                                               Potentials const potentials) {
   double force_factor = 0;
 /* Lennard-Jones */
 #ifdef LENNARD_JONES
-  force_factor += lj_pair_force_factor(ia_params, dist);
+  if (potentials & NB_LENNARD_JONES)
+    force_factor += lj_pair_force_factor(ia_params, dist);
 #endif
 /* WCA */
 #ifdef WCA
-  force_factor += wca_pair_force_factor(ia_params, dist);
+  if (potentials & NB_WCA)
+    force_factor += wca_pair_force_factor(ia_params, dist);
 #endif
 /* Lennard-Jones generic */
 #ifdef LENNARD_JONES_GENERIC
-  force_factor += ljgen_pair_force_factor(ia_params, dist);
+  if (potentials & NB_LENNARD_JONES_GENERIC)
+    force_factor += ljgen_pair_force_factor(ia_params, dist);
 #endif
 /* smooth step */
 #ifdef SMOOTH_STEP
-  force_factor += SmSt_pair_force_factor(ia_params, dist);
+  if (potentials & NB_SMOOTH_STEP)
+    force_factor += SmSt_pair_force_factor(ia_params, dist);
 #endif
 /* Hertzian force */
 #ifdef HERTZIAN
-  force_factor += hertzian_pair_force_factor(ia_params, dist);
+  if (potentials & NB_HERTZIAN)
+    force_factor += hertzian_pair_force_factor(ia_params, dist);
 #endif
 /* Gaussian force */
 #ifdef GAUSSIAN
-  force_factor += gaussian_pair_force_factor(ia_params, dist);
+  if (potentials & NB_GAUSSIAN)
+    force_factor += gaussian_pair_force_factor(ia_params, dist);
 #endif
 /* BMHTF NaCl */
 #ifdef BMHTF_NACL
-  force_factor += BMHTF_pair_force_factor(ia_params, dist);
+  if (potentials & NB_BMHTF_NACL)
+    force_factor += BMHTF_pair_force_factor(ia_params, dist);
 #endif
-/* Buckingham*/
+/* Buckingham */
 #ifdef BUCKINGHAM
-  force_factor += buck_pair_force_factor(ia_params, dist);
+  if (potentials & NB_BUCKINGHAM)
+    force_factor += buck_pair_force_factor(ia_params, dist);
 #endif
-/* Morse*/
+/* Morse */
 #ifdef MORSE
-  force_factor += morse_pair_force_factor(ia_params, dist);
+  if (potentials & NB_MORSE)
+    force_factor += morse_pair_force_factor(ia_params, dist);
 #endif
-/*soft-sphere potential*/
+/* soft-sphere potential */
 #ifdef SOFT_SPHERE
-  force_factor += soft_pair_force_factor(ia_params, dist);
+  if (potentials & NB_SOFT_SPHERE)
+    force_factor += soft_pair_force_factor(ia_params, dist);
 #endif
-/*hat potential*/
+/* hat potential */
 #ifdef HAT
-  force_factor += hat_pair_force_factor(ia_params, dist);
+  if (potentials & NB_HAT)
+    force_factor += hat_pair_force_factor(ia_params, dist);
 #endif
 /* Lennard-Jones cosine */
 #ifdef LJCOS
-  force_factor += ljcos_pair_force_factor(ia_params, dist);
+  if (potentials & NB_LJCOS)
+    force_factor += ljcos_pair_force_factor(ia_params, dist);
 #endif
-/* Lennard-Jones cosine */
+/* Lennard-Jones cosine 2 */
 #ifdef LJCOS2
-  force_factor += ljcos2_pair_force_factor(ia_params, dist);
-#endif
-/* Thole damping */
-#ifdef THOLE
-  force += thole_pair_force(p1, p2, ia_params, d, dist);
+  if (potentials & NB_LJCOS2)
+    force_factor += ljcos2_pair_force_factor(ia_params, dist);
 #endif
 /* tabulated */
 #ifdef TABULATED
-  force_factor += tabulated_pair_force_factor(ia_params, dist);
+  if (potentials & NB_TABULATED)
+    force_factor += tabulated_pair_force_factor(ia_params, dist);
+#endif
+  return force_factor;
+}
+
+/** Force factor of a type pair for which exactly the
+ *  potentials @p potentials are active.
+ */
+template <unsigned potentials>
+inline double fused_central_radial_force_factor(IA_parameters const &ia_params,
+                                                double const dist) {
+  return calc_central_radial_force_factor(
+      ia_params, dist, std::integral_constant<unsigned, potentials>{});
+}
+
+/** Sum of the force factors of all central non-bonded potentials
+ *  of a type pair. Pairs with a single active potential are
+ *  dispatched to a kernel for just this potential, all others
+ *  only evaluate their active potentials.
+ */
+inline double calc_central_radial_force_factor(IA_parameters const &ia_params,
+                                               double const dist) {
+  switch (ia_params.potentials & NB_CENTRAL_POTENTIALS) {
+  case 0:
+    return 0.;
+  case NB_LENNARD_JONES:
+    return fused_central_radial_force_factor<NB_LENNARD_JONES>(ia_params, dist);
+  case NB_WCA:
+    return fused_central_radial_force_factor<NB_WCA>(ia_params, dist);
+  case NB_LENNARD_JONES_GENERIC:
+    return fused_central_radial_force_factor<NB_LENNARD_JONES_GENERIC>(
+        ia_params, dist);
+  case NB_SMOOTH_STEP:
+    return fused_central_radial_force_factor<NB_SMOOTH_STEP>(ia_params, dist);
+  case NB_HERTZIAN:
+    return fused_central_radial_force_factor<NB_HERTZIAN>(ia_params, dist);
+  case NB_GAUSSIAN:
+    return fused_central_radial_force_factor<NB_GAUSSIAN>(ia_params, dist);
+  case NB_BMHTF_NACL:
+    return fused_central_radial_force_factor<NB_BMHTF_NACL>(ia_params, dist);
+  case NB_BUCKINGHAM:
+    return fused_central_radial_force_factor<NB_BUCKINGHAM>(ia_params, dist);
+  case NB_MORSE:
+    return fused_central_radial_force_factor<NB_MORSE>(ia_params, dist);
+  case NB_SOFT_SPHERE:
+    return fused_central_radial_force_factor<NB_SOFT_SPHERE>(ia_params, dist);
+  case NB_HAT:
+    return fused_central_radial_force_factor<NB_HAT>(ia_params, dist);
+  case NB_LJCOS:
+    return fused_central_radial_force_factor<NB_LJCOS>(ia_params, dist);
+  case NB_LJCOS2:
+    return fused_central_radial_force_factor<NB_LJCOS2>(ia_params, dist);
+  case NB_TABULATED:
+    return fused_central_radial_force_factor<NB_TABULATED>(ia_params, dist);
+  default:
+    return calc_central_radial_force_factor(ia_params, dist,
+                                            ia_params.potentials);
+  }
+}
+
+inline Utils::Vector3d calc_non_bonded_pair_force_parts(
+    Particle const &p1, Particle const &p2, IA_parameters const &ia_params,
+    Utils::Vector3d const &d, double const dist,
+    Utils::Vector3d *torque1 = nullptr, Utils::Vector3d *torque2 = nullptr) {
+
+  Utils::Vector3d force{};
+  auto const force_factor = calc_central_radial_force_factor(ia_params, dist);
+/* Thole damping */
+#ifdef THOLE
+  if (ia_params.potentials & NB_THOLE)
+    force += thole_pair_force(p1, p2, ia_params, d, dist);
 #endif
 /* Gay-Berne */
 #ifdef GAY_BERNE
   // The gb force function isn't inlined, probably due to its size
-  if (dist < ia_params.gay_berne.cut) {
+  if ((ia_params.potentials & NB_GAY_BERNE) and
+      dist < ia_params.gay_berne.cut) {
     auto const forces =
         gb_pair_force(p1.r.calc_director(), p2.r.calc_director(), ia_params, d,
                       dist, torque1, torque2);
@@ -319,6 +414,52 @@ inline void add_non_bonded_pair_force(Particle &p1, Particle &p2,
 #endif
 }
 
+/** Calculate non-bonded forces between a pair of particles from the
+ *  spline tables and update their forces.
+ *  @param[in] tables   spline tables of the interactions.
+ *  @param[in,out] p1   particle 1.
+ *  @param[in,out] p2   particle 2.
+ *  @param[in] d        vector between @p p1 and @p p2.
+ *  @param dist2        distance squared between @p p1 and @p p2.
+ *  @return Whether the tables cover the pair. If not, no forces
+ *          were added and @ref add_non_bonded_pair_force has to
+ *          be used.
+ */
+inline bool add_splined_pair_force(SplineTabulation::Tables const &tables,
+                                   Particle &p1, Particle &p2,
+                                   Utils::Vector3d const &d, double dist2) {
+  if (dist2 < tables.min_dist2)
+    return false;
+
+  auto const *pair = tables.pair(p1.p.type, p2.p.type);
+  if (not pair)
+    return false;
+
+  double force_factor = 0.;
+#ifdef ELECTROSTATICS
+  auto const q1q2 = p1.p.q * p2.p.q;
+  if (q1q2 != 0.) {
+    if (not tables.coulomb_tabulated)
+      return false;
+    force_factor += q1q2 * tables.coulomb(dist2);
+  }
+#endif
+
+#ifdef EXCLUSIONS
+  if (do_nonbonded(p1, p2))
+#endif
+    force_factor += (*pair)(dist2);
+
+  auto const force = force_factor * d;
+#ifdef NPT
+  npt_add_virial_contribution(force, d);
+#endif
+  p1.f.f += force;
+  p2.f.f -= force;
+
+  return true;
+}
+
 /** Compute the bonded interaction force between particle pairs.
  *
  *  @param[in] p1          First particle.
@@ -512,10 +653,141 @@ inline bool add_bonded_force(Particle &p1, int bond_id,
   }
 }
 
-/** Calculate bonded forces for one particle.
- *  @param p particle for which to calculate forces
+/** Add the forces of a group of pair bonds.
+ *  @param bonds       Bonds with one partner.
+ *  @param pair_force  Called with the distance vector, returns the
+ *                     force on the first particle, or none if the
+ *                     bond is broken.
  */
-inline void add_single_particle_force(Particle &p) {
-  cell_structure.execute_bond_handler(p, add_bonded_force);
+template <class PairForce>
+void add_pair_bond_forces(BondLists::Group &bonds, PairForce pair_force) {
+  for (std::size_t i = 0; i < bonds.size(); i++) {
+    auto const bond = bonds[i];
+    auto &p1 = *bond[0];
+    auto &p2 = *bond[1];
+    auto const dx = get_mi_vector(p1.r.p, p2.r.p, box_geo);
+    auto const result = pair_force(dx);
+    if (result) {
+      p1.f.f += result.get();
+      p2.f.f -= result.get();
+#ifdef NPT
+      npt_add_virial_contribution(result.get(), dx);
+#endif
+    } else {
+      BondLists::report_broken_bond(bond);
+    }
+  }
+}
+
+/** Add the forces of a group of bonds with two or three partners.
+ *  @param bonds   Bonds with the same number of partners.
+ *  @param forces  Called with the particles of a bond, returns the
+ *                 forces on the particles, or none if the bond is
+ *                 broken.
+ */
+template <class Forces>
+void add_many_body_bond_forces(BondLists::Group &bonds, Forces forces) {
+  for (std::size_t i = 0; i < bonds.size(); i++) {
+    auto const bond = bonds[i];
+    auto const result = forces(bond);
+    if (result) {
+      for (std::size_t j = 0; j < bond.size(); j++) {
+        bond[j]->f.f += result.get()[j];
+      }
+    } else {
+      BondLists::report_broken_bond(bond);
+    }
+  }
+}
+
+/** Convert the forces of a three-body bond to an array. */
+inline boost::optional<std::array<Utils::Vector3d, 3>>
+three_body_forces(boost::optional<std::tuple<
+                      Utils::Vector3d, Utils::Vector3d, Utils::Vector3d>> const
+                      &forces) {
+  if (not forces)
+    return {};
+  using std::get;
+  return std::array<Utils::Vector3d, 3>{
+      {get<0>(*forces), get<1>(*forces), get<2>(*forces)}};
+}
+
+/** Convert the forces of a four-body bond to an array. */
+inline boost::optional<std::array<Utils::Vector3d, 4>>
+four_body_forces(boost::optional<std::tuple<Utils::Vector3d, Utils::Vector3d,
+                                            Utils::Vector3d, Utils::Vector3d>>
+                     const &forces) {
+  if (not forces)
+    return {};
+  using std::get;
+  return std::array<Utils::Vector3d, 4>{
+      {get<0>(*forces), get<1>(*forces), get<2>(*forces), get<3>(*forces)}};
+}
+
+/** Calculate the bonded forces of all local particles.
+ *
+ *  The common bond types are evaluated by loops specialized
+ *  for the type, all others by @ref add_bonded_force.
+ *
+ *  @param bond_lists  Bonds of the local particles.
+ */
+inline void add_bonded_forces(BondLists &bond_lists) {
+  for (auto &bonds : bond_lists.groups()) {
+    if (bonds.size() == 0)
+      continue;
+
+    auto const &iaparams = bonded_ia_params[bonds.bond_id()];
+    auto const type = (iaparams.num == bonds.n_partners())
+                          ? iaparams.type
+                          : BONDED_IA_NONE;
+
+    switch (type) {
+    case BONDED_IA_FENE:
+      add_pair_bond_forces(bonds, [&iaparams](Utils::Vector3d const &dx) {
+        return fene_pair_force(iaparams, dx);
+      });
+      break;
+    case BONDED_IA_HARMONIC:
+      add_pair_bond_forces(bonds, [&iaparams](Utils::Vector3d const &dx) {
+        return harmonic_pair_force(iaparams, dx);
+      });
+      break;
+    case BONDED_IA_ANGLE_HARMONIC:
+      add_many_body_bond_forces(bonds, [&iaparams](Utils::Span<Particle *> b) {
+        return three_body_forces(
+            angle_harmonic_force(b[0]->r.p, b[1]->r.p, b[2]->r.p, iaparams));
+      });
+      break;
+    case BONDED_IA_ANGLE_COSINE:
+      add_many_body_bond_forces(bonds, [&iaparams](Utils::Span<Particle *> b) {
+        return three_body_forces(
+            angle_cosine_force(b[0]->r.p, b[1]->r.p, b[2]->r.p, iaparams));
+      });
+      break;
+    case BONDED_IA_ANGLE_COSSQUARE:
+      add_many_body_bond_forces(bonds, [&iaparams](Utils::Span<Particle *> b) {
+        return three_body_forces(
+            angle_cossquare_force(b[0]->r.p, b[1]->r.p, b[2]->r.p, iaparams));
+      });
+      break;
+    case BONDED_IA_DIHEDRAL:
+      add_many_body_bond_forces(bonds, [&iaparams](Utils::Span<Particle *> b) {
+        return four_body_forces(dihedral_force(b[1]->r.p, b[0]->r.p, b[2]->r.p,
+                                               b[3]->r.p, iaparams));
+      });
+      break;
+    default:
+      for (std::size_t i = 0; i < bonds.size(); i++) {
+        auto const bond = bonds[i];
+        auto const partners =
+            Utils::Span<Particle *>(bond.data() + 1, bond.size() - 1);
+        if (add_bonded_force(*bond[0], bonds.bond_id(), partners)) {
+          BondLists::report_broken_bond(bond);
+        }
+      }
+    }
+  }
+
+  bond_lists.report_broken_bonds();
 }
 #endif
@@ -40,45 +40,23 @@
 #include <boost/iostreams/device/back_inserter.hpp>
 #include <boost/iostreams/stream.hpp>
 #include <boost/mpi/collectives.hpp>
+#include <boost/mpi/nonblocking.hpp>
 #include <boost/range/numeric.hpp>
 #include <boost/serialization/vector.hpp>
 
 #include <algorithm>
+#include <cassert>
+#include <cstddef>
 #include <vector>
 
 /** Tag for ghosts communications. */
 #define REQ_GHOST_SEND 100
 
-/**
- * Class that stores marshalled data for ghost communications.
- * To store and retrieve data, use the adapter classes below.
- */
-class CommBuf {
-public:
-  /** Returns a pointer to the non-bond storage.
-   */
-  char *data() { return buf.data(); }
-  const char *data() const { return buf.data(); }
-
-  /** Returns the number of elements in the non-bond storage.
-   */
-  size_t size() const { return buf.size(); }
-
-  /** Resizes the underlying storage s.t. the object is capable
-   * of holding "new_size" chars.
-   * @param new_size new size
-   */
-  void resize(size_t new_size) { buf.resize(new_size); }
-
-  /** Returns a reference to the bond storage.
-   */
-  auto &bonds() { return bondbuf; }
-  const auto &bonds() const { return bondbuf; }
-
-private:
-  std::vector<char> buf;     ///< Buffer for everything but bonds
-  std::vector<char> bondbuf; ///< Buffer for bond lists
-};
+/** Check if a transfer includes the variable-size bond lists. */
+static bool transfers_bonds(unsigned int data_parts) {
+  return (data_parts & GHOSTTRANS_BONDS) and
+         not(data_parts & GHOSTTRANS_PARTNUM);
+}
 
 static size_t calc_transmit_size(unsigned data_parts) {
   size_t size = {};
@@ -107,21 +85,35 @@ static size_t calc_transmit_size(const GhostCommunication &ghost_comm,
   return n_part * calc_transmit_size(data_parts);
 }
 
+/**
+ * @brief Serialize the bond lists of the particles to send.
+ *
+ * The bond lists have variable size, so they need a real
+ * archive and are kept in a separate buffer.
+ */
+static void prepare_bond_buffer(CommBuf &send_buffer,
+                                const GhostCommunication &ghost_comm) {
+  namespace io = boost::iostreams;
+  io::stream<io::back_insert_device<std::vector<char>>> os{
+      io::back_inserter(send_buffer.bonds())};
+  boost::archive::binary_oarchive bond_archiver{os};
+
+  for (auto part_list : ghost_comm.part_lists) {
+    for (Particle &part : *part_list) {
+      bond_archiver << part.bonds();
+    }
+  }
+}
+
 static void prepare_send_buffer(CommBuf &send_buffer,
                                 const GhostCommunication &ghost_comm,
                                 unsigned int data_parts) {
-  /* reallocate send buffer */
+  /* reallocate send buffer, this only allocates if it has to grow */
   send_buffer.resize(calc_transmit_size(ghost_comm, data_parts));
   send_buffer.bonds().clear();
 
   auto archiver = Utils::MemcpyOArchive{Utils::make_span(send_buffer)};
 
-  /* Construct archive that pushes back to the bond buffer */
-  namespace io = boost::iostreams;
-  io::stream<io::back_insert_device<std::vector<char>>> os{
-      io::back_inserter(send_buffer.bonds())};
-  boost::archive::binary_oarchive bond_archiver{os};
-
   /* put in data */
   for (auto part_list : ghost_comm.part_lists) {
     if (data_parts & GHOSTTRANS_PARTNUM) {
@@ -144,14 +136,18 @@ static void prepare_send_buffer(CommBuf &send_buffer,
         if (data_parts & GHOSTTRANS_FORCE) {
           archiver << part.f;
         }
-        if (data_parts & GHOSTTRANS_BONDS) {
-          bond_archiver << part.bonds();
-        }
       }
     }
   }
 
   assert(archiver.bytes_written() == send_buffer.size());
+
+  /* Bond lists are only updated together with the particle
+   * properties after a resort, all other transfers are of
+   * fixed size and need no archive. */
+  if (transfers_bonds(data_parts)) {
+    prepare_bond_buffer(send_buffer, ghost_comm);
+  }
 }
 
 static void prepare_ghost_cell(ParticleList *cell, int size) {
@@ -301,9 +297,27 @@ static bool is_poststorable(GhostCommunication const &ghost_comm,
   return is_recv_op(comm_type, node, this_node) && poststore;
 }
 
-void ghost_communicator(const GhostCommunicator &gcr, unsigned int data_parts) {
-  if (GHOSTTRANS_NONE == data_parts)
-    return;
+/**
+ * @brief Check if a communication can be done with non-blocking
+ *        point-to-point messages of known size.
+ */
+static bool is_async_capable(const GhostCommunicator &gcr,
+                             unsigned int data_parts) {
+  if (data_parts & (GHOSTTRANS_PARTNUM | GHOSTTRANS_BONDS))
+    return false;
+
+  return std::all_of(gcr.communications.begin(), gcr.communications.end(),
+                     [](GhostCommunication const &ghost_comm) {
+                       auto const comm_type = ghost_comm.type & GHOST_JOBMASK;
+                       return comm_type == GHOST_SEND or
+                              comm_type == GHOST_RECV or
+                              comm_type == GHOST_LOCL;
+                     });
+}
+
+/** Blocking ghost communication, one communication after the other. */
+static void ghost_communicator_sequential(const GhostCommunicator &gcr,
+                                          unsigned int data_parts) {
 
   static CommBuf send_buffer, recv_buffer;
 
@@ -348,27 +362,35 @@ void ghost_communicator(const GhostCommunicator &gcr, unsigned int data_parts) {
     if (is_recv_op(comm_type, node, comm.rank()))
       prepare_recv_buffer(recv_buffer, ghost_comm, data_parts);
 
+    /* The bond buffer is only transferred if bonds are requested,
+     * which all nodes know from data_parts. */
+    auto const with_bonds = transfers_bonds(data_parts);
+
     /* transfer data */
     // Use two send/recvs in order to avoid having to serialize CommBuf
     // (which consists of already serialized data).
     switch (comm_type) {
     case GHOST_RECV:
       comm.recv(node, REQ_GHOST_SEND, recv_buffer.data(), recv_buffer.size());
-      comm.recv(node, REQ_GHOST_SEND, recv_buffer.bonds());
+      if (with_bonds)
+        comm.recv(node, REQ_GHOST_SEND, recv_buffer.bonds());
       break;
     case GHOST_SEND:
       comm.send(node, REQ_GHOST_SEND, send_buffer.data(), send_buffer.size());
-      comm.send(node, REQ_GHOST_SEND, send_buffer.bonds());
+      if (with_bonds)
+        comm.send(node, REQ_GHOST_SEND, send_buffer.bonds());
       break;
     case GHOST_BCST:
       if (node == comm.rank()) {
         boost::mpi::broadcast(comm, send_buffer.data(), send_buffer.size(),
                               node);
-        boost::mpi::broadcast(comm, send_buffer.bonds(), node);
+        if (with_bonds)
+          boost::mpi::broadcast(comm, send_buffer.bonds(), node);
       } else {
         boost::mpi::broadcast(comm, recv_buffer.data(), recv_buffer.size(),
                               node);
-        boost::mpi::broadcast(comm, recv_buffer.bonds(), node);
+        if (with_bonds)
+          boost::mpi::broadcast(comm, recv_buffer.bonds(), node);
       }
       break;
     case GHOST_RDCE:
@@ -418,3 +440,123 @@ void ghost_communicator(const GhostCommunicator &gcr, unsigned int data_parts) {
     }
   }
 }
+
+void ghost_communicator(const GhostCommunicator &gcr, unsigned int data_parts) {
+  if (GHOSTTRANS_NONE == data_parts)
+    return;
+
+  /* Non-blocking messages allow the exchange with both
+   * neighbors of a dimension to proceed concurrently. */
+  if (is_async_capable(gcr, data_parts)) {
+    static AsyncGhostCommunication async_comm;
+    async_comm.begin(gcr, data_parts);
+    async_comm.wait();
+  } else {
+    ghost_communicator_sequential(gcr, data_parts);
+  }
+}
+
+void AsyncGhostCommunication::begin(const GhostCommunicator &gcr,
+                                    unsigned int data_parts) {
+  wait();
+
+  if (GHOSTTRANS_NONE == data_parts)
+    return;
+
+  if (not is_async_capable(gcr, data_parts)) {
+    ghost_communicator_sequential(gcr, data_parts);
+    return;
+  }
+
+  m_gcr = &gcr;
+  m_data_parts = data_parts;
+  m_next = 0;
+  m_buffers.resize(gcr.communications.size());
+
+  start_communications();
+  finish_if_done();
+}
+
+void AsyncGhostCommunication::progress() {
+  if (not pending())
+    return;
+
+  if (boost::mpi::test_all(m_requests.begin(), m_requests.end())) {
+    m_requests.clear();
+    complete_receives();
+    start_communications();
+    finish_if_done();
+  }
+}
+
+void AsyncGhostCommunication::wait() {
+  while (pending()) {
+    boost::mpi::wait_all(m_requests.begin(), m_requests.end());
+    m_requests.clear();
+    complete_receives();
+    start_communications();
+    finish_if_done();
+  }
+}
+
+/**
+ * Start the communications in order, until one of them
+ * depends on a receive in flight.
+ */
+void AsyncGhostCommunication::start_communications() {
+  auto const &comm = m_gcr->mpi_comm;
+  auto const &communications = m_gcr->communications;
+
+  for (; m_next < communications.size(); ++m_next) {
+    auto const &ghost_comm = communications[m_next];
+    auto const depends_on_receive = std::any_of(
+        ghost_comm.part_lists.begin(), ghost_comm.part_lists.end(),
+        [this](const ParticleList *pl) { return m_targets.count(pl) != 0; });
+    if (depends_on_receive)
+      return;
+
+    auto &buffer = m_buffers[m_next];
+    switch (ghost_comm.type & GHOST_JOBMASK) {
+    case GHOST_LOCL:
+      cell_cell_transfer(ghost_comm, m_data_parts);
+      break;
+    case GHOST_SEND:
+      prepare_send_buffer(buffer, ghost_comm, m_data_parts);
+      m_requests.push_back(comm.isend(ghost_comm.node, REQ_GHOST_SEND,
+                                      buffer.data(), buffer.size()));
+      break;
+    case GHOST_RECV:
+      prepare_recv_buffer(buffer, ghost_comm, m_data_parts);
+      m_requests.push_back(comm.irecv(ghost_comm.node, REQ_GHOST_SEND,
+                                      buffer.data(), buffer.size()));
+      m_receives.push_back(m_next);
+      m_targets.insert(ghost_comm.part_lists.begin(),
+                       ghost_comm.part_lists.end());
+      break;
+    }
+  }
+}
+
+/** Write the data of the completed receives to the particles. */
+void AsyncGhostCommunication::complete_receives() {
+  assert(m_requests.empty());
+
+  for (auto const i : m_receives) {
+    auto const &ghost_comm = m_gcr->communications[i];
+    /* forces have to be added, the rest overwritten */
+    if (m_data_parts == GHOSTTRANS_FORCE)
+      add_forces_from_recv_buffer(m_buffers[i], ghost_comm);
+    else
+      put_recv_buffer(m_buffers[i], ghost_comm, m_data_parts);
+  }
+
+  m_receives.clear();
+  m_targets.clear();
+}
+
+void AsyncGhostCommunication::finish_if_done() {
+  if (m_next == m_gcr->communications.size() and m_requests.empty()) {
+    assert(m_receives.empty());
+    m_gcr = nullptr;
+  }
+}
@@ -86,6 +86,11 @@
 #include "ParticleList.hpp"
 
 #include <boost/mpi/communicator.hpp>
+#include <boost/mpi/request.hpp>
+
+#include <cstddef>
+#include <unordered_set>
+#include <vector>
 
 /** \name Transfer types, for \ref GhostCommunicator::type */
 /************************************************************/
@@ -157,6 +162,94 @@ struct GhostCommunicator {
   std::vector<GhostCommunication> communications;
 };
 
+/**
+ * Class that stores marshalled data for ghost communications.
+ */
+class CommBuf {
+public:
+  /** Returns a pointer to the non-bond storage.
+   */
+  char *data() { return buf.data(); }
+  const char *data() const { return buf.data(); }
+
+  /** Returns the number of elements in the non-bond storage.
+   */
+  size_t size() const { return buf.size(); }
+
+  /** Resizes the underlying storage s.t. the object is capable
+   * of holding "new_size" chars.
+   * @param new_size new size
+   */
+  void resize(size_t new_size) { buf.resize(new_size); }
+
+  /** Returns a reference to the bond storage.
+   */
+  auto &bonds() { return bondbuf; }
+  const auto &bonds() const { return bondbuf; }
+
+private:
+  std::vector<char> buf;     ///< Buffer for everything but bonds
+  std::vector<char> bondbuf; ///< Buffer for bond lists
+};
+
+/**
+ * @brief Ghost communication that proceeds in the background.
+ *
+ * The sends and receives are posted as non-blocking messages in
+ * the order of the communicator, so they are paired in the same
+ * way as in @ref ghost_communicator. A communication that accesses
+ * particle lists written by a receive in flight (e.g. when ghosts
+ * received in one direction are forwarded in the next one) is only
+ * started after the receives in flight are completed. Received
+ * data is only written to the particles in @ref progress and
+ * @ref wait, so the particles can be used by the caller in between,
+ * except for the data parts that are received.
+ *
+ * Only fixed-size data parts on communicators consisting of
+ * @ref GHOST_SEND, @ref GHOST_RECV and @ref GHOST_LOCL are
+ * transferred in the background, otherwise the communication
+ * is completed in @ref begin.
+ */
+class AsyncGhostCommunication {
+public:
+  AsyncGhostCommunication() = default;
+  AsyncGhostCommunication(AsyncGhostCommunication const &) = delete;
+  AsyncGhostCommunication &operator=(AsyncGhostCommunication const &) = delete;
+  ~AsyncGhostCommunication() { wait(); }
+
+  /**
+   * @brief Start a ghost communication.
+   *
+   * A communication that is still in flight is completed first.
+   * @p gcr has to stay valid until the communication is completed.
+   */
+  void begin(const GhostCommunicator &gcr, unsigned int data_parts);
+  /** @brief Advance the communication without blocking. */
+  void progress();
+  /** @brief Complete the communication. */
+  void wait();
+  /** @brief Is there a communication in flight? */
+  bool pending() const { return m_gcr != nullptr; }
+
+private:
+  void start_communications();
+  void complete_receives();
+  void finish_if_done();
+
+  const GhostCommunicator *m_gcr = nullptr;
+  unsigned int m_data_parts = GHOSTTRANS_NONE;
+  /** Index of the next communication to start */
+  std::size_t m_next = 0;
+  /** Buffers, one per communication */
+  std::vector<CommBuf> m_buffers;
+  /** Requests of the messages in flight */
+  std::vector<boost::mpi::request> m_requests;
+  /** Receives in flight */
+  std::vector<std::size_t> m_receives;
+  /** Particle lists written by the receives in flight */
+  std::unordered_set<const ParticleList *> m_targets;
+};
+
 /*@}*/
 
 /** \name Exported Functions */
@@ -157,6 +157,8 @@ const std::unordered_map<int, Datafield> fields{
      {brownian.gamma.data(), 3,
       "brownian.gamma"}}, /* 58  from thermostat.cpp */
 #endif // PARTICLE_ANISOTROPY
+    {FIELD_LONG_RANGE_INTERVAL,
+     {&long_range_interval, 1, "long_range_interval"}}, /* integrate.cpp */
 };
 
 std::size_t hash_value(Datafield const &field) {
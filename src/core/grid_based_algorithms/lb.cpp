@@ -36,11 +36,13 @@
 #include "global.hpp"
 #include "grid.hpp"
 #include "grid_based_algorithms/lb_boundaries.hpp"
+#include "grid_based_algorithms/lb_collide_block.hpp"
 #include "halo.hpp"
 #include "integrate.hpp"
 #include "lb-d3q19.hpp"
 #include "nonbonded_interactions/nonbonded_interaction_data.hpp"
 #include "random.hpp"
+#include "timings.hpp"
 
 #include "utils/u32_to_u64.hpp"
 #include <utils/Counter.hpp>
@@ -57,8 +59,10 @@ using Utils::get_linear_index;
 #include <mpi.h>
 #include <profiler/profiler.hpp>
 
+#include <algorithm>
 #include <cassert>
 #include <cinttypes>
+#include <cstddef>
 #include <iostream>
 
 namespace {
@@ -123,6 +127,7 @@ void lb_on_param_change(LBParam param) {
   case LBParam::GAMMA_ODD:
   case LBParam::GAMMA_EVEN:
   case LBParam::TAU:
+  case LBParam::N_THREADS:
     break;
   }
   lb_reinit_parameters(lbpar);
@@ -161,7 +166,9 @@ LB_Parameters lbpar = {
     // phi
     {},
     // Thermal energy
-    0.0};
+    0.0,
+    // n_threads
+    1};
 
 Lattice lblattice;
 
@@ -783,178 +790,108 @@ std::array<double, 19> lb_calc_modes(Lattice::index_t index,
       LB_Fluid_Ref(index, lb_fluid));
 }
 
-template <typename T>
-inline std::array<T, 19> lb_relax_modes(Lattice::index_t index,
-                                        const std::array<T, 19> &modes,
-                                        const LB_Parameters &lb_parameters) {
-  T density, momentum_density[3], stress_eq[6];
-
-  /* re-construct the real density
-   * remember that the populations are stored as differences to their
-   * equilibrium value */
-  density = modes[0] + lb_parameters.density;
-
-  momentum_density[0] = modes[1] + 0.5 * lbfields[index].force_density[0];
-  momentum_density[1] = modes[2] + 0.5 * lbfields[index].force_density[1];
-  momentum_density[2] = modes[3] + 0.5 * lbfields[index].force_density[2];
+/**
+ * @brief Draw the random numbers for the thermalization of a node.
+ *
+ * The random numbers only depend on the index of the node and the
+ * state of @ref rng_counter_fluid.
+ */
+static void lb_draw_noise(Lattice::index_t index, LB_NodeBlock &block,
+                          std::size_t j) {
+  using rng_type = r123::Philox4x64;
+  using ctr_type = rng_type::ctr_type;
+
+  const ctr_type c{
+      {rng_counter_fluid->value(), static_cast<uint64_t>(RNGSalt::FLUID)}};
+
+  for (uint64_t k = 0; k < 4; k++) {
+    auto const noise = rng_type{}(c, {{static_cast<uint64_t>(index), k}});
+    for (std::size_t i = 0; i < 4 and 4 * k + i < 15; i++) {
+      block.noise[4 * k + i][j] = Utils::uniform(noise[i]);
+    }
+  }
+}
 
-  using Utils::sqr;
-  auto const momentum_density2 = sqr(momentum_density[0]) +
-                                 sqr(momentum_density[1]) +
-                                 sqr(momentum_density[2]);
+/**
+ * @brief Collide a block of consecutive nodes of a lattice row
+ *        and stream the populations (push scheme).
+ *
+ * Boundary nodes are skipped.
+ *
+ * @param first Index of the first node.
+ * @param n_nodes Number of nodes.
+ */
+static void lb_collide_stream_block(Lattice::index_t first,
+                                    std::size_t n_nodes) {
+  LB_NodeBlock block;
+  bool fluid[lb_block_size];
+  bool all_fluid = true;
 
-  /* equilibrium part of the stress modes */
-  stress_eq[0] = momentum_density2 / density;
-  stress_eq[1] =
-      (sqr(momentum_density[0]) - sqr(momentum_density[1])) / density;
-  stress_eq[2] = (momentum_density2 - 3.0 * sqr(momentum_density[2])) / density;
-  stress_eq[3] = momentum_density[0] * momentum_density[1] / density;
-  stress_eq[4] = momentum_density[0] * momentum_density[2] / density;
-  stress_eq[5] = momentum_density[1] * momentum_density[2] / density;
-
-  return {
-      {modes[0], modes[1], modes[2], modes[3],
-       /* relax the stress modes */
-       stress_eq[0] + lb_parameters.gamma_bulk * (modes[4] - stress_eq[0]),
-       stress_eq[1] + lb_parameters.gamma_shear * (modes[5] - stress_eq[1]),
-       stress_eq[2] + lb_parameters.gamma_shear * (modes[6] - stress_eq[2]),
-       stress_eq[3] + lb_parameters.gamma_shear * (modes[7] - stress_eq[3]),
-       stress_eq[4] + lb_parameters.gamma_shear * (modes[8] - stress_eq[4]),
-       stress_eq[5] + lb_parameters.gamma_shear * (modes[9] - stress_eq[5]),
-       /* relax the ghost modes (project them out) */
-       /* ghost modes have no equilibrium part due to orthogonality */
-       lb_parameters.gamma_odd * modes[10], lb_parameters.gamma_odd * modes[11],
-       lb_parameters.gamma_odd * modes[12], lb_parameters.gamma_odd * modes[13],
-       lb_parameters.gamma_odd * modes[14], lb_parameters.gamma_odd * modes[15],
-       lb_parameters.gamma_even * modes[16],
-       lb_parameters.gamma_even * modes[17],
-       lb_parameters.gamma_even * modes[18]}};
-}
+  for (std::size_t j = 0; j < n_nodes; j++) {
+#ifdef LB_BOUNDARIES
+    fluid[j] = not lbfields[first + j].boundary;
+#else
+    fluid[j] = true;
+#endif
+    all_fluid &= fluid[j];
+  }
 
-template <typename T>
-inline std::array<T, 19>
-lb_thermalize_modes(Lattice::index_t index, const std::array<T, 19> &modes,
-                    const LB_Parameters &lb_parameters,
-                    boost::optional<Utils::Counter<uint64_t>> rng_counter) {
-  if (lb_parameters.kT > 0.0) {
-    using Utils::uniform;
-    using rng_type = r123::Philox4x64;
-    using ctr_type = rng_type::ctr_type;
-
-    const r123::Philox4x64::ctr_type c{
-        {rng_counter->value(), static_cast<uint64_t>(RNGSalt::FLUID)}};
-    const T rootdensity =
-        std::sqrt(std::fabs(modes[0] + lb_parameters.density));
-    auto const pref = std::sqrt(12.) * rootdensity;
-
-    const ctr_type noise[4] = {
-        rng_type{}(c, {{static_cast<uint64_t>(index), 0ul}}),
-        rng_type{}(c, {{static_cast<uint64_t>(index), 1ul}}),
-        rng_type{}(c, {{static_cast<uint64_t>(index), 2ul}}),
-        rng_type{}(c, {{static_cast<uint64_t>(index), 3ul}})};
-
-    auto rng = [&](int i) { return uniform(noise[i / 4][i % 4]); };
-
-    return {/* conserved modes */
-            {modes[0], modes[1], modes[2], modes[3],
-             /* stress modes */
-             modes[4] + pref * lb_parameters.phi[4] * rng(0),
-             modes[5] + pref * lb_parameters.phi[5] * rng(1),
-             modes[6] + pref * lb_parameters.phi[6] * rng(2),
-             modes[7] + pref * lb_parameters.phi[7] * rng(3),
-             modes[8] + pref * lb_parameters.phi[8] * rng(4),
-             modes[9] + pref * lb_parameters.phi[9] * rng(5),
-
-             /* ghost modes */
-             modes[10] + pref * lb_parameters.phi[10] * rng(6),
-             modes[11] + pref * lb_parameters.phi[11] * rng(7),
-             modes[12] + pref * lb_parameters.phi[12] * rng(8),
-             modes[13] + pref * lb_parameters.phi[13] * rng(9),
-             modes[14] + pref * lb_parameters.phi[14] * rng(10),
-             modes[15] + pref * lb_parameters.phi[15] * rng(11),
-             modes[16] + pref * lb_parameters.phi[16] * rng(12),
-             modes[17] + pref * lb_parameters.phi[17] * rng(13),
-             modes[18] + pref * lb_parameters.phi[18] * rng(14)}};
+  for (int i = 0; i < 19; i++) {
+    auto const n = lbfluid[i].data() + first;
+    for (std::size_t j = 0; j < n_nodes; j++) {
+      block.n[i][j] = n[j];
+    }
   }
-  return modes;
-}
 
-template <typename T>
-std::array<T, 19> lb_apply_forces(Lattice::index_t index,
-                                  const std::array<T, 19> &modes,
-                                  const LB_Parameters &lb_parameters,
-                                  const std::vector<LB_FluidNode> &lb_fields) {
-  const auto &f = lb_fields[index].force_density;
-
-  auto const density = modes[0] + lb_parameters.density;
-
-  /* hydrodynamic momentum density is redefined when external forces present */
-  auto const u = Utils::Vector3d{modes[1] + 0.5 * f[0], modes[2] + 0.5 * f[1],
-                                 modes[3] + 0.5 * f[2]} /
-                 density;
-
-  double C[6];
-  C[0] = (1. + lb_parameters.gamma_bulk) * u[0] * f[0] +
-         1. / 3. * (lb_parameters.gamma_bulk - lb_parameters.gamma_shear) *
-             (u * f);
-  C[2] = (1. + lb_parameters.gamma_bulk) * u[1] * f[1] +
-         1. / 3. * (lb_parameters.gamma_bulk - lb_parameters.gamma_shear) *
-             (u * f);
-  C[5] = (1. + lb_parameters.gamma_bulk) * u[2] * f[2] +
-         1. / 3. * (lb_parameters.gamma_bulk - lb_parameters.gamma_shear) *
-             (u * f);
-  C[1] =
-      1. / 2. * (1. + lb_parameters.gamma_shear) * (u[0] * f[1] + u[1] * f[0]);
-  C[3] =
-      1. / 2. * (1. + lb_parameters.gamma_shear) * (u[0] * f[2] + u[2] * f[0]);
-  C[4] =
-      1. / 2. * (1. + lb_parameters.gamma_shear) * (u[1] * f[2] + u[2] * f[1]);
-
-  return {{modes[0],
-           /* update momentum modes */
-           modes[1] + f[0], modes[2] + f[1], modes[3] + f[2],
-           /* update stress modes */
-           modes[4] + C[0] + C[2] + C[5], modes[5] + C[0] - C[2],
-           modes[6] + C[0] + C[2] - 2. * C[5], modes[7] + C[1], modes[8] + C[3],
-           modes[9] + C[4], modes[10], modes[11], modes[12], modes[13],
-           modes[14], modes[15], modes[16], modes[17], modes[18]}};
-}
+  for (std::size_t j = 0; j < n_nodes; j++) {
+    auto &node = lbfields[first + j];
+    for (int c = 0; c < 3; c++) {
+      block.force_density[c][j] = node.force_density[c];
+    }
+    if (fluid[j]) {
+#ifdef VIRTUAL_SITES_INERTIALESS_TRACERS
+      // Safeguard the node forces so that we can later use them for the IBM
+      // particle update
+      node.force_density_buf = node.force_density;
+#endif
+      /* reset the force density */
+      node.force_density = lbpar.ext_force_density;
+    }
+  }
 
-template <typename T>
-std::array<T, 19> normalize_modes(const std::array<T, 19> &modes) {
-  auto normalized_modes = modes;
-  for (int i = 0; i < modes.size(); i++) {
-    normalized_modes[i] /= D3Q19::w_k[i];
+  if (lbpar.kT > 0.0) {
+    for (std::size_t j = 0; j < n_nodes; j++) {
+      lb_draw_noise(first + j, block, j);
+    }
   }
-  return normalized_modes;
-}
 
-template <typename T>
-std::array<T, 19> lb_calc_n_from_m(const std::array<T, 19> &modes) {
-  auto ret = Utils::matrix_vector_product<T, 19, e_ki_transposed>(
-      normalize_modes(modes));
-  std::transform(ret.begin(), ret.end(), ::D3Q19::w.begin(), ret.begin(),
-                 std::multiplies<T>());
-  return ret;
-}
+  lb_collide_block(block, n_nodes, lbpar);
 
-template <typename T>
-inline void lb_stream(LB_Fluid &lbfluid, Lattice::index_t index,
-                      const std::array<T, 19> &populations,
-                      const Lattice &lb_lattice) {
+  /* streaming */
   const std::array<int, 3> period = {
-      {1, lb_lattice.halo_grid[0],
-       lb_lattice.halo_grid[0] * lb_lattice.halo_grid[1]}};
-
-  for (int i = 0; i < populations.size(); i++) {
-    auto const next = index + boost::inner_product(period, D3Q19::c[i], 0);
-    lbfluid[i][next] = populations[i];
+      {1, lblattice.halo_grid[0],
+       lblattice.halo_grid[0] * lblattice.halo_grid[1]}};
+
+  for (int i = 0; i < 19; i++) {
+    auto const offset = boost::inner_product(period, D3Q19::c[i], 0);
+    auto const n = lbfluid_post[i].data() + first + offset;
+    if (all_fluid) {
+      for (std::size_t j = 0; j < n_nodes; j++) {
+        n[j] = block.n[i][j];
+      }
+    } else {
+      for (std::size_t j = 0; j < n_nodes; j++) {
+        if (fluid[j])
+          n[j] = block.n[i][j];
+      }
+    }
   }
 }
 
 /* Collisions and streaming (push scheme) */
 inline void lb_collide_stream() {
   ESPRESSO_PROFILER_CXX_MARK_FUNCTION;
+  Timings::ScopedTimer timer(Timings::Section::LB_COLLIDE_STREAM);
   /* loop over all lattice cells (halo excluded) */
 #ifdef LB_BOUNDARIES
   for (auto &lbboundary : LBBoundaries::lbboundaries) {
@@ -962,50 +899,24 @@ inline void lb_collide_stream() {
   }
 #endif // LB_BOUNDARIES
 
-  Lattice::index_t index = lblattice.halo_offset;
+  /* The rows are processed in blocks of consecutive nodes, whose
+   * data fits into the L1 cache. The z-slabs are distributed over
+   * the threads: with the push scheme every population is written
+   * by exactly one node, and the random numbers of a node only
+   * depend on its index, so the result does not depend on the
+   * number of threads. */
+  auto const row_length = static_cast<std::size_t>(lblattice.grid[0]);
+#ifdef OPENMP
+#pragma omp parallel for schedule(static) num_threads(lbpar.n_threads)
+#endif
   for (int z = 1; z <= lblattice.grid[2]; z++) {
     for (int y = 1; y <= lblattice.grid[1]; y++) {
-      for (int x = 1; x <= lblattice.grid[0]; x++) {
-        // as we only want to apply this to non-boundary nodes we can throw out
-        // the if-clause if we have a non-bounded domain
-#ifdef LB_BOUNDARIES
-        if (!lbfields[index].boundary)
-#endif // LB_BOUNDARIES
-        {
-          /* calculate modes locally */
-          auto const modes = lb_calc_modes(index, lbfluid);
-
-          /* deterministic collisions */
-          auto const relaxed_modes = lb_relax_modes(index, modes, lbpar);
-
-          /* fluctuating hydrodynamics */
-          auto const thermalized_modes = lb_thermalize_modes(
-              index, relaxed_modes, lbpar, rng_counter_fluid);
-
-          /* apply forces */
-          auto const modes_with_forces =
-              lb_apply_forces(index, thermalized_modes, lbpar, lbfields);
-
-#ifdef VIRTUAL_SITES_INERTIALESS_TRACERS
-          // Safeguard the node forces so that we can later use them for the IBM
-          // particle update
-          lbfields[index].force_density_buf = lbfields[index].force_density;
-#endif
-
-          /* reset the force density */
-          lbfields[index].force_density = lbpar.ext_force_density;
-
-          auto const populations = lb_calc_n_from_m(modes_with_forces);
-
-          /* transform back to populations and streaming */
-          lb_stream(lbfluid_post, index, populations, lblattice);
-        }
-
-        ++index; /* next node */
+      auto const row = get_linear_index(1, y, z, lblattice.halo_grid);
+      for (std::size_t x = 0; x < row_length; x += lb_block_size) {
+        lb_collide_stream_block(row + x,
+                                std::min(lb_block_size, row_length - x));
       }
-      index += 2; /* skip halo region */
     }
-    index += 2 * lblattice.halo_grid[0]; /* skip halo region */
   }
 
   /* exchange halo regions */
@@ -121,9 +121,14 @@ struct LB_Parameters {
   /** Thermal energy */
   double kT;
 
+  /** Number of threads per MPI rank for the fluid update and the
+   *  particle coupling */
+  int n_threads;
+
   template <class Archive> void serialize(Archive &ar, long int) {
     ar &density &viscosity &bulk_viscosity &agrid &tau &ext_force_density
-        &gamma_odd &gamma_even &gamma_shear &gamma_bulk &is_TRT &phi &kT;
+        &gamma_odd &gamma_even &gamma_shear &gamma_bulk &is_TRT &phi &kT
+            &n_threads;
   }
 };
 
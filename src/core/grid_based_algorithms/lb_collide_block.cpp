@@ -0,0 +1,259 @@
+/*
+ * Copyright (C) 2020 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+/** \file
+ *
+ *  Implementation of \ref lb_collide_block.hpp
+ */
+#include "grid_based_algorithms/lb_collide_block.hpp"
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+
+/* Runtime selection of the instruction set via function multi-versioning,
+ * see batched_pair_kernel.cpp. */
+#if defined(__GNUC__) && !defined(__clang__) && !defined(__INTEL_COMPILER) && \
+    defined(__x86_64__) && defined(__linux__)
+#define LB_COLLIDE_BLOCK_TARGETS                                               \
+  __attribute__((target_clones("avx512f", "avx2", "default")))
+#else
+#define LB_COLLIDE_BLOCK_TARGETS
+#endif
+
+namespace {
+/** @brief Parameters of the collision, in the form used by the kernel. */
+struct Relaxation {
+  double density;
+  double gamma_bulk, gamma_shear, gamma_odd, gamma_even;
+  /** Amplitudes of the noise of the modes 4 to 18, including the
+   *  normalization of the uniform random numbers */
+  double noise_amplitude[15];
+};
+
+template <bool thermalized>
+inline void collide(LB_NodeBlock &b, std::size_t n_nodes,
+                    Relaxation const &p) {
+  for (std::size_t j = 0; j < n_nodes; j++) {
+    /* Sums and differences of the populations of opposite velocities */
+    auto const p12 = b.n[1][j] + b.n[2][j], d12 = b.n[1][j] - b.n[2][j];
+    auto const p34 = b.n[3][j] + b.n[4][j], d34 = b.n[3][j] - b.n[4][j];
+    auto const p56 = b.n[5][j] + b.n[6][j], d56 = b.n[5][j] - b.n[6][j];
+    auto const p78 = b.n[7][j] + b.n[8][j], d78 = b.n[7][j] - b.n[8][j];
+    auto const p910 = b.n[9][j] + b.n[10][j], d910 = b.n[9][j] - b.n[10][j];
+    auto const p1112 = b.n[11][j] + b.n[12][j];
+    auto const d1112 = b.n[11][j] - b.n[12][j];
+    auto const p1314 = b.n[13][j] + b.n[14][j];
+    auto const d1314 = b.n[13][j] - b.n[14][j];
+    auto const p1516 = b.n[15][j] + b.n[16][j];
+    auto const d1516 = b.n[15][j] - b.n[16][j];
+    auto const p1718 = b.n[17][j] + b.n[18][j];
+    auto const d1718 = b.n[17][j] - b.n[18][j];
+
+    auto const q1 = p12 + p34 + p56;
+    auto const q2 = p78 + p910 + p1112 + p1314 + p1516 + p1718;
+
+    /* Modes, m_k = sum_i e_ki n_i */
+    double m[19];
+    m[0] = b.n[0][j] + q1 + q2;
+    m[1] = d12 + d78 + d910 + d1112 + d1314;
+    m[2] = d34 + d78 - d910 + d1516 + d1718;
+    m[3] = d56 + d1112 - d1314 + d1516 - d1718;
+    m[4] = -b.n[0][j] + q2;
+    m[5] = p12 - p34 + p1112 + p1314 - p1516 - p1718;
+    m[6] = p12 + p34 - p1112 - p1314 - p1516 - p1718 - 2. * (p56 - p78 - p910);
+    m[7] = p78 - p910;
+    m[8] = p1112 - p1314;
+    m[9] = p1516 - p1718;
+    m[10] = -2. * d12 + d78 + d910 + d1112 + d1314;
+    m[11] = -2. * d34 + d78 - d910 + d1516 + d1718;
+    m[12] = -2. * d56 + d1112 - d1314 + d1516 - d1718;
+    m[13] = d78 + d910 - d1112 - d1314;
+    m[14] = d78 - d910 - d1516 - d1718;
+    m[15] = d1112 - d1314 - d1516 + d1718;
+    m[16] = b.n[0][j] + q2 - 2. * q1;
+    m[17] = -p12 + p34 + p1112 + p1314 - p1516 - p1718;
+    m[18] = -p12 - p34 - p1112 - p1314 - p1516 - p1718 +
+            2. * (p56 + p78 + p910);
+
+    /* The populations are stored as differences to the equilibrium
+     * populations of the average density. */
+    auto const density = m[0] + p.density;
+    auto const fx = b.force_density[0][j];
+    auto const fy = b.force_density[1][j];
+    auto const fz = b.force_density[2][j];
+    auto const jx = m[1] + 0.5 * fx;
+    auto const jy = m[2] + 0.5 * fy;
+    auto const jz = m[3] + 0.5 * fz;
+
+    /* Relaxation of the stress modes towards equilibrium */
+    auto const jx2 = jx * jx, jy2 = jy * jy, jz2 = jz * jz;
+    auto const j2 = jx2 + jy2 + jz2;
+    auto const stress_eq0 = j2 / density;
+    auto const stress_eq1 = (jx2 - jy2) / density;
+    auto const stress_eq2 = (j2 - 3.0 * jz2) / density;
+    auto const stress_eq3 = jx * jy / density;
+    auto const stress_eq4 = jx * jz / density;
+    auto const stress_eq5 = jy * jz / density;
+
+    m[4] = stress_eq0 + p.gamma_bulk * (m[4] - stress_eq0);
+    m[5] = stress_eq1 + p.gamma_shear * (m[5] - stress_eq1);
+    m[6] = stress_eq2 + p.gamma_shear * (m[6] - stress_eq2);
+    m[7] = stress_eq3 + p.gamma_shear * (m[7] - stress_eq3);
+    m[8] = stress_eq4 + p.gamma_shear * (m[8] - stress_eq4);
+    m[9] = stress_eq5 + p.gamma_shear * (m[9] - stress_eq5);
+
+    /* Relaxation of the ghost modes, which have no equilibrium part */
+    for (int k = 10; k < 16; k++) {
+      m[k] *= p.gamma_odd;
+    }
+    for (int k = 16; k < 19; k++) {
+      m[k] *= p.gamma_even;
+    }
+
+    /* Fluctuating hydrodynamics */
+    if (thermalized) {
+      auto const root_density = std::sqrt(std::fabs(density));
+      for (int k = 4; k < 19; k++) {
+        m[k] += root_density * p.noise_amplitude[k - 4] * b.noise[k - 4][j];
+      }
+    }
+
+    /* Forces */
+    auto const ux = jx / density, uy = jy / density, uz = jz / density;
+    auto const uf = ux * fx + uy * fy + uz * fz;
+    auto const trace_part = 1. / 3. * (p.gamma_bulk - p.gamma_shear) * uf;
+    auto const C0 = (1. + p.gamma_bulk) * ux * fx + trace_part;
+    auto const C2 = (1. + p.gamma_bulk) * uy * fy + trace_part;
+    auto const C5 = (1. + p.gamma_bulk) * uz * fz + trace_part;
+    auto const C1 = 0.5 * (1. + p.gamma_shear) * (ux * fy + uy * fx);
+    auto const C3 = 0.5 * (1. + p.gamma_shear) * (ux * fz + uz * fx);
+    auto const C4 = 0.5 * (1. + p.gamma_shear) * (uy * fz + uz * fy);
+
+    m[1] += fx;
+    m[2] += fy;
+    m[3] += fz;
+    m[4] += C0 + C2 + C5;
+    m[5] += C0 - C2;
+    m[6] += C0 + C2 - 2. * C5;
+    m[7] += C1;
+    m[8] += C3;
+    m[9] += C4;
+
+    /* Normalization of the modes, 1 / w_k */
+    m[1] *= 3.;
+    m[2] *= 3.;
+    m[3] *= 3.;
+    m[4] *= 3. / 2.;
+    m[5] *= 9. / 4.;
+    m[6] *= 3. / 4.;
+    m[7] *= 9.;
+    m[8] *= 9.;
+    m[9] *= 9.;
+    m[10] *= 3. / 2.;
+    m[11] *= 3. / 2.;
+    m[12] *= 3. / 2.;
+    m[13] *= 9. / 2.;
+    m[14] *= 9. / 2.;
+    m[15] *= 9. / 2.;
+    m[16] *= 1. / 2.;
+    m[17] *= 9. / 4.;
+    m[18] *= 3. / 4.;
+
+    /* Back-transformation, n_i = w_i sum_k e_ki m_k */
+    b.n[0][j] = 1. / 3. * (m[0] - m[4] + m[16]);
+    b.n[1][j] = 1. / 18. *
+                (m[0] + m[1] + m[5] + m[6] - m[17] - m[18] -
+                 2. * (m[10] + m[16]));
+    b.n[2][j] = 1. / 18. *
+                (m[0] - m[1] + m[5] + m[6] - m[17] - m[18] +
+                 2. * (m[10] - m[16]));
+    b.n[3][j] = 1. / 18. *
+                (m[0] + m[2] - m[5] + m[6] + m[17] - m[18] -
+                 2. * (m[11] + m[16]));
+    b.n[4][j] = 1. / 18. *
+                (m[0] - m[2] - m[5] + m[6] + m[17] - m[18] +
+                 2. * (m[11] - m[16]));
+    b.n[5][j] = 1. / 18. * (m[0] + m[3] - 2. * (m[6] + m[12] + m[16] - m[18]));
+    b.n[6][j] = 1. / 18. * (m[0] - m[3] - 2. * (m[6] - m[12] + m[16] - m[18]));
+
+    auto const e_xy = m[0] + m[4] + 2. * m[6] + m[16] + 2. * m[18];
+    b.n[7][j] = 1. / 36. * (e_xy + m[1] + m[2] + m[7] + m[10] + m[11] +
+                            m[13] + m[14]);
+    b.n[8][j] = 1. / 36. * (e_xy - m[1] - m[2] + m[7] - m[10] - m[11] -
+                            m[13] - m[14]);
+    b.n[9][j] = 1. / 36. * (e_xy + m[1] - m[2] - m[7] + m[10] - m[11] +
+                            m[13] - m[14]);
+    b.n[10][j] = 1. / 36. * (e_xy - m[1] + m[2] - m[7] - m[10] + m[11] -
+                             m[13] + m[14]);
+
+    auto const e_xz = m[0] + m[4] + m[5] - m[6] + m[16] + m[17] - m[18];
+    b.n[11][j] = 1. / 36. * (e_xz + m[1] + m[3] + m[8] + m[10] + m[12] -
+                             m[13] + m[15]);
+    b.n[12][j] = 1. / 36. * (e_xz - m[1] - m[3] + m[8] - m[10] - m[12] +
+                             m[13] - m[15]);
+    b.n[13][j] = 1. / 36. * (e_xz + m[1] - m[3] - m[8] + m[10] - m[12] -
+                             m[13] - m[15]);
+    b.n[14][j] = 1. / 36. * (e_xz - m[1] + m[3] - m[8] - m[10] + m[12] +
+                             m[13] + m[15]);
+
+    auto const e_yz = m[0] + m[4] - m[5] - m[6] + m[16] - m[17] - m[18];
+    b.n[15][j] = 1. / 36. * (e_yz + m[2] + m[3] + m[9] + m[11] + m[12] -
+                             m[14] - m[15]);
+    b.n[16][j] = 1. / 36. * (e_yz - m[2] - m[3] + m[9] - m[11] - m[12] +
+                             m[14] + m[15]);
+    b.n[17][j] = 1. / 36. * (e_yz + m[2] - m[3] - m[9] + m[11] - m[12] -
+                             m[14] + m[15]);
+    b.n[18][j] = 1. / 36. * (e_yz - m[2] + m[3] - m[9] - m[11] + m[12] +
+                             m[14] - m[15]);
+  }
+}
+
+LB_COLLIDE_BLOCK_TARGETS
+void collide_athermal(LB_NodeBlock &block, std::size_t n_nodes,
+                      Relaxation const &p) {
+  collide<false>(block, n_nodes, p);
+}
+
+LB_COLLIDE_BLOCK_TARGETS
+void collide_thermalized(LB_NodeBlock &block, std::size_t n_nodes,
+                         Relaxation const &p) {
+  collide<true>(block, n_nodes, p);
+}
+} // namespace
+
+void lb_collide_block(LB_NodeBlock &block, std::size_t n_nodes,
+                      LB_Parameters const &lb_parameters) {
+  assert(n_nodes <= lb_block_size);
+
+  Relaxation p;
+  p.density = lb_parameters.density;
+  p.gamma_bulk = lb_parameters.gamma_bulk;
+  p.gamma_shear = lb_parameters.gamma_shear;
+  p.gamma_odd = lb_parameters.gamma_odd;
+  p.gamma_even = lb_parameters.gamma_even;
+  for (int k = 4; k < 19; k++) {
+    p.noise_amplitude[k - 4] = std::sqrt(12.) * lb_parameters.phi[k];
+  }
+
+  if (lb_parameters.kT > 0.0) {
+    collide_thermalized(block, n_nodes, p);
+  } else {
+    collide_athermal(block, n_nodes, p);
+  }
+}
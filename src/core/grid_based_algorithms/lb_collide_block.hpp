@@ -0,0 +1,70 @@
+/*
+ * Copyright (C) 2020 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef CORE_LB_COLLIDE_BLOCK_HPP
+#define CORE_LB_COLLIDE_BLOCK_HPP
+/** \file
+ *  Collision step of the CPU lattice-Boltzmann algorithm for
+ *  blocks of consecutive nodes of a lattice row.
+ *
+ *  The data of the nodes of a block is stored with one array per
+ *  component, and the transformation into mode space, the relaxation,
+ *  the thermalization, the forcing and the back-transformation are
+ *  fused into one branch-free loop over the nodes, so that the
+ *  compiler can vectorize it. On x86-64 the kernel is compiled for
+ *  AVX-512, AVX2 and the baseline instruction set, and the variant
+ *  is selected at runtime according to the capabilities of the CPU.
+ *
+ *  Implementation in lb_collide_block.cpp.
+ */
+
+#include "grid_based_algorithms/lb.hpp"
+
+#include <cstddef>
+
+/** Number of consecutive nodes processed together */
+constexpr std::size_t lb_block_size = 16;
+
+/** @brief Data of a block of nodes, one array per component. */
+struct LB_NodeBlock {
+  /** Populations, replaced by the post-collision populations */
+  double n[19][lb_block_size];
+  /** Force densities */
+  double force_density[3][lb_block_size];
+  /** Uniform random numbers in [-0.5, 0.5) for the modes 4 to 18,
+   *  only used if the fluid is thermalized */
+  double noise[15][lb_block_size];
+};
+
+/**
+ * @brief Collide the populations of a block of nodes.
+ *
+ * Same result as the transformation of the populations into mode
+ * space, the relaxation of the modes towards equilibrium, the
+ * thermalization (if lb_parameters.kT > 0), the application of the
+ * force densities and the back-transformation into populations, as
+ * described in @cite dunweg07a.
+ *
+ * @param block Data of the nodes.
+ * @param n_nodes Number of nodes in @p block, at most @ref lb_block_size.
+ * @param lb_parameters Parameters of the fluid.
+ */
+void lb_collide_block(LB_NodeBlock &block, std::size_t n_nodes,
+                      LB_Parameters const &lb_parameters);
+
+#endif
@@ -489,6 +489,24 @@ double lb_lbfluid_get_kT() {
   throw NoLBActive();
 }
 
+void lb_lbfluid_set_n_threads(int n_threads) {
+  if (n_threads < 1)
+    throw std::invalid_argument("n_threads has to be >= 1.");
+  if (lattice_switch == ActiveLB::CPU) {
+    lbpar.n_threads = n_threads;
+    mpi_bcast_lb_params(LBParam::N_THREADS);
+  } else {
+    throw NoLBActive();
+  }
+}
+
+int lb_lbfluid_get_n_threads() {
+  if (lattice_switch == ActiveLB::CPU) {
+    return lbpar.n_threads;
+  }
+  throw NoLBActive();
+}
+
 double lb_lbfluid_get_lattice_speed() {
   return lb_lbfluid_get_agrid() / lb_lbfluid_get_tau();
 }
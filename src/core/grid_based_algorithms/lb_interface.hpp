@@ -129,6 +129,11 @@ void lb_lbfluid_set_ext_force_density(const Utils::Vector3d &force_density);
  */
 void lb_lbfluid_set_kT(double kT);
 
+/**
+ * @brief Set the number of threads per MPI rank of the CPU LB.
+ */
+void lb_lbfluid_set_n_threads(int n_threads);
+
 /**
  * @brief Perform LB parameter and boundary velocity checks.
  */
@@ -190,6 +195,11 @@ const Utils::Vector3d lb_lbfluid_get_ext_force_density();
  */
 double lb_lbfluid_get_kT();
 
+/**
+ * @brief Get the number of threads per MPI rank of the CPU LB.
+ */
+int lb_lbfluid_get_n_threads();
+
 /**
  * @brief Get the lattice speed (agrid/tau).
  */
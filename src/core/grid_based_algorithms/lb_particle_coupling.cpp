@@ -30,6 +30,7 @@
 #include "lbgpu.hpp"
 #include "particle_data.hpp"
 #include "random.hpp"
+#include "timings.hpp"
 
 #include <profiler/profiler.hpp>
 #include <utils/Counter.hpp>
@@ -39,6 +40,10 @@
 #include <Random123/philox.h>
 #include <boost/mpi.hpp>
 
+#include <cstddef>
+#include <exception>
+#include <vector>
+
 LB_Particle_Coupling lb_particle_coupling;
 
 void mpi_bcast_lb_particle_coupling_slave() {
@@ -128,7 +133,9 @@ void add_md_force(Utils::Vector3d const &pos, Utils::Vector3d const &force) {
 }
 } // namespace
 
-/** Coupling of a single particle to viscous fluid with Stokesian friction.
+/** Coupling force of a single particle to viscous fluid with Stokesian
+ *  friction. Only reads the populations, the force is not added to
+ *  the lattice.
  *
  *  Section II.C. @cite ahlrichs99a
  *
@@ -137,8 +144,8 @@ void add_md_force(Utils::Vector3d const &pos, Utils::Vector3d const &force) {
  *
  *  @return The viscous coupling force plus f_random.
  */
-Utils::Vector3d lb_viscous_coupling(Particle const &p,
-                                    Utils::Vector3d const &f_random) {
+Utils::Vector3d lb_viscous_coupling_force(Particle const &p,
+                                          Utils::Vector3d const &f_random) {
   /* calculate fluid velocity at particle's position
      this is done by linear interpolation (eq. (11) @cite ahlrichs99a) */
   auto const interpolated_u =
@@ -157,11 +164,7 @@ Utils::Vector3d lb_viscous_coupling(Particle const &p,
 #endif
 
   /* calculate viscous force (eq. (9) @cite ahlrichs99a) */
-  auto const force = -lb_lbcoupling_get_gamma() * (p.m.v - v_drift) + f_random;
-
-  add_md_force(p.r.p, force);
-
-  return force;
+  return -lb_lbcoupling_get_gamma() * (p.m.v - v_drift) + f_random;
 }
 
 namespace {
@@ -243,6 +246,7 @@ void lb_lbcoupling_calc_particle_lattice_ia(
     bool couple_virtual, const ParticleRange &particles,
     const ParticleRange &more_particles) {
   ESPRESSO_PROFILER_CXX_MARK_FUNCTION;
+  Timings::ScopedTimer timer(Timings::Section::LB_COUPLING);
   if (lattice_switch == ActiveLB::GPU) {
 #ifdef CUDA
     if (lb_particle_coupling.couple_to_md && this_node == 0) {
@@ -284,36 +288,61 @@ void lb_lbcoupling_calc_particle_lattice_ia(
           return {};
         };
 
-        auto couple_particle = [&](Particle &p) -> void {
-          if (p.p.is_virtual and !couple_virtual)
-            return;
+        std::vector<Particle *> coupled;
+        for (auto range : {&particles, &more_particles}) {
+          for (auto &p : *range) {
+            if (p.p.is_virtual and !couple_virtual)
+              continue;
+            coupled.push_back(&p);
+          }
+        }
+
+        /* The coupling forces only read the populations, so they
+         * can be calculated in parallel. Particles in the local
+         * domain or in the halo add to the force density in our
+         * domain. */
+        std::vector<Utils::Vector3d> forces(coupled.size());
+        std::exception_ptr error;
+        auto const n_coupled = static_cast<long>(coupled.size());
+#ifdef OPENMP
+        auto const n_threads = lb_lbfluid_get_n_threads();
+#pragma omp parallel for schedule(static) num_threads(n_threads)
+#endif
+        for (long i = 0; i < n_coupled; i++) {
+          auto const &p = *coupled[i];
+          if (not in_local_halo(p.r.p))
+            continue;
+          try {
+            forces[i] = lb_viscous_coupling_force(
+                p, noise_amplitude * f_random(p.identity()));
+          } catch (...) {
+#ifdef OPENMP
+#pragma omp critical(lb_coupling_error)
+#endif
+            error = std::current_exception();
+          }
+        }
+        if (error) {
+          std::rethrow_exception(error);
+        }
 
+        /* The forces are added to the lattice in the order of the
+         * particles, so the force density does not depend on the
+         * number of threads. */
+        for (std::size_t i = 0; i < coupled.size(); i++) {
+          auto &p = *coupled[i];
+          if (in_local_halo(p.r.p)) {
+            add_md_force(p.r.p, forces[i]);
+          }
           /* Particle is in our LB volume, so this node
            * is responsible to adding its force */
           if (in_local_domain(p.r.p, local_geo)) {
-            auto const force = lb_viscous_coupling(
-                p, noise_amplitude * f_random(p.identity()));
-            /* add force to the particle */
-            p.f.f += force;
-            /* Particle is not in our domain, but adds to the force
-             * density in our domain, only calculate contribution to
-             * the LB force density. */
-          } else if (in_local_halo(p.r.p)) {
-            lb_viscous_coupling(p, noise_amplitude * f_random(p.identity()));
+            p.f.f += forces[i];
           }
 
 #ifdef ENGINE
           add_swimmer_force(p);
 #endif
-        };
-
-        /* Couple particles ranges */
-        for (auto &p : particles) {
-          couple_particle(p);
-        }
-
-        for (auto &p : more_particles) {
-          couple_particle(p);
         }
 
         break;
@@ -82,6 +82,8 @@ bool skin_set = false;
 
 bool recalc_forces = true;
 
+int long_range_interval = 1;
+
 double verlet_reuse = 0.0;
 
 bool set_py_interrupt = false;
@@ -97,10 +99,40 @@ void notify_sig_int() {
 /** Thermostats increment the RNG counter here. */
 void philox_counter_increment();
 
+namespace {
+/** Number of time steps since the last evaluation of the long
+ *  range forces, see @ref long_range_interval. */
+int long_range_phase = 0;
+
+/** @brief Weight of the long range forces in the next force calculation.
+ *
+ *  Advances the multiple time stepping by one step. The weight is
+ *  @ref long_range_interval every @ref long_range_interval steps, and
+ *  zero otherwise.
+ *
+ *  @param restart  Restart the outer time step, e.g. for a force
+ *                  calculation which is not preceded by a time step.
+ */
+double next_long_range_weight(bool restart) {
+  if (integ_switch != INTEG_METHOD_NVT or long_range_interval == 1)
+    return 1.;
+
+  long_range_phase = restart ? 0 : (long_range_phase + 1) % long_range_interval;
+  return (long_range_phase == 0) ? long_range_interval : 0.;
+}
+} // namespace
+
 void integrator_sanity_checks() {
   if (time_step < 0.0) {
     runtimeErrorMsg() << "time_step not set";
   }
+#if defined(ELECTROSTATICS) && defined(CUDA)
+  if (integ_switch == INTEG_METHOD_NVT and long_range_interval > 1 and
+      coulomb.method == COULOMB_P3M_GPU) {
+    runtimeErrorMsg() << "The long range forces of P3M on the GPU cannot be "
+                         "evaluated with multiple time stepping";
+  }
+#endif
 }
 
 /** @brief Calls the hook for propagation kernels before the force calculation
@@ -187,10 +219,11 @@ int integrate(int n_steps, int reuse_forces) {
     virtual_sites()->update();
 #endif
 
-    // Communication step: distribute ghost positions
-    cells_update_ghosts(global_ghost_flags());
+    // Communication step: distribute ghost positions,
+    // completed in force_calc
+    cells_update_ghosts_begin(global_ghost_flags());
 
-    force_calc(cell_structure);
+    force_calc(cell_structure, next_long_range_weight(true));
 
     if (integ_switch != INTEG_METHOD_STEEPEST_DESCENT) {
 #ifdef ROTATION
@@ -243,12 +276,13 @@ int integrate(int n_steps, int reuse_forces) {
     virtual_sites()->update();
 #endif
 
-    // Communication step: distribute ghost positions
-    cells_update_ghosts(global_ghost_flags());
+    // Communication step: distribute ghost positions,
+    // completed in force_calc
+    cells_update_ghosts_begin(global_ghost_flags());
 
     particles = cell_structure.local_particles();
 
-    force_calc(cell_structure);
+    force_calc(cell_structure, next_long_range_weight(false));
 
 #ifdef VIRTUAL_SITES
     virtual_sites()->after_force_calc();
@@ -417,9 +451,16 @@ int integrate_set_steepest_descent(const double f_max, const double gamma,
   return ES_OK;
 }
 
-void integrate_set_nvt() {
+int integrate_set_nvt(int interval) {
+  if (interval < 1) {
+    runtimeErrorMsg() << "The long range interval must be positive.\n";
+    return ES_ERROR;
+  }
+  long_range_interval = interval;
   integ_switch = INTEG_METHOD_NVT;
   mpi_bcast_parameter(FIELD_INTEG_SWITCH);
+  mpi_bcast_parameter(FIELD_LONG_RANGE_INTERVAL);
+  return ES_OK;
 }
 
 void integrate_set_bd() {
@@ -51,6 +51,11 @@ extern bool skin_set;
 
 /** If true, the forces will be recalculated before the next integration. */
 extern bool recalc_forces;
+/** Number of time steps per evaluation of the long range forces in the
+ *  multiple time stepping of the velocity Verlet integrator, see
+ *  @ref integrate_set_nvt.
+ */
+extern int long_range_interval;
 /** Average number of integration steps the Verlet list has been re-using. */
 extern double verlet_reuse;
 
@@ -118,8 +123,23 @@ int python_integrate(int n_steps, bool recalc_forces, bool reuse_forces);
 int integrate_set_steepest_descent(double f_max, double gamma, int max_steps,
                                    double max_displacement);
 
-/** @brief Set the velocity Verlet integrator for the NVT ensemble. */
-void integrate_set_nvt();
+/** @brief Set the velocity Verlet integrator for the NVT ensemble.
+ *
+ *  With an @p interval larger than one, this is the reversible multiple
+ *  time stepping scheme (RESPA) with impulses of the long range forces.
+ *  The long range forces are only evaluated every @p interval steps, and
+ *  are then added to the particle forces multiplied by @p interval. The
+ *  half kicks of the velocity Verlet steps before and after such a step
+ *  thus apply the half impulses of the outer time step, while the short
+ *  range forces and the thermostat forces are integrated with the time
+ *  step.
+ *
+ *  @param interval  Number of time steps per evaluation of the long
+ *                   range forces, see @ref long_range_interval.
+ *  @retval ES_OK on success
+ *  @retval ES_ERROR on error
+ */
+int integrate_set_nvt(int interval = 1);
 
 /** @brief Set the Brownian Dynamics integrator. */
 void integrate_set_bd();
@@ -53,6 +53,11 @@
 #include "bonded_interactions/bonded_interaction_data.hpp"
 #include "cells.hpp"
 #include "errorhandling.hpp"
+#include "event.hpp"
+#include "particle_data.hpp"
+#include "thermostat.hpp"
+
+#include <utils/Span.hpp>
 
 #include <boost/archive/binary_iarchive.hpp>
 #include <boost/archive/binary_oarchive.hpp>
@@ -62,27 +67,66 @@
 
 #include <mpi.h>
 
+#include <algorithm>
+#include <array>
 #include <cerrno>
+#include <cstdint>
 #include <cstring>
 #include <string>
 #include <sys/stat.h>
+#include <type_traits>
 #include <vector>
 
 namespace Mpiio {
 
-/** Dumps arr of size len starting from prefix pref of type T using
- * MPI_T as MPI datatype. Beware, that T and MPI_T have to match!
+/** Staging buffers of a write and the requests of its nonblocking
+ *  MPI-IO operations. The buffers must not be touched until the
+ *  requests are completed.
+ */
+struct PendingWrite {
+  int pref = 0;
+  int bonds_size = 0;
+  std::vector<int> id, type;
+  std::vector<double> pos, vel;
+  std::vector<char> bonds;
+  std::vector<std::string> file_names;
+  std::vector<MPI_File> files;
+  std::vector<MPI_Request> requests;
+};
+
+/** Double buffer: the next write is staged while the previous one is
+ *  still being written to the filesystem.
+ */
+static std::array<PendingWrite, 2> write_buffers;
+static PendingWrite *in_flight = nullptr;
+
+static void mpiio_open_error(const std::string &fn, int ret) {
+  char buf[MPI_MAX_ERROR_STRING];
+  int buf_len;
+  MPI_Error_string(ret, buf, &buf_len);
+  buf[buf_len] = '\0';
+  fprintf(stderr, "MPI-IO Error: Could not open file \"%s\": %s\n",
+          fn.c_str(), buf);
+  errexit();
+}
+
+/** Starts dumping arr of size len starting from prefix pref of type T
+ * using MPI_T as MPI datatype. Beware, that T and MPI_T have to match!
+ * The write is nonblocking, it is completed by @ref mpiio_wait.
  *
  * \param fn The file name to dump to. Must not exist already
- * \param arr The array to dump
+ * \param arr The array to dump, must stay valid until the write completes
  * \param len The number of elements to dump
  * \param pref The prefix for this process
  * \param MPI_T The MPI_Datatype corresponding to the template parameter T.
+ * \param pending The write this operation belongs to
  */
 template <typename T>
-static void mpiio_dump_array(const std::string &fn, T *arr, size_t len,
-                             size_t pref, MPI_Datatype MPI_T) {
+static void mpiio_dump_array(const std::string &fn, T const *arr, size_t len,
+                             size_t pref, MPI_Datatype MPI_T,
+                             PendingWrite &pending) {
   MPI_File f;
+  MPI_Request request;
   int ret;
 
   ret = MPI_File_open(MPI_COMM_WORLD, const_cast<char *>(fn.c_str()),
@@ -90,22 +134,48 @@ static void mpiio_dump_array(const std::string &fn, T *arr, size_t len,
                       MPI_MODE_WRONLY | MPI_MODE_CREATE | MPI_MODE_EXCL,
                       MPI_INFO_NULL, &f);
   if (ret) {
-    char buf[MPI_MAX_ERROR_STRING];
-    int buf_len;
-    MPI_Error_string(ret, buf, &buf_len);
-    buf[buf_len] = '\0';
-    fprintf(stderr, "MPI-IO Error: Could not open file \"%s\": %s\n",
-            fn.c_str(), buf);
-    errexit();
+    mpiio_open_error(fn, ret);
   }
   ret = MPI_File_set_view(f, pref * sizeof(T), MPI_T, MPI_T,
                           const_cast<char *>("native"), MPI_INFO_NULL);
-  ret |= MPI_File_write_all(f, arr, len, MPI_T, MPI_STATUS_IGNORE);
-  MPI_File_close(&f);
+  ret |= MPI_File_iwrite_all(f, arr, static_cast<int>(len), MPI_T, &request);
   if (ret) {
+    MPI_File_close(&f);
     fprintf(stderr, "MPI-IO Error: Could not write file \"%s\".\n", fn.c_str());
     errexit();
   }
+  pending.file_names.push_back(fn);
+  pending.files.push_back(f);
+  pending.requests.push_back(request);
+}
+
+/** Completes all writes of a pending write and closes its files.
+ *  To be called by all MPI processes.
+ */
+static void mpiio_wait(PendingWrite &pending) {
+  auto const ret =
+      MPI_Waitall(static_cast<int>(pending.requests.size()),
+                  pending.requests.data(), MPI_STATUSES_IGNORE);
+  for (auto &f : pending.files) {
+    MPI_File_close(&f);
+  }
+  if (ret) {
+    for (auto const &fn : pending.file_names) {
+      fprintf(stderr, "MPI-IO Error: Could not write file \"%s\".\n",
+              fn.c_str());
+    }
+    errexit();
+  }
+  pending.file_names.clear();
+  pending.files.clear();
+  pending.requests.clear();
+}
+
+void mpi_mpiio_common_wait() {
+  if (in_flight) {
+    mpiio_wait(*in_flight);
+    in_flight = nullptr;
+  }
 }
 
 /** Dumps some generic infos like the dumped fields and info to process
@@ -148,75 +218,59 @@ static void dump_info(const std::string &fn, unsigned fields) {
 }
 
 void mpi_mpiio_common_write(const char *filename, unsigned fields,
-                            const ParticleRange &particles) {
+                            const ParticleRange &particles, bool async) {
   std::string fnam(filename);
   int const nlocalpart = static_cast<int>(particles.size());
-  // Keep static buffers in order not having to allocate them on every
-  // function call
-  static std::vector<double> pos, vel;
-  static std::vector<int> id, type;
+  // Stage into the buffer which is not in flight, so that packing
+  // overlaps with the completion of the previous write.
+  auto &staged = (in_flight == &write_buffers[0]) ? write_buffers[1]
+                                                  : write_buffers[0];
 
   // Nlocalpart prefixes
   // Prefixes based for arrays: 3 * pref for vel, pos.
-  int pref = 0, bpref = 0;
-  MPI_Exscan(&nlocalpart, &pref, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
-
-  // Realloc static buffers if necessary
-  if (nlocalpart > id.size())
-    id.resize(nlocalpart);
-  if (fields & MPIIO_OUT_POS && 3 * nlocalpart > pos.size())
-    pos.resize(3 * nlocalpart);
-  if (fields & MPIIO_OUT_VEL && 3 * nlocalpart > vel.size())
-    vel.resize(3 * nlocalpart);
-  if (fields & MPIIO_OUT_TYP && nlocalpart > type.size())
-    type.resize(nlocalpart);
+  int bpref = 0;
+  staged.pref = 0;
+  MPI_Exscan(&nlocalpart, &staged.pref, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+  auto const pref = staged.pref;
+
+  // Resize staging buffers, they keep their capacity between calls
+  staged.id.resize(nlocalpart);
+  if (fields & MPIIO_OUT_POS)
+    staged.pos.resize(3 * nlocalpart);
+  if (fields & MPIIO_OUT_VEL)
+    staged.vel.resize(3 * nlocalpart);
+  if (fields & MPIIO_OUT_TYP)
+    staged.type.resize(nlocalpart);
 
   // Pack the necessary information
-  // Esp. rescale the velocities.
   int i1 = 0, i3 = 0;
   for (auto const &p : particles) {
-    id[i1] = p.p.identity;
+    staged.id[i1] = p.p.identity;
     if (fields & MPIIO_OUT_POS) {
-      pos[i3] = p.r.p[0];
-      pos[i3 + 1] = p.r.p[1];
-      pos[i3 + 2] = p.r.p[2];
+      staged.pos[i3] = p.r.p[0];
+      staged.pos[i3 + 1] = p.r.p[1];
+      staged.pos[i3 + 2] = p.r.p[2];
     }
     if (fields & MPIIO_OUT_VEL) {
-      vel[i3] = p.m.v[0];
-      vel[i3 + 1] = p.m.v[1];
-      vel[i3 + 2] = p.m.v[2];
+      staged.vel[i3] = p.m.v[0];
+      staged.vel[i3 + 1] = p.m.v[1];
+      staged.vel[i3 + 2] = p.m.v[2];
     }
     if (fields & MPIIO_OUT_TYP) {
-      type[i1] = p.p.type;
+      staged.type[i1] = p.p.type;
     }
     i1++;
     i3 += 3;
   }
 
-  int rank;
-  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
-  if (rank == 0)
-    dump_info(fnam + ".head", fields);
-  mpiio_dump_array<int>(fnam + ".pref", &pref, 1, rank, MPI_INT);
-  mpiio_dump_array<int>(fnam + ".id", id.data(), nlocalpart, pref, MPI_INT);
-  if (fields & MPIIO_OUT_POS)
-    mpiio_dump_array<double>(fnam + ".pos", pos.data(), 3 * nlocalpart,
-                             3 * pref, MPI_DOUBLE);
-  if (fields & MPIIO_OUT_VEL)
-    mpiio_dump_array<double>(fnam + ".vel", vel.data(), 3 * nlocalpart,
-                             3 * pref, MPI_DOUBLE);
-  if (fields & MPIIO_OUT_TYP)
-    mpiio_dump_array<int>(fnam + ".type", type.data(), nlocalpart, pref,
-                          MPI_INT);
-
   if (fields & MPIIO_OUT_BND) {
-    std::vector<char> bonds;
+    staged.bonds.clear();
 
     /* Construct archive that pushes back to the bond buffer */
     {
       namespace io = boost::iostreams;
       io::stream_buffer<io::back_insert_device<std::vector<char>>> os{
-          io::back_inserter(bonds)};
+          io::back_inserter(staged.bonds)};
       boost::archive::binary_oarchive bond_archiver{os};
 
       for (auto const &p : particles) {
@@ -225,12 +279,42 @@ void mpi_mpiio_common_write(const char *filename, unsigned fields,
     }
 
     // Determine the prefixes in the bond file
-    int bonds_size = static_cast<int>(bonds.size());
-    MPI_Exscan(&bonds_size, &bpref, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+    staged.bonds_size = static_cast<int>(staged.bonds.size());
+    MPI_Exscan(&staged.bonds_size, &bpref, 1, MPI_INT, MPI_SUM,
+               MPI_COMM_WORLD);
+  }
 
-    mpiio_dump_array<int>(fnam + ".boff", &bonds_size, 1, rank, MPI_INT);
-    mpiio_dump_array<char>(fnam + ".bond", bonds.data(), bonds.size(), bpref,
-                           MPI_CHAR);
+  // The particle data is staged, the previous write has to be completed
+  // before the next one can start.
+  mpi_mpiio_common_wait();
+
+  int rank;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  if (rank == 0)
+    dump_info(fnam + ".head", fields);
+  mpiio_dump_array<int>(fnam + ".pref", &staged.pref, 1, rank, MPI_INT,
+                        staged);
+  mpiio_dump_array<int>(fnam + ".id", staged.id.data(), nlocalpart, pref,
+                        MPI_INT, staged);
+  if (fields & MPIIO_OUT_POS)
+    mpiio_dump_array<double>(fnam + ".pos", staged.pos.data(), 3 * nlocalpart,
+                             3 * pref, MPI_DOUBLE, staged);
+  if (fields & MPIIO_OUT_VEL)
+    mpiio_dump_array<double>(fnam + ".vel", staged.vel.data(), 3 * nlocalpart,
+                             3 * pref, MPI_DOUBLE, staged);
+  if (fields & MPIIO_OUT_TYP)
+    mpiio_dump_array<int>(fnam + ".type", staged.type.data(), nlocalpart, pref,
+                          MPI_INT, staged);
+  if (fields & MPIIO_OUT_BND) {
+    mpiio_dump_array<int>(fnam + ".boff", &staged.bonds_size, 1, rank, MPI_INT,
+                          staged);
+    mpiio_dump_array<char>(fnam + ".bond", staged.bonds.data(),
+                           staged.bonds.size(), bpref, MPI_CHAR, staged);
+  }
+  in_flight = &staged;
+
+  if (not async) {
+    mpi_mpiio_common_wait();
   }
 }
 
@@ -269,13 +353,7 @@ static void mpiio_read_array(const std::string &fn, T *arr, size_t len,
                       MPI_MODE_RDONLY, MPI_INFO_NULL, &f);
 
   if (ret) {
-    char buf[MPI_MAX_ERROR_STRING];
-    int buf_len;
-    MPI_Error_string(ret, buf, &buf_len);
-    buf[buf_len] = '\0';
-    fprintf(stderr, "MPI-IO Error: Could not open file \"%s\": %s\n",
-            fn.c_str(), buf);
-    errexit();
+    mpiio_open_error(fn, ret);
   }
   ret = MPI_File_set_view(f, pref * sizeof(T), MPI_T, MPI_T,
                           const_cast<char *>("native"), MPI_INFO_NULL);
@@ -339,6 +417,9 @@ static void read_prefs(const std::string &fn, int rank, int size,
 void mpi_mpiio_common_read(const char *filename, unsigned fields) {
   std::string fnam(filename);
 
+  // The files might still be written asynchronously
+  mpi_mpiio_common_wait();
+
   cell_structure.remove_all_particles();
 
   int size, rank;
@@ -448,4 +529,420 @@ void mpi_mpiio_common_read(const char *filename, unsigned fields) {
     cell_structure.add_particle(std::move(p));
   }
 }
+
+/** Identifiers of the sections of a checkpoint file. */
+enum class CheckpointSection : std::uint32_t {
+  PROPERTIES = 0,
+  POSITION = 1,
+  MOMENTUM = 2,
+  IMAGE_BOX = 3,
+  BOND_LIST_SIZE = 4,
+  BOND_LIST = 5,
+  EXCLUSION_LIST_SIZE = 6,
+  EXCLUSION_LIST = 7,
+};
+
+/** Number of thermostats with an RNG counter in a checkpoint file. */
+constexpr std::size_t checkpoint_n_thermostats = 5;
+
+/** Header of a checkpoint file. It is followed by the section table and
+ *  the sections, each of which stores one element per particle (or per
+ *  bond list entry) in the rank ordering of the writing processes.
+ */
+struct CheckpointHeader {
+  char magic[8];
+  std::uint32_t version;
+  std::uint32_t n_sections;
+  std::uint64_t n_particles;
+  /** Langevin, Brownian, NpT, thermalized bond and DPD RNG counters */
+  std::uint64_t rng_initialized[checkpoint_n_thermostats];
+  std::uint64_t rng_seed[checkpoint_n_thermostats];
+  std::uint64_t rng_counter[checkpoint_n_thermostats];
+};
+
+/** Entry of the section table of a checkpoint file. */
+struct CheckpointSectionEntry {
+  std::uint32_t id;
+  /** Size of one element in bytes */
+  std::uint32_t elem_size;
+  /** Offset of the section in bytes from the beginning of the file */
+  std::uint64_t offset;
+  /** Number of elements */
+  std::uint64_t count;
+};
+
+static constexpr char checkpoint_magic[8] = {'E', 'S', 'P', 'R',
+                                             'C', 'K', 'P', 'T'};
+static constexpr std::uint32_t checkpoint_version = 2;
+
+/** Thermostats in the order of @ref CheckpointHeader::rng_counter. */
+static std::array<BaseThermostat *, checkpoint_n_thermostats>
+checkpoint_thermostats() {
+  return {{&langevin, &brownian, &npt_iso, &thermalized_bond,
+#ifdef DPD
+           &dpd
+#else
+           nullptr
+#endif
+  }};
+}
+
+/** Datatype of a contiguous block of bytes. Has to be freed. */
+static MPI_Datatype bytes_type(std::uint32_t size) {
+  MPI_Datatype type;
+  MPI_Type_contiguous(static_cast<int>(size), MPI_BYTE, &type);
+  MPI_Type_commit(&type);
+  return type;
+}
+
+namespace {
+/** Local part of a section to write. */
+struct LocalSection {
+  CheckpointSectionEntry entry;
+  void const *data;
+  std::uint64_t local_count;
+};
+
+template <typename T>
+LocalSection local_section(CheckpointSection id, std::vector<T> const &data) {
+  static_assert(std::is_trivially_copyable<T>::value,
+                "Checkpoint data has to be trivially copyable.");
+  return {{static_cast<std::uint32_t>(id), sizeof(T), 0, 0},
+          data.data(),
+          data.size()};
+}
+} // namespace
+
+void mpi_mpiio_checkpoint_write(const char *filename,
+                                const ParticleRange &particles) {
+  std::string const fn(filename);
+  auto const nlocalpart = particles.size();
+
+  std::vector<ParticleProperties> properties;
+  std::vector<ParticlePosition> positions;
+  std::vector<ParticleMomentum> momenta;
+  std::vector<Utils::Vector3i> images;
+  std::vector<int> bonds_size, bonds;
+  properties.reserve(nlocalpart);
+  positions.reserve(nlocalpart);
+  momenta.reserve(nlocalpart);
+  images.reserve(nlocalpart);
+  bonds_size.reserve(nlocalpart);
+#ifdef EXCLUSIONS
+  std::vector<int> exclusions_size, exclusions;
+  exclusions_size.reserve(nlocalpart);
+#endif
+
+  // Pack the particle state, bonds are stored in the encoding of
+  // BondList: the partner ids followed by -(bond id + 1).
+  for (auto const &p : particles) {
+    properties.push_back(p.p);
+    positions.push_back(p.r);
+    momenta.push_back(p.m);
+    images.push_back(p.l.i);
+    auto const bonds_begin = bonds.size();
+    for (auto const b : p.bonds()) {
+      bonds.insert(bonds.end(), b.partner_ids().begin(),
+                   b.partner_ids().end());
+      bonds.push_back(-(b.bond_id() + 1));
+    }
+    bonds_size.push_back(static_cast<int>(bonds.size() - bonds_begin));
+#ifdef EXCLUSIONS
+    exclusions.insert(exclusions.end(), p.exclusions().begin(),
+                      p.exclusions().end());
+    exclusions_size.push_back(static_cast<int>(p.exclusions().size()));
+#endif
+  }
+
+  std::vector<LocalSection> sections = {
+      local_section(CheckpointSection::PROPERTIES, properties),
+      local_section(CheckpointSection::POSITION, positions),
+      local_section(CheckpointSection::MOMENTUM, momenta),
+      local_section(CheckpointSection::IMAGE_BOX, images),
+      local_section(CheckpointSection::BOND_LIST_SIZE, bonds_size),
+      local_section(CheckpointSection::BOND_LIST, bonds),
+#ifdef EXCLUSIONS
+      local_section(CheckpointSection::EXCLUSION_LIST_SIZE, exclusions_size),
+      local_section(CheckpointSection::EXCLUSION_LIST, exclusions),
+#endif
+  };
+  auto const n_sections = sections.size();
+
+  // Global element counts and prefixes of this process in each section
+  std::vector<std::uint64_t> local_counts(n_sections), counts(n_sections),
+      prefixes(n_sections, 0);
+  std::transform(sections.begin(), sections.end(), local_counts.begin(),
+                 [](LocalSection const &s) { return s.local_count; });
+  MPI_Allreduce(local_counts.data(), counts.data(),
+                static_cast<int>(n_sections), MPI_UINT64_T, MPI_SUM,
+                MPI_COMM_WORLD);
+  MPI_Exscan(local_counts.data(), prefixes.data(),
+             static_cast<int>(n_sections), MPI_UINT64_T, MPI_SUM,
+             MPI_COMM_WORLD);
+
+  int rank;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  if (rank == 0)
+    std::fill(prefixes.begin(), prefixes.end(), 0);
+
+  std::uint64_t offset =
+      sizeof(CheckpointHeader) + n_sections * sizeof(CheckpointSectionEntry);
+  for (std::size_t i = 0; i < n_sections; ++i) {
+    sections[i].entry.offset = offset;
+    sections[i].entry.count = counts[i];
+    offset += counts[i] * sections[i].entry.elem_size;
+  }
+
+  MPI_File f;
+  auto ret = MPI_File_open(MPI_COMM_WORLD, const_cast<char *>(fn.c_str()),
+                           MPI_MODE_WRONLY | MPI_MODE_CREATE, MPI_INFO_NULL,
+                           &f);
+  if (ret) {
+    mpiio_open_error(fn, ret);
+  }
+  ret = MPI_File_set_size(f, 0);
+
+  if (rank == 0) {
+    CheckpointHeader header{};
+    std::copy(std::begin(checkpoint_magic), std::end(checkpoint_magic),
+              std::begin(header.magic));
+    header.version = checkpoint_version;
+    header.n_sections = static_cast<std::uint32_t>(n_sections);
+    header.n_particles = counts[0];
+    auto const thermostats = checkpoint_thermostats();
+    for (std::size_t i = 0; i < thermostats.size(); ++i) {
+      if (thermostats[i] and thermostats[i]->rng_is_initialized()) {
+        header.rng_initialized[i] = 1;
+        header.rng_seed[i] = thermostats[i]->rng_seed();
+        header.rng_counter[i] = thermostats[i]->rng_get();
+      }
+    }
+    std::vector<CheckpointSectionEntry> table(n_sections);
+    std::transform(sections.begin(), sections.end(), table.begin(),
+                   [](LocalSection const &s) { return s.entry; });
+    ret |= MPI_File_write_at(f, 0, &header, sizeof(header), MPI_BYTE,
+                             MPI_STATUS_IGNORE);
+    ret |= MPI_File_write_at(
+        f, sizeof(header), table.data(),
+        static_cast<int>(n_sections * sizeof(CheckpointSectionEntry)),
+        MPI_BYTE, MPI_STATUS_IGNORE);
+  }
+
+  for (std::size_t i = 0; i < n_sections; ++i) {
+    auto const &s = sections[i];
+    auto type = bytes_type(s.entry.elem_size);
+    ret |= MPI_File_write_at_all(
+        f, static_cast<MPI_Offset>(s.entry.offset +
+                                   prefixes[i] * s.entry.elem_size),
+        s.data, static_cast<int>(s.local_count), type, MPI_STATUS_IGNORE);
+    MPI_Type_free(&type);
+  }
+  MPI_File_close(&f);
+
+  if (ret) {
+    fprintf(stderr, "MPI-IO Error: Could not write file \"%s\".\n", fn.c_str());
+    errexit();
+  }
+}
+
+namespace {
+/** Reader of the sections of an open checkpoint file. */
+class CheckpointReader {
+  MPI_File m_file;
+  std::string m_fn;
+  std::vector<CheckpointSectionEntry> m_table;
+
+  CheckpointSectionEntry const *find(CheckpointSection id) const {
+    auto const it = std::find_if(m_table.begin(), m_table.end(),
+                                 [id](CheckpointSectionEntry const &e) {
+                                   return e.id ==
+                                          static_cast<std::uint32_t>(id);
+                                 });
+    return (it == m_table.end()) ? nullptr : &*it;
+  }
+
+  void error(const char *msg) const {
+    fprintf(stderr, "MPI-IO Error: Could not read checkpoint \"%s\": %s\n",
+            m_fn.c_str(), msg);
+    errexit();
+  }
+
+public:
+  CheckpointReader(MPI_File f, std::string fn,
+                   std::vector<CheckpointSectionEntry> table)
+      : m_file(f), m_fn(std::move(fn)), m_table(std::move(table)) {}
+
+  /** Read elements [first, first + count) of a section. A missing
+   *  section is read as default-constructed elements.
+   */
+  template <typename T>
+  std::vector<T> read(CheckpointSection id, std::uint64_t first,
+                      std::uint64_t count) const {
+    std::vector<T> data(count);
+    auto const entry = find(id);
+    if (not entry) {
+      return data;
+    }
+    if (entry->elem_size != sizeof(T)) {
+      error("the file was written with a different feature set");
+    }
+    if (first + count > entry->count) {
+      error("the file is truncated");
+    }
+    auto type = bytes_type(entry->elem_size);
+    auto const ret = MPI_File_read_at_all(
+        m_file, static_cast<MPI_Offset>(entry->offset + first * sizeof(T)),
+        data.data(), static_cast<int>(count), type, MPI_STATUS_IGNORE);
+    MPI_Type_free(&type);
+    if (ret) {
+      error("read failed");
+    }
+    return data;
+  }
+
+  /** Read a section of per-particle lists, which is described by a
+   *  section with the list sizes of the particles [first, first + count).
+   */
+  std::vector<int> read_lists(CheckpointSection size_id, CheckpointSection id,
+                              std::uint64_t first, std::uint64_t count,
+                              std::vector<int> &sizes) const {
+    sizes = read<int>(size_id, first, count);
+    std::uint64_t local_size = 0;
+    for (auto const size : sizes) {
+      local_size += static_cast<std::uint64_t>(size);
+    }
+    std::uint64_t prefix = 0;
+    MPI_Exscan(&local_size, &prefix, 1, MPI_UINT64_T, MPI_SUM, MPI_COMM_WORLD);
+    int rank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    if (rank == 0)
+      prefix = 0;
+    return read<int>(id, prefix, local_size);
+  }
+};
+} // namespace
+
+void mpi_mpiio_checkpoint_read(const char *filename) {
+  std::string const fn(filename);
+
+  int size, rank;
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+  MPI_File f;
+  auto ret = MPI_File_open(MPI_COMM_WORLD, const_cast<char *>(fn.c_str()),
+                           MPI_MODE_RDONLY, MPI_INFO_NULL, &f);
+  if (ret) {
+    mpiio_open_error(fn, ret);
+  }
+
+  // Header and section table on master node, broadcast to all nodes.
+  CheckpointHeader header{};
+  std::vector<CheckpointSectionEntry> table;
+  int valid = 0;
+  if (rank == 0) {
+    ret = MPI_File_read_at(f, 0, &header, sizeof(header), MPI_BYTE,
+                           MPI_STATUS_IGNORE);
+    valid = not ret and
+            std::equal(std::begin(checkpoint_magic), std::end(checkpoint_magic),
+                       std::begin(header.magic)) and
+            header.version == checkpoint_version;
+    if (valid) {
+      table.resize(header.n_sections);
+      ret = MPI_File_read_at(
+          f, sizeof(header), table.data(),
+          static_cast<int>(table.size() * sizeof(CheckpointSectionEntry)),
+          MPI_BYTE, MPI_STATUS_IGNORE);
+      valid = not ret;
+    }
+  }
+  MPI_Bcast(&valid, 1, MPI_INT, 0, MPI_COMM_WORLD);
+  if (not valid) {
+    MPI_File_close(&f);
+    if (rank == 0) {
+      fprintf(stderr, "MPI-IO Error: \"%s\" is not a valid checkpoint.\n",
+              fn.c_str());
+      errexit();
+    }
+    return;
+  }
+  MPI_Bcast(&header, sizeof(header), MPI_BYTE, 0, MPI_COMM_WORLD);
+  table.resize(header.n_sections);
+  MPI_Bcast(table.data(),
+            static_cast<int>(table.size() * sizeof(CheckpointSectionEntry)),
+            MPI_BYTE, 0, MPI_COMM_WORLD);
+
+  // The particles are distributed evenly over the processes,
+  // independent of the number of processes at the point of writing.
+  auto const n = header.n_particles;
+  auto const first = n * rank / size;
+  auto const nlocalpart = n * (rank + 1) / size - first;
+
+  CheckpointReader const reader(f, fn, std::move(table));
+  auto const properties = reader.read<ParticleProperties>(
+      CheckpointSection::PROPERTIES, first, nlocalpart);
+  auto const positions = reader.read<ParticlePosition>(
+      CheckpointSection::POSITION, first, nlocalpart);
+  auto const momenta = reader.read<ParticleMomentum>(
+      CheckpointSection::MOMENTUM, first, nlocalpart);
+  auto const images = reader.read<Utils::Vector3i>(
+      CheckpointSection::IMAGE_BOX, first, nlocalpart);
+  std::vector<int> bonds_size;
+  auto const bonds = reader.read_lists(CheckpointSection::BOND_LIST_SIZE,
+                                       CheckpointSection::BOND_LIST, first,
+                                       nlocalpart, bonds_size);
+#ifdef EXCLUSIONS
+  std::vector<int> exclusions_size;
+  auto const exclusions = reader.read_lists(
+      CheckpointSection::EXCLUSION_LIST_SIZE, CheckpointSection::EXCLUSION_LIST,
+      first, nlocalpart, exclusions_size);
+#endif
+  MPI_File_close(&f);
+
+  cell_structure.remove_all_particles();
+
+  auto bond = bonds.begin();
+#ifdef EXCLUSIONS
+  auto exclusion = exclusions.begin();
+#endif
+  for (std::uint64_t i = 0; i < nlocalpart; ++i) {
+    Particle p;
+    p.p = properties[i];
+    p.r = positions[i];
+    p.m = momenta[i];
+    p.l.i = images[i];
+    auto const bonds_end = bond + bonds_size[i];
+    while (bond != bonds_end) {
+      auto const id_pos =
+          std::find_if(bond, bonds_end, [](int x) { return x < 0; });
+      if (id_pos == bonds_end) {
+        fprintf(stderr,
+                "MPI-IO Error: Could not read checkpoint \"%s\": the "
+                "checkpoint file is corrupt (unterminated bond list).\n",
+                fn.c_str());
+        errexit();
+      }
+      p.bonds().insert(
+          BondView{-(*id_pos) - 1,
+                   Utils::make_span(std::addressof(*bond),
+                                    static_cast<std::size_t>(id_pos - bond))});
+      bond = std::next(id_pos);
+    }
+#ifdef EXCLUSIONS
+    p.exclusions().assign(exclusion, exclusion + exclusions_size[i]);
+    exclusion += exclusions_size[i];
+#endif
+    cell_structure.add_particle(std::move(p));
+  }
+
+  auto const thermostats = checkpoint_thermostats();
+  for (std::size_t i = 0; i < thermostats.size(); ++i) {
+    if (thermostats[i] and header.rng_initialized[i]) {
+      thermostats[i]->rng_restore(header.rng_seed[i], header.rng_counter[i]);
+    }
+  }
+
+  clear_particle_node();
+  on_particle_change();
+}
 } // namespace Mpiio
@@ -42,11 +42,25 @@ enum MPIIOOutputFields : unsigned int {
 /** Parallel binary output using MPI-IO. To be called by all MPI
  * processes. Aborts ESPResSo if an error occurs.
  *
+ * The particle data is copied into a staging buffer and written with
+ * nonblocking MPI-IO. In asynchronous mode, the call returns before the
+ * data is written; the write is completed by the next call to
+ * @ref mpi_mpiio_common_write, @ref mpi_mpiio_common_read or
+ * @ref mpi_mpiio_common_wait.
+ *
  * \param filename A null-terminated filename prefix.
  * \param fields Output specifier which fields to dump.
+ * \param particles Local particles to dump.
+ * \param async Return without waiting for the write to complete.
  */
 void mpi_mpiio_common_write(const char *filename, unsigned fields,
-                            const ParticleRange &particles);
+                            const ParticleRange &particles,
+                            bool async = false);
+
+/** Wait for the completion of an asynchronous write. To be called by all
+ * MPI processes. Aborts ESPResSo if an error occurs.
+ */
+void mpi_mpiio_common_wait();
 
 /** Parallel binary input using MPI-IO. To be called by all MPI
  * processes. Aborts ESPResSo if an error occurs.
@@ -56,6 +70,31 @@ void mpi_mpiio_common_write(const char *filename, unsigned fields,
  */
 void mpi_mpiio_common_read(const char *filename, unsigned fields);
 
+/** Parallel binary checkpoint using MPI-IO. To be called by all MPI
+ * processes. Aborts ESPResSo if an error occurs.
+ *
+ * Writes a single file with a header, a section table and one section
+ * per particle field, which contains the full state of the particles
+ * (properties, position and orientation, velocity and angular velocity,
+ * image box, bonds and exclusions) and the RNG counters of the
+ * thermostats. The file is overwritten if it exists.
+ *
+ * \param filename A null-terminated filename.
+ * \param particles Local particles to write.
+ */
+void mpi_mpiio_checkpoint_write(const char *filename,
+                                const ParticleRange &particles);
+
+/** Parallel binary input of a checkpoint written by
+ * @ref mpi_mpiio_checkpoint_write. To be called by all MPI processes.
+ * Aborts ESPResSo if an error occurs. Replaces all particles. The number
+ * of processes may differ from the one at the point of writing, but the
+ * features have to be the same.
+ *
+ * \param filename A null-terminated filename.
+ */
+void mpi_mpiio_checkpoint_read(const char *filename);
+
 } // namespace Mpiio
 
 #endif
@@ -24,13 +24,20 @@
 #include "h5md_specification.hpp"
 #include "version.hpp"
 
+#include <boost/mpi/collectives/all_reduce.hpp>
+
+#include <algorithm>
+#include <cstdint>
 #include <fstream>
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace Writer {
 namespace H5md {
 
-using MultiArray3i = boost::multi_array<int, 3>;
 using Vector1hs = Utils::Vector<hsize_t, 1>;
 using Vector2hs = Utils::Vector<hsize_t, 2>;
 using Vector3hs = Utils::Vector<hsize_t, 3>;
@@ -141,8 +148,9 @@ static std::vector<hsize_t> create_dims(hsize_t rank, hsize_t data_dim) {
   }
 }
 
-static std::vector<hsize_t> create_chunk_dims(hsize_t rank, hsize_t data_dim) {
-  hsize_t chunk_size = (rank > 1) ? 1000 : 1;
+static std::vector<hsize_t> create_chunk_dims(hsize_t rank, hsize_t data_dim,
+                                              hsize_t n_part_chunk) {
+  hsize_t chunk_size = (rank > 1) ? n_part_chunk : 1;
   switch (rank) {
   case 3:
     return {1, chunk_size, data_dim};
@@ -163,16 +171,35 @@ void File::create_datasets() {
       continue;
     auto maxdims = std::vector<hsize_t>(d.rank, H5S_UNLIMITED);
     auto dataspace = h5xx::dataspace(create_dims(d.rank, d.data_dim), maxdims);
-    auto storage = hps::chunked(create_chunk_dims(d.rank, d.data_dim))
+    auto storage =
+        hps::chunked(create_chunk_dims(d.rank, d.data_dim, m_chunk_size))
                        .set(hps::fill_value(-10));
     datasets[d.path()] = h5xx::dataset(m_h5md_file, d.path(), d.type, dataspace,
                                        storage, H5P_DEFAULT, H5P_DEFAULT);
   }
 }
 
+/** Whether two paths of a file refer to the same object. */
+static bool is_same_object(h5xx::file const &file, std::string const &path1,
+                           std::string const &path2) {
+  hobj_ref_t ref1, ref2;
+  if (H5Rcreate(&ref1, file.hid(), path1.c_str(), H5R_OBJECT, -1) < 0) {
+    throw std::runtime_error("Error creating reference to " + path1);
+  }
+  if (H5Rcreate(&ref2, file.hid(), path2.c_str(), H5R_OBJECT, -1) < 0) {
+    throw std::runtime_error("Error creating reference to " + path2);
+  }
+  return ref1 == ref2;
+}
+
 void File::load_file(const std::string &file_path) {
   m_h5md_file = h5xx::file(file_path, m_comm, MPI_INFO_NULL, h5xx::file::out);
   load_datasets();
+  /* In files of older versions, the connectivity is written for every
+   * frame, and its step and time are links to those of the ids. */
+  m_connectivity_per_frame =
+      is_same_object(m_h5md_file, "connectivity/atoms/step",
+                     "particles/atoms/id/step");
 }
 
 void write_box(const BoxGeometry &geometry, const h5xx::file &h5md_file,
@@ -210,6 +237,8 @@ void File::write_units() {
                         m_force_unit);
   h5xx::write_attribute(datasets["particles/atoms/id/time"], "unit",
                         m_time_unit);
+  h5xx::write_attribute(datasets["connectivity/atoms/time"], "unit",
+                        m_time_unit);
 }
 
 void hard_link(h5xx::file const &file, std::string from, std::string to) {
@@ -270,29 +299,103 @@ template <> struct slice_info<2> {
   }
 };
 
+template <typename T> hid_t native_type();
+template <> hid_t native_type<int>() { return H5T_NATIVE_INT; }
+template <> hid_t native_type<double>() { return H5T_NATIVE_DOUBLE; }
+
+/** Dataset transfer property list for collective MPI-IO. */
+class collective_transfer {
+public:
+  collective_transfer() : m_hid(H5Pcreate(H5P_DATASET_XFER)) {
+    if (m_hid < 0 or H5Pset_dxpl_mpio(m_hid, H5FD_MPIO_COLLECTIVE) < 0) {
+      close();
+      throw std::runtime_error(
+          "H5MD Error: creating the transfer property list failed\n");
+    }
+  }
+  collective_transfer(collective_transfer const &) = delete;
+  collective_transfer &operator=(collective_transfer const &) = delete;
+  ~collective_transfer() { close(); }
+
+  hid_t hid() const { return m_hid; }
+
+private:
+  void close() {
+    if (m_hid >= 0)
+      H5Pclose(m_hid);
+  }
+
+  hid_t m_hid;
+};
+
+/**
+ * @brief Write a contiguous buffer to a hyperslab of a dataset.
+ *
+ * The write is a single collective MPI-IO operation, so all processes
+ * have to call this, also those without data, which then do not select
+ * any elements.
+ */
+template <typename T, typename extent_type>
+void write_hyperslab(h5xx::dataset &dataset, std::vector<T> const &buffer,
+                     extent_type const &offset, extent_type const &count) {
+  auto file_space = static_cast<h5xx::dataspace>(dataset);
+  auto const mem_dims =
+      std::vector<hsize_t>{std::max<hsize_t>(buffer.size(), 1)};
+  auto mem_space = h5xx::dataspace(mem_dims, mem_dims);
+  if (buffer.empty()) {
+    H5Sselect_none(file_space.hid());
+    H5Sselect_none(mem_space.hid());
+  } else {
+    file_space.select(h5xx::slice(offset, count));
+  }
+
+  collective_transfer const xfer_plist;
+  if (H5Dwrite(dataset.hid(), native_type<T>(), mem_space.hid(),
+               file_space.hid(), xfer_plist.hid(), buffer.data()) < 0) {
+    throw std::runtime_error("H5MD Error: writing to dataset failed\n");
+  }
+}
+
 } // namespace detail
+
+/**
+ * @brief Write a particle property of the current time step.
+ *
+ * The values of the local particles are packed into one buffer, which
+ * is written to the rows @p prefix to @p prefix + particles.size() - 1
+ * of the new time step.
+ */
 template <size_t dim, typename Op>
 void write_td_particle_property(hsize_t prefix, hsize_t n_part_global,
                                 ParticleRange const &particles,
                                 h5xx::dataset &dataset, Op op) {
+  using property_type =
+      std::decay_t<decltype(op(std::declval<Particle const &>()))>;
+  using value_type = typename property_type::value_type;
+
   auto const old_extents = static_cast<h5xx::dataspace>(dataset).extents();
   auto const extent_particle_number =
       std::max(n_part_global, old_extents[1]) - old_extents[1];
   extend_dataset(dataset,
                  detail::slice_info<dim>::extent(extent_particle_number));
-  auto const count = detail::slice_info<dim>::count();
-  auto offset = detail::slice_info<dim>::offset(old_extents[0], prefix);
+
+  std::vector<value_type> buffer;
+  buffer.reserve(particles.size() * property_type{}.size());
   for (auto const &p : particles) {
-    h5xx::write_dataset(dataset, op(p), h5xx::slice(offset, count));
-    // advance in the particle dimension
-    offset[1] += 1;
+    auto const value = op(p);
+    buffer.insert(buffer.end(), value.begin(), value.end());
   }
+
+  auto count = detail::slice_info<dim>::count();
+  count[1] = particles.size();
+  auto const offset = detail::slice_info<dim>::offset(old_extents[0], prefix);
+  detail::write_hyperslab(dataset, buffer, offset, count);
 }
 
 void File::write(const ParticleRange &particles, double time, int step,
                  BoxGeometry const &geometry) {
   write_box(geometry, m_h5md_file, datasets["particles/atoms/box/edges/value"]);
-  write_connectivity(particles);
+  write_connectivity(particles, time, step);
 
   int const n_part_local = particles.size();
   // calculate count and offset
@@ -347,39 +450,77 @@ void File::write(const ParticleRange &particles, double time, int step,
       datasets["particles/atoms/charge/value"],
       [](auto const &p) { return Utils::Vector<double, 1>{p.p.q}; });
 }
-void File::write_connectivity(const ParticleRange &particles) {
-  MultiArray3i bond(boost::extents[0][0][0]);
-  int particle_index = 0;
+
+namespace detail {
+/** Hash of a pair bond, the sum over all bonds identifies the topology. */
+inline std::uint64_t bond_hash(int id, int partner_id) {
+  /* splitmix64 finalizer */
+  auto const hi = static_cast<std::uint64_t>(static_cast<std::uint32_t>(id));
+  auto const lo = static_cast<std::uint64_t>(
+      static_cast<std::uint32_t>(partner_id));
+  auto x = (hi << 32u) | lo;
+  x = (x ^ (x >> 30u)) * 0xbf58476d1ce4e5b9u;
+  x = (x ^ (x >> 27u)) * 0x94d049bb133111ebu;
+  return x ^ (x >> 31u);
+}
+} // namespace detail
+
+void File::write_connectivity(const ParticleRange &particles, double time,
+                              int step) {
+  /* Count and hash the pair bonds, the hash does not depend on the
+   * order of the particles or on their distribution over the ranks. */
+  Utils::Vector<std::uint64_t, 2> topology{};
+  for (auto const &p : particles) {
+    for (auto const b : p.bonds()) {
+      auto const partner_ids = b.partner_ids();
+      if (partner_ids.size() == 1) {
+        topology[0] += 1;
+        topology[1] += detail::bond_hash(p.p.identity, partner_ids[0]);
+      }
+    }
+  }
+  topology = boost::mpi::all_reduce(m_comm, topology, std::plus<>());
+
+  if (not m_connectivity_per_frame and m_topology and
+      *m_topology == topology) {
+    return;
+  }
+  m_topology = topology;
+
+  std::vector<int> bonds;
   for (auto const &p : particles) {
-    int nbonds_local = bond.shape()[1];
     for (auto const b : p.bonds()) {
       auto const partner_ids = b.partner_ids();
       if (partner_ids.size() == 1) {
-        bond.resize(boost::extents[1][nbonds_local + 1][2]);
-        bond[0][nbonds_local][0] = p.p.identity;
-        bond[0][nbonds_local][1] = partner_ids[0];
-        nbonds_local++;
+        bonds.push_back(p.p.identity);
+        bonds.push_back(partner_ids[0]);
       }
     }
-    particle_index++;
   }
 
-  int n_bonds_local = bond.shape()[1];
+  int const n_bonds_local = static_cast<int>(bonds.size() / 2);
   int prefix_bonds = 0;
   BOOST_MPI_CHECK_RESULT(
       MPI_Exscan, (&n_bonds_local, &prefix_bonds, 1, MPI_INT, MPI_SUM, m_comm));
-  auto const n_bonds_total =
-      boost::mpi::all_reduce(m_comm, n_bonds_local, std::plus<int>());
-  auto const extents =
-      static_cast<h5xx::dataspace>(datasets["connectivity/atoms/value"])
-          .extents();
-  Vector3hs offset_bonds = {extents[0], static_cast<hsize_t>(prefix_bonds), 0};
-  Vector3hs count_bonds = {1, static_cast<hsize_t>(n_bonds_local), 2};
-  auto const n_bond_diff =
-      std::max(static_cast<hsize_t>(n_bonds_total), extents[1]) - extents[1];
-  Vector3hs change_extent_bonds = {1, static_cast<hsize_t>(n_bond_diff), 0};
-  write_dataset(bond, datasets["connectivity/atoms/value"], change_extent_bonds,
-                offset_bonds, count_bonds);
+  auto const n_bonds_total = static_cast<hsize_t>(topology[0]);
+
+  auto &dataset = datasets["connectivity/atoms/value"];
+  auto const extents = static_cast<h5xx::dataspace>(dataset).extents();
+  auto const n_bond_diff = std::max(n_bonds_total, extents[1]) - extents[1];
+  extend_dataset(dataset, Vector3hs{1, n_bond_diff, 0});
+  detail::write_hyperslab(
+      dataset, bonds,
+      Vector3hs{extents[0], static_cast<hsize_t>(prefix_bonds), 0},
+      Vector3hs{1, static_cast<hsize_t>(n_bonds_local), 2});
+
+  if (not m_connectivity_per_frame) {
+    write_dataset(Utils::Vector<double, 1>{time},
+                  datasets["connectivity/atoms/time"], Vector1hs{1},
+                  Vector1hs{extents[0]}, Vector1hs{1});
+    write_dataset(Utils::Vector<int, 1>{step},
+                  datasets["connectivity/atoms/step"], Vector1hs{1},
+                  Vector1hs{extents[0]}, Vector1hs{1});
+  }
 }
 
 void File::flush() { m_h5md_file.flush(); }
@@ -24,15 +24,20 @@
 
 #include <boost/filesystem.hpp>
 #include <boost/mpi/communicator.hpp>
+#include <boost/optional.hpp>
 #include <h5xx/h5xx.hpp>
 
 #include <BoxGeometry.hpp>
 #include <algorithm>
+#include <cstdint>
+#include <stdexcept>
 #include <string>
 #include <unordered_map>
 
 #include "ParticleRange.hpp"
 
+#include <utils/Vector.hpp>
+
 namespace h5xx {
 template <typename T, size_t size>
 struct is_array<Utils::Vector<T, size>> : std::true_type {};
@@ -56,18 +61,24 @@ public:
    * @param force_unit The unit for force.
    * @param velocity_unit The unit for velocity.
    * @param charge_unit The unit for charge.
+   * @param chunk_size Number of particles per chunk of the particle
+   * datasets of a new file.
    * @param comm The MPI communicator.
    */
   File(std::string file_path, std::string script_path, std::string mass_unit,
        std::string length_unit, std::string time_unit, std::string force_unit,
-       std::string velocity_unit, std::string charge_unit,
+       std::string velocity_unit, std::string charge_unit, int chunk_size,
        boost::mpi::communicator comm = boost::mpi::communicator())
       : m_script_path(std::move(script_path)),
         m_mass_unit(std::move(mass_unit)),
         m_length_unit(std::move(length_unit)),
         m_time_unit(std::move(time_unit)), m_force_unit(std::move(force_unit)),
         m_velocity_unit(std::move(velocity_unit)),
-        m_charge_unit(std::move(charge_unit)), m_comm(std::move(comm)) {
+        m_charge_unit(std::move(charge_unit)), m_chunk_size(chunk_size),
+        m_comm(std::move(comm)) {
+    if (chunk_size <= 0) {
+      throw std::domain_error("H5MD Error: chunk_size has to be positive");
+    }
     init_file(file_path);
   };
   ~File() = default;
@@ -137,6 +148,12 @@ public:
    */
   std::string &charge_unit() { return m_charge_unit; };
 
+  /**
+   * @brief Retrieve the number of particles per chunk.
+   * @return The chunk size.
+   */
+  int chunk_size() const { return m_chunk_size; };
+
   /**
    * @brief Method to enforce flushing the buffer to disk.
    */
@@ -178,9 +195,16 @@ private:
 
   /**
    * @brief Write the particle bonds (currently only pairs).
+   *
+   * A new connectivity record with its own step and time is only
+   * written if the bonds changed since the last record.
+   *
    * @param particles Particle range for which to write bonds.
+   * @param time Simulation time.
+   * @param step Simulation step.
    */
-  void write_connectivity(const ParticleRange &particles);
+  void write_connectivity(const ParticleRange &particles, double time,
+                          int step);
   /**
    * @brief Write the unit attributes.
    */
@@ -197,11 +221,17 @@ private:
   std::string m_force_unit;
   std::string m_velocity_unit;
   std::string m_charge_unit;
+  int m_chunk_size;
   boost::mpi::communicator m_comm;
   std::string m_backup_filename;
   boost::filesystem::path m_absolute_script_path;
   h5xx::file m_h5md_file;
   std::unordered_map<std::string, h5xx::dataset> datasets;
+  /** Number of pair bonds and sum of their hashes in the last
+   *  connectivity record */
+  boost::optional<Utils::Vector<std::uint64_t, 2>> m_topology;
+  /** Write the connectivity for every frame (files of older versions) */
+  bool m_connectivity_per_frame = false;
 };
 
 struct incompatible_h5mdfile : public std::exception {
@@ -33,8 +33,8 @@ std::array<H5MD_Specification::Dataset, 30> H5MD_Specification::DATASETS = {{
     {"particles/atoms/image", "step", 1, H5T_NATIVE_INT, 1, true},
     {"particles/atoms/image", "time", 1, H5T_NATIVE_DOUBLE, 1, true},
     {"connectivity/atoms", "value", 3, H5T_NATIVE_INT, 2, false},
-    {"connectivity/atoms", "step", 1, H5T_NATIVE_INT, 1, true},
-    {"connectivity/atoms", "time", 1, H5T_NATIVE_DOUBLE, 1, true},
+    {"connectivity/atoms", "step", 1, H5T_NATIVE_INT, 1, false},
+    {"connectivity/atoms", "time", 1, H5T_NATIVE_DOUBLE, 1, false},
 }};
 }
 } // namespace Writer
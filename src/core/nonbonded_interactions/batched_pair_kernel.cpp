@@ -0,0 +1,252 @@
+/*
+ * Copyright (C) 2020 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+/** \file
+ *
+ *  Implementation of \ref batched_pair_kernel.hpp
+ */
+#include "batched_pair_kernel.hpp"
+
+#include "nonbonded_interactions/nonbonded_interaction_data.hpp"
+
+#include <utils/math/int_pow.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+/* Runtime selection of the instruction set via function multi-versioning.
+ * Needs the GNU indirect function mechanism, so only use it with GCC
+ * on x86-64 Linux. Other platforms get the baseline version. */
+#if defined(__GNUC__) && !defined(__clang__) && !defined(__INTEL_COMPILER) && \
+    defined(__x86_64__) && defined(__linux__)
+#define BATCHED_PAIR_KERNEL_TARGETS                                            \
+  __attribute__((target_clones("avx512f", "avx2", "default")))
+#else
+#define BATCHED_PAIR_KERNEL_TARGETS
+#endif
+
+namespace BatchedPairKernel {
+namespace {
+/** Number of candidates processed per block */
+constexpr std::size_t block_size = 64;
+
+/**
+ * @brief Kernel parameters for all type pairs.
+ *
+ * The parameters are stored as a full (symmetric) matrix
+ * in one array per parameter, so that the loads for a block
+ * of candidates can be vectorized.
+ */
+struct Parameters {
+  int n_types = 0;
+  bool applicable = false;
+  bool have_soft_sphere = false;
+
+  std::vector<double> lj_eps, lj_sig, lj_offset, lj_min, lj_cut;
+  std::vector<double> wca_eps, wca_sig, wca_cut;
+  std::vector<double> soft_a, soft_n, soft_offset, soft_cut;
+
+  void resize(std::size_t n) {
+    for (auto v : {&lj_eps, &lj_sig, &lj_offset, &lj_min, &lj_cut, &wca_eps,
+                   &wca_sig, &wca_cut, &soft_a, &soft_n, &soft_offset,
+                   &soft_cut}) {
+      v->assign(n, 0.);
+    }
+  }
+};
+
+Parameters params;
+
+/**
+ * @brief Check if only potentials handled by the kernel are active.
+ */
+bool only_batched_potentials(IA_parameters const &ia) {
+  return not(ia.potentials & ~(NB_LENNARD_JONES | NB_WCA | NB_SOFT_SPHERE));
+}
+
+/** @brief Pair forces and virials of a block of candidates. */
+struct BlockResult {
+  double fx[block_size], fy[block_size], fz[block_size];
+  double vx[block_size], vy[block_size], vz[block_size];
+};
+
+/**
+ * @brief Forces between one particle and a block of candidates.
+ *
+ * Branch-free formulation of the force factors in
+ * lj.hpp, wca.hpp and soft_sphere.hpp: all terms are
+ * evaluated and inactive ones are masked out.
+ */
+template <bool with_soft_sphere>
+inline void block_kernel(Parameters const &p, std::size_t row, double x1,
+                         double y1, double z1, const double *x2,
+                         const double *y2, const double *z2, const int *t2,
+                         std::size_t n, MinimalImage const &mi,
+                         BlockResult &out) {
+  for (std::size_t j = 0; j < n; j++) {
+    auto dx = x1 - x2[j];
+    auto dy = y1 - y2[j];
+    auto dz = z1 - z2[j];
+    dx -= mi.length[0] * std::round(dx * mi.length_inv[0]);
+    dy -= mi.length[1] * std::round(dy * mi.length_inv[1]);
+    dz -= mi.length[2] * std::round(dz * mi.length_inv[2]);
+
+    auto const dist = std::sqrt(dx * dx + dy * dy + dz * dz);
+    auto const k = row + t2[j];
+    double force_factor = 0.;
+
+#ifdef LENNARD_JONES
+    {
+      auto const r_off = dist - p.lj_offset[k];
+      auto const frac6 = Utils::int_pow<6>(p.lj_sig[k] / r_off);
+      auto const f =
+          48.0 * p.lj_eps[k] * frac6 * (frac6 - 0.5) / (r_off * dist);
+      force_factor += ((dist < p.lj_cut[k]) & (dist > p.lj_min[k])) ? f : 0.;
+    }
+#endif
+#ifdef WCA
+    {
+      auto const frac6 = Utils::int_pow<6>(p.wca_sig[k] / dist);
+      auto const f =
+          48.0 * p.wca_eps[k] * frac6 * (frac6 - 0.5) / (dist * dist);
+      force_factor += (dist < p.wca_cut[k]) ? f : 0.;
+    }
+#endif
+#ifdef SOFT_SPHERE
+    if (with_soft_sphere) {
+      auto const r_off = dist - p.soft_offset[k];
+      auto const f =
+          p.soft_a[k] * p.soft_n[k] / std::pow(r_off, p.soft_n[k] + 1) / dist;
+      force_factor += ((dist < p.soft_cut[k]) & (r_off > 0.)) ? f : 0.;
+    }
+#endif
+
+    out.fx[j] = force_factor * dx;
+    out.fy[j] = force_factor * dy;
+    out.fz[j] = force_factor * dz;
+    out.vx[j] = out.fx[j] * dx;
+    out.vy[j] = out.fy[j] * dy;
+    out.vz[j] = out.fz[j] * dz;
+  }
+}
+
+BATCHED_PAIR_KERNEL_TARGETS
+void kernel(Parameters const &p, std::size_t row, double x1, double y1,
+            double z1, const double *x2, const double *y2, const double *z2,
+            const int *t2, std::size_t n, MinimalImage const &mi,
+            BlockResult &out) {
+  block_kernel<false>(p, row, x1, y1, z1, x2, y2, z2, t2, n, mi, out);
+}
+
+BATCHED_PAIR_KERNEL_TARGETS
+void kernel_soft_sphere(Parameters const &p, std::size_t row, double x1,
+                        double y1, double z1, const double *x2,
+                        const double *y2, const double *z2, const int *t2,
+                        std::size_t n, MinimalImage const &mi,
+                        BlockResult &out) {
+  block_kernel<true>(p, row, x1, y1, z1, x2, y2, z2, t2, n, mi, out);
+}
+} // namespace
+
+void update_parameters() {
+  auto const n_types = max_seen_particle_type;
+  auto const n = static_cast<std::size_t>(n_types) * n_types;
+
+  params.n_types = n_types;
+  params.applicable = true;
+  params.have_soft_sphere = false;
+  params.resize(n);
+
+  for (int a = 0; a < n_types; a++) {
+    for (int b = 0; b < n_types; b++) {
+      auto const &ia = *get_ia_param(a, b);
+      auto const k = static_cast<std::size_t>(a) * n_types + b;
+
+      params.applicable &= only_batched_potentials(ia);
+
+#ifdef LENNARD_JONES
+      params.lj_eps[k] = ia.lj.eps;
+      params.lj_sig[k] = ia.lj.sig;
+      params.lj_offset[k] = ia.lj.offset;
+      params.lj_min[k] = ia.lj.min + ia.lj.offset;
+      params.lj_cut[k] = ia.lj.cut + ia.lj.offset;
+#endif
+#ifdef WCA
+      params.wca_eps[k] = ia.wca.eps;
+      params.wca_sig[k] = ia.wca.sig;
+      params.wca_cut[k] = ia.wca.cut;
+#endif
+#ifdef SOFT_SPHERE
+      params.soft_a[k] = ia.soft_sphere.a;
+      params.soft_n[k] = ia.soft_sphere.n;
+      params.soft_offset[k] = ia.soft_sphere.offset;
+      params.soft_cut[k] = ia.soft_sphere.cut + ia.soft_sphere.offset;
+      params.have_soft_sphere |= (ia.potentials & NB_SOFT_SPHERE) != 0;
+#endif
+    }
+  }
+}
+
+bool applicable() {
+  return params.applicable and (params.n_types == max_seen_particle_type);
+}
+
+Utils::Vector3d add_forces(ParticleSoA &soa1, std::size_t i, ParticleSoA &soa2,
+                           std::size_t first, std::size_t last,
+                           MinimalImage const &mi) {
+  assert(applicable());
+
+  BlockResult block;
+
+  auto const pos1 = soa1.pos(i);
+  auto const row = static_cast<std::size_t>(soa1.type(i)) * params.n_types;
+  auto const kernel_ptr =
+      params.have_soft_sphere ? &kernel_soft_sphere : &kernel;
+
+  Utils::Vector3d force1{};
+  Utils::Vector3d virial{};
+  auto fx2 = soa2.force_data(0);
+  auto fy2 = soa2.force_data(1);
+  auto fz2 = soa2.force_data(2);
+
+  for (auto begin = first; begin < last; begin += block_size) {
+    auto const n = std::min(block_size, last - begin);
+
+    kernel_ptr(params, row, pos1[0], pos1[1], pos1[2],
+               soa2.pos_data(0) + begin, soa2.pos_data(1) + begin,
+               soa2.pos_data(2) + begin, soa2.type_data() + begin, n, mi,
+               block);
+
+    for (std::size_t j = 0; j < n; j++) {
+      force1 += Utils::Vector3d{block.fx[j], block.fy[j], block.fz[j]};
+      virial += Utils::Vector3d{block.vx[j], block.vy[j], block.vz[j]};
+      fx2[begin + j] -= block.fx[j];
+      fy2[begin + j] -= block.fy[j];
+      fz2[begin + j] -= block.fz[j];
+    }
+  }
+
+  soa1.add_force(i, force1);
+
+  return virial;
+}
+
+} // namespace BatchedPairKernel
@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2020 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef CORE_NB_IA_BATCHED_PAIR_KERNEL_HPP
+#define CORE_NB_IA_BATCHED_PAIR_KERNEL_HPP
+/** \file
+ *  Batched evaluation of the Lennard-Jones, WCA and soft-sphere
+ *  forces of one particle with a block of neighbor candidates.
+ *
+ *  The kernel works on the structure-of-arrays mirror of the cells
+ *  (@ref ParticleSoA). The inner loop is written without branches,
+ *  so that it can be vectorized by the compiler. On x86-64 it is
+ *  compiled for AVX-512, AVX2 and the baseline instruction set, and
+ *  the variant is selected at runtime according to the capabilities
+ *  of the CPU.
+ *
+ *  Implementation in \ref batched_pair_kernel.cpp.
+ */
+
+#include "BoxGeometry.hpp"
+#include "ParticleSoA.hpp"
+
+#include <utils/Vector.hpp>
+
+#include <cstddef>
+#include <vector>
+
+namespace BatchedPairKernel {
+
+/** @brief Geometry for the minimum image convention in the kernel. */
+struct MinimalImage {
+  /** Box length in periodic directions, 0 otherwise. */
+  Utils::Vector3d length = {};
+  /** Inverse box length in periodic directions, 0 otherwise. */
+  Utils::Vector3d length_inv = {};
+};
+
+/** @brief Minimum image geometry for the periodic directions of @p box. */
+inline MinimalImage minimal_image(BoxGeometry const &box) {
+  MinimalImage mi;
+  for (int i = 0; i < 3; i++) {
+    if (box.periodic(i)) {
+      mi.length[i] = box.length()[i];
+      mi.length_inv[i] = 1. / box.length()[i];
+    }
+  }
+  return mi;
+}
+
+/**
+ * @brief Update the parameter tables of the kernel from the
+ *        non-bonded interaction parameters.
+ *
+ * Has to be called whenever the interaction parameters change.
+ */
+void update_parameters();
+
+/**
+ * @brief Check if the kernel can be used for all type pairs.
+ *
+ * This is the case if no other non-bonded potential than
+ * Lennard-Jones, WCA and soft-sphere is active.
+ */
+bool applicable();
+
+/**
+ * @brief Add the forces between entry @p i of @p soa1 and the
+ *        entries [@p first, @p last) of @p soa2.
+ *
+ * @param soa1 Mirror containing the first particle.
+ * @param i Index of the first particle in @p soa1.
+ * @param soa2 Mirror containing the neighbor candidates.
+ * @param first Index of the first candidate in @p soa2.
+ * @param last One past the index of the last candidate in @p soa2.
+ * @param mi Minimum image geometry, all zero if not needed.
+ * @return Virial contribution of the pairs, i.e. the component-wise
+ *         product of force and distance vector.
+ */
+Utils::Vector3d add_forces(ParticleSoA &soa1, std::size_t i, ParticleSoA &soa2,
+                           std::size_t first, std::size_t last,
+                           MinimalImage const &mi);
+
+} // namespace BatchedPairKernel
+
+#endif
@@ -22,6 +22,7 @@
  *  Implementation of nonbonded_interaction_data.hpp
  */
 #include "nonbonded_interactions/nonbonded_interaction_data.hpp"
+#include "nonbonded_interactions/batched_pair_kernel.hpp"
 #include "bonded_interactions/bonded_interaction_data.hpp"
 #include "communication.hpp"
 #include "errorhandling.hpp"
@@ -178,11 +179,38 @@ static double recalc_maximal_cutoff(const IA_parameters &data) {
   return max_cut_current;
 }
 
-double maximal_cutoff_nonbonded() {
-  auto max_cut_nonbonded = INACTIVE_CUTOFF;
+/** Potentials with a positive cutoff, all others can not contribute
+ *  for any distance.
+ */
+static unsigned recalc_potentials(const IA_parameters &data) {
+  unsigned potentials = 0;
+  for_each_potential_cutoff(
+      data, [&potentials](NonBondedPotential potential, double cut) {
+        if (cut > 0.)
+          potentials |= potential;
+      });
+
+#ifdef THOLE
+  if (data.thole.scaling_coeff != 0.)
+    potentials |= NB_THOLE;
+#endif
+
+  return potentials;
+}
 
+void recalc_nonbonded_ia_params() {
   for (auto &data : ia_params) {
     data.max_cut = recalc_maximal_cutoff(data);
+    data.potentials = recalc_potentials(data);
+  }
+
+  BatchedPairKernel::update_parameters();
+}
+
+double maximal_cutoff_nonbonded() {
+  auto max_cut_nonbonded = INACTIVE_CUTOFF;
+
+  for (auto const &data : ia_params) {
     max_cut_nonbonded = std::max(max_cut_nonbonded, data.max_cut);
   }
 
@@ -223,6 +251,7 @@ void realloc_ia_params(int nsize) {
 
   max_seen_particle_type = nsize;
   std::swap(ia_params, new_params);
+  recalc_nonbonded_ia_params();
 }
 
 void reset_ia_params() {
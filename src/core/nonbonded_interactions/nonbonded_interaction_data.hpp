@@ -181,6 +181,31 @@ struct Thole_Parameters {
   double q1q2;
 };
 
+/** Non-bonded potentials, as bits of @ref IA_parameters::potentials. */
+enum NonBondedPotential : unsigned {
+  NB_LENNARD_JONES = 1u << 0,
+  NB_WCA = 1u << 1,
+  NB_LENNARD_JONES_GENERIC = 1u << 2,
+  NB_SMOOTH_STEP = 1u << 3,
+  NB_HERTZIAN = 1u << 4,
+  NB_GAUSSIAN = 1u << 5,
+  NB_BMHTF_NACL = 1u << 6,
+  NB_BUCKINGHAM = 1u << 7,
+  NB_MORSE = 1u << 8,
+  NB_SOFT_SPHERE = 1u << 9,
+  NB_HAT = 1u << 10,
+  NB_LJCOS = 1u << 11,
+  NB_LJCOS2 = 1u << 12,
+  NB_TABULATED = 1u << 13,
+  NB_THOLE = 1u << 14,
+  NB_GAY_BERNE = 1u << 15,
+};
+
+/** Potentials that only depend on the types and the distance. */
+constexpr unsigned NB_CENTRAL_POTENTIALS = NB_THOLE - 1u;
+/** All non-bonded potentials. */
+constexpr unsigned NB_ALL_POTENTIALS = (NB_GAY_BERNE << 1u) - 1u;
+
 /** Data structure containing the interaction parameters for non-bonded
  *  interactions.
  *  Access via <tt>get_ia_param(i, j)</tt> with
@@ -193,6 +218,13 @@ struct IA_parameters {
    */
   double max_cut = INACTIVE_CUTOFF;
 
+  /** Potentials with a positive cutoff for this pair of particle types,
+   *  as bits of @ref NonBondedPotential. The force kernel is selected
+   *  from this, so that inactive potentials are not evaluated. Like
+   *  @ref max_cut, it is updated by @ref recalc_nonbonded_ia_params.
+   */
+  unsigned potentials = 0u;
+
 #ifdef LENNARD_JONES
   LJ_Parameters lj;
 #endif
@@ -268,6 +300,58 @@ struct IA_parameters {
 
 extern std::vector<IA_parameters> ia_params;
 
+/** Call @p f with every compiled-in non-bonded potential that has a
+ *  cutoff, as @ref NonBondedPotential, and its cutoff in @p data.
+ */
+template <class F>
+void for_each_potential_cutoff(IA_parameters const &data, F f) {
+#ifdef LENNARD_JONES
+  f(NB_LENNARD_JONES, data.lj.cut + data.lj.offset);
+#endif
+#ifdef WCA
+  f(NB_WCA, data.wca.cut);
+#endif
+#ifdef LENNARD_JONES_GENERIC
+  f(NB_LENNARD_JONES_GENERIC, data.ljgen.cut + data.ljgen.offset);
+#endif
+#ifdef SMOOTH_STEP
+  f(NB_SMOOTH_STEP, data.smooth_step.cut);
+#endif
+#ifdef HERTZIAN
+  f(NB_HERTZIAN, data.hertzian.sig);
+#endif
+#ifdef GAUSSIAN
+  f(NB_GAUSSIAN, data.gaussian.cut);
+#endif
+#ifdef BMHTF_NACL
+  f(NB_BMHTF_NACL, data.bmhtf.cut);
+#endif
+#ifdef BUCKINGHAM
+  f(NB_BUCKINGHAM, data.buckingham.cut);
+#endif
+#ifdef MORSE
+  f(NB_MORSE, data.morse.cut);
+#endif
+#ifdef SOFT_SPHERE
+  f(NB_SOFT_SPHERE, data.soft_sphere.cut + data.soft_sphere.offset);
+#endif
+#ifdef HAT
+  f(NB_HAT, data.hat.r);
+#endif
+#ifdef LJCOS
+  f(NB_LJCOS, data.ljcos.cut + data.ljcos.offset);
+#endif
+#ifdef LJCOS2
+  f(NB_LJCOS2, data.ljcos2.cut + data.ljcos2.offset);
+#endif
+#ifdef TABULATED
+  f(NB_TABULATED, data.tab.cutoff());
+#endif
+#ifdef GAY_BERNE
+  f(NB_GAY_BERNE, data.gay_berne.cut);
+#endif
+}
+
 /************************************************
  * exported variables
  ************************************************/
@@ -275,6 +359,13 @@ extern std::vector<IA_parameters> ia_params;
 /** Maximal particle type seen so far. */
 extern int max_seen_particle_type;
 
+/** Recalculate @ref IA_parameters::max_cut and
+ *  @ref IA_parameters::potentials of all type pairs and the parameters
+ *  of the batched pair kernel. Has to be called on all nodes whenever
+ *  the non-bonded interaction parameters change.
+ */
+void recalc_nonbonded_ia_params();
+
 /** Maximal interaction cutoff (real space/short range non-bonded
  *  interactions).
  */
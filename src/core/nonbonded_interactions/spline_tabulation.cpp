@@ -0,0 +1,235 @@
+/*
+ * Copyright (C) 2021 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+/** \file
+ *
+ *  Implementation of \ref spline_tabulation.hpp
+ */
+#include "spline_tabulation.hpp"
+
+#include "communication.hpp"
+#include "electrostatics_magnetostatics/coulomb_inline.hpp"
+#include "electrostatics_magnetostatics/dipole.hpp"
+#include "forces_inline.hpp"
+#include "integrate.hpp"
+#include "nonbonded_interactions/nonbonded_interaction_data.hpp"
+#include "thermostat.hpp"
+
+#include <utils/index.hpp>
+#include <utils/math/sqr.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace SplineTabulation {
+namespace {
+/** Number of intervals of the first attempt of a table */
+constexpr int min_intervals = 64;
+/** Largest number of intervals of a table */
+constexpr int max_intervals = 1 << 16;
+
+double m_tolerance = 0.;
+double m_min_distance = 0.;
+bool m_valid = false;
+Tables m_tables;
+
+/**
+ * @brief Tabulate a force factor between @p min_dist and @p cut.
+ *
+ * The intervals are refined until the deviation is below
+ * @p tolerance, or the largest number of intervals is reached.
+ * The force factors vanish at the cutoff, so the last sample is
+ * taken just below it.
+ */
+template <class F>
+Table make_table(F force_factor, double min_dist, double cut,
+                 double tolerance) {
+  Table table;
+  if (cut <= min_dist)
+    return table;
+
+  auto const below_cut = std::nextafter(cut, 0.);
+  auto const f = [&force_factor, below_cut](double dist2) {
+    return force_factor(std::min(std::sqrt(dist2), below_cut));
+  };
+
+  for (int n = min_intervals;; n *= 2) {
+    table.spline =
+        CubicSplineTable(f, Utils::sqr(min_dist), Utils::sqr(cut), n);
+    table.deviation = table.spline.max_relative_deviation(f);
+    table.converged = table.deviation <= tolerance;
+    if (table.converged or 2 * n > max_intervals)
+      return table;
+  }
+}
+
+/** Cutoff of the central potentials of a type pair. */
+double central_cutoff(IA_parameters const &ia) {
+  auto cut = INACTIVE_CUTOFF;
+  for_each_potential_cutoff(ia, [&cut](NonBondedPotential potential,
+                                       double potential_cut) {
+    if (potential & NB_CENTRAL_POTENTIALS)
+      cut = std::max(cut, potential_cut);
+  });
+  return cut;
+}
+
+#ifdef ELECTROSTATICS
+/** Real-space cutoff of the electrostatics, if their pair force is
+ *  central and proportional to the charge product, else -1. */
+double coulomb_real_space_cutoff() {
+  switch (coulomb.method) {
+  case COULOMB_NONE:
+    return 0.;
+#ifdef P3M
+  case COULOMB_ELC_P3M:
+    if (elc_params.dielectric_contrast_on)
+      return INACTIVE_CUTOFF;
+    return p3m.params.r_cut;
+  case COULOMB_P3M_GPU:
+  case COULOMB_P3M:
+    return p3m.params.r_cut;
+#endif
+  case COULOMB_DH:
+    return dh_params.r_cut;
+  case COULOMB_RF:
+    return rf_params.r_cut;
+  default:
+    return INACTIVE_CUTOFF;
+  }
+}
+#endif
+
+void build_tables() {
+  auto const n_types = max_seen_particle_type;
+  auto const n_pairs = static_cast<std::size_t>(n_types * (n_types + 1) / 2);
+
+  m_tables.n_types = n_types;
+  m_tables.min_dist2 = Utils::sqr(m_min_distance);
+  m_tables.pairs.assign(n_pairs, Table{});
+  m_tables.pair_tabulated.assign(n_pairs, false);
+
+  for (int a = 0; a < n_types; a++) {
+    for (int b = a; b < n_types; b++) {
+      auto const &ia = *get_ia_param(a, b);
+      auto const i = Utils::upper_triangular(a, b, n_types);
+
+      /* Thole and Gay-Berne are not central */
+      if (ia.potentials & ~NB_CENTRAL_POTENTIALS)
+        continue;
+
+      m_tables.pairs[i] = make_table(
+          [&ia](double dist) {
+            return calc_central_radial_force_factor(ia, dist);
+          },
+          m_min_distance, central_cutoff(ia), m_tolerance);
+      m_tables.pair_tabulated[i] = m_tables.pairs[i].converged;
+    }
+  }
+
+  m_tables.coulomb = Table{};
+  m_tables.coulomb_tabulated = true;
+#ifdef ELECTROSTATICS
+  auto const coulomb_cut = coulomb_real_space_cutoff();
+  if (coulomb_cut == INACTIVE_CUTOFF) {
+    m_tables.coulomb_tabulated = false;
+  } else {
+    m_tables.coulomb = make_table(
+        [](double dist) {
+          return Coulomb::central_force(1., {dist, 0., 0.}, dist)[0] / dist;
+        },
+        m_min_distance, coulomb_cut, m_tolerance);
+    m_tables.coulomb_tabulated = m_tables.coulomb.converged;
+  }
+#endif
+
+  m_valid = true;
+}
+
+void set_parameters_local(double tolerance, double min_distance) {
+  m_tolerance = tolerance;
+  m_min_distance = min_distance;
+  invalidate();
+  recalc_forces = true;
+}
+
+REGISTER_CALLBACK(set_parameters_local)
+} // namespace
+
+Table const *Tables::pair(int a, int b) const {
+  if (a >= n_types or b >= n_types)
+    return nullptr;
+
+  auto const i =
+      Utils::upper_triangular(std::min(a, b), std::max(a, b), n_types);
+  return pair_tabulated[i] ? &pairs[i] : nullptr;
+}
+
+void set_parameters(double tolerance, double min_distance) {
+  mpi_call_all(set_parameters_local, tolerance, min_distance);
+}
+
+double tolerance() { return m_tolerance; }
+double min_distance() { return m_min_distance; }
+
+void invalidate() {
+  m_valid = false;
+  m_tables = Tables{};
+}
+
+Tables const *tables() {
+  if (m_tolerance <= 0.)
+    return nullptr;
+
+#ifdef DPD
+  if (thermo_switch & THERMO_DPD)
+    return nullptr;
+#endif
+#ifdef DIPOLES
+  if (dipole.method != DIPOLAR_NONE)
+    return nullptr;
+#endif
+
+  if (not m_valid or m_tables.n_types != max_seen_particle_type)
+    build_tables();
+
+  return &m_tables;
+}
+
+std::vector<Info> info() {
+  std::vector<Info> result;
+  auto const t = tables();
+  if (not t)
+    return result;
+
+  for (int a = 0; a < t->n_types; a++) {
+    for (int b = a; b < t->n_types; b++) {
+      auto const i = Utils::upper_triangular(a, b, t->n_types);
+      auto const &table = t->pairs[i];
+      result.push_back({a, b, table.spline.n_intervals(), table.deviation,
+                        static_cast<bool>(t->pair_tabulated[i])});
+    }
+  }
+  result.push_back({-1, -1, t->coulomb.spline.n_intervals(),
+                    t->coulomb.deviation, t->coulomb_tabulated});
+
+  return result;
+}
+} // namespace SplineTabulation
@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) 2021 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef CORE_NB_IA_SPLINE_TABULATION_HPP
+#define CORE_NB_IA_SPLINE_TABULATION_HPP
+/** \file
+ *  Cubic spline tables of the non-bonded pair forces.
+ *
+ *  When enabled, the force factor of the central non-bonded potentials
+ *  of every type pair, and the force factor of the real-space
+ *  electrostatics for a unit charge product, are sampled into cubic
+ *  spline tables in the squared distance. The pair loop then evaluates
+ *  the forces by table lookups, without square root and without the
+ *  analytic expressions of the potentials.
+ *
+ *  The number of intervals of a table is doubled until the deviation
+ *  from the analytic force factor is below the requested tolerance.
+ *  Type pairs for which this fails or that have non-central potentials,
+ *  and particles closer than the minimal distance, are evaluated
+ *  analytically. The tables are rebuilt on first use after a change
+ *  of the interactions or the box.
+ *
+ *  Implementation in spline_tabulation.cpp.
+ */
+
+#include "CubicSplineTable.hpp"
+
+#include <vector>
+
+namespace SplineTabulation {
+
+/** @brief Force factor of an interaction as function of the squared
+ *         distance, zero beyond the end of the table. */
+struct Table {
+  CubicSplineTable spline;
+  /** Largest relative deviation from the analytic force factor,
+   *  see @ref CubicSplineTable::max_relative_deviation. */
+  double deviation = 0.;
+  /** Whether the deviation is below the tolerance. */
+  bool converged = true;
+
+  /** Force factor at squared distance @p dist2, which has to be
+   *  at least the squared minimal distance of the tables. */
+  double operator()(double dist2) const {
+    return (dist2 < spline.maxval()) ? spline(dist2) : 0.;
+  }
+};
+
+/** @brief Tables of all type pairs. */
+struct Tables {
+  int n_types = 0;
+  /** Squared minimal distance, closer pairs are evaluated analytically. */
+  double min_dist2 = 0.;
+  /** Central potentials by type pair, upper triangular. */
+  std::vector<Table> pairs;
+  /** Whether a type pair is evaluated from the table. */
+  std::vector<char> pair_tabulated;
+  /** Real-space electrostatics for a unit charge product. */
+  Table coulomb;
+  /** Whether the electrostatics are evaluated from the table. */
+  bool coulomb_tabulated = false;
+
+  /** Table of a type pair, nullptr if the pair has to be
+   *  evaluated analytically. */
+  Table const *pair(int a, int b) const;
+};
+
+/** @brief Summary of a table. */
+struct Info {
+  /** Particle types, -1 for the electrostatics */
+  int type_a;
+  int type_b;
+  int n_intervals;
+  double deviation;
+  /** Whether the table is used in the force calculation */
+  bool tabulated;
+};
+
+/**
+ * @brief Enable the tables.
+ *
+ * @param tolerance Largest relative deviation of a table from the
+ *                  analytic force factor, 0 disables the tables.
+ * @param min_distance Pairs closer than this are evaluated analytically.
+ */
+void set_parameters(double tolerance, double min_distance);
+double tolerance();
+double min_distance();
+
+/** @brief Discard the tables, they are rebuilt on their next use.
+ *
+ *  Has to be called whenever the interactions or the box change.
+ */
+void invalidate();
+
+/**
+ * @brief Tables for the force calculation.
+ *
+ * The tables are rebuilt if they were invalidated.
+ *
+ * @return The tables, or nullptr if they are disabled, or if
+ *         interactions are active that can only be evaluated
+ *         analytically for all pairs (DPD, magnetostatics).
+ */
+Tables const *tables();
+
+/** @brief Summary of the tables on this node, which are the same on
+ *         all nodes. Empty if the tables are not in use. */
+std::vector<Info> info();
+
+} // namespace SplineTabulation
+
+#endif
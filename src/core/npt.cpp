@@ -71,4 +71,12 @@ void npt_add_virial_contribution(const Utils::Vector3d &force,
     }
   }
 }
+
+void npt_add_virial_contribution(const Utils::Vector3d &virial) {
+  if (integ_switch == INTEG_METHOD_NPT_ISO) {
+    for (int j = 0; j < 3; j++) {
+      nptiso.p_vir[j] += virial[j];
+    }
+  }
+}
 #endif // NPT
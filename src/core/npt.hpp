@@ -92,4 +92,6 @@ void integrator_npt_sanity_checks();
 void npt_reset_instantaneous_virials();
 void npt_add_virial_contribution(const Utils::Vector3d &force,
                                  const Utils::Vector3d &d);
+/** Add the component-wise sum of force times distance of several pairs. */
+void npt_add_virial_contribution(const Utils::Vector3d &virial);
 #endif
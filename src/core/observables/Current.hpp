@@ -24,9 +24,9 @@
 #include <vector>
 
 namespace Observables {
-class Current : public PidObservable {
+class Current : public PidReduction<Current> {
 public:
-  using PidObservable::PidObservable;
+  using PidReduction<Current>::PidReduction;
   std::vector<size_t> shape() const override { return {3}; }
 
   std::vector<double>
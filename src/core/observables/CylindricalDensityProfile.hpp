@@ -20,13 +20,17 @@
 #define OBSERVABLES_CYLINDRICALDENSITYPROFILE_HPP
 
 #include "CylindricalPidProfileObservable.hpp"
+#include "grid.hpp"
 #include <utils/Histogram.hpp>
 #include <utils/math/coordinate_transformation.hpp>
 
 namespace Observables {
-class CylindricalDensityProfile : public CylindricalPidProfileObservable {
+class CylindricalDensityProfile
+    : public PidReduction<CylindricalDensityProfile,
+                          CylindricalPidProfileObservable> {
 public:
-  using CylindricalPidProfileObservable::CylindricalPidProfileObservable;
+  using PidReduction<CylindricalDensityProfile,
+                     CylindricalPidProfileObservable>::PidReduction;
   std::vector<double>
   evaluate(Utils::Span<std::reference_wrapper<const Particle>> particles,
            const ParticleObservables::traits<Particle> &traits) const override {
@@ -20,13 +20,17 @@
 #define OBSERVABLES_CYLINDRICALFLUXDENSITYPROFILE_HPP
 
 #include "CylindricalPidProfileObservable.hpp"
+#include "grid.hpp"
 #include "integrate.hpp"
 #include <utils/Histogram.hpp>
 
 namespace Observables {
-class CylindricalFluxDensityProfile : public CylindricalPidProfileObservable {
+class CylindricalFluxDensityProfile
+    : public PidReduction<CylindricalFluxDensityProfile,
+                          CylindricalPidProfileObservable> {
 public:
-  using CylindricalPidProfileObservable::CylindricalPidProfileObservable;
+  using PidReduction<CylindricalFluxDensityProfile,
+                     CylindricalPidProfileObservable>::PidReduction;
 
   std::vector<double>
   evaluate(Utils::Span<std::reference_wrapper<const Particle>> particles,
@@ -22,6 +22,11 @@
 #include "CylindricalProfileObservable.hpp"
 #include "PidObservable.hpp"
 
+#include <utils/Vector.hpp>
+
+#include <tuple>
+#include <vector>
+
 namespace Observables {
 
 class CylindricalPidProfileObservable : public PidObservable,
@@ -37,6 +42,17 @@ public:
         CylindricalProfileObservable(center, axis, min_r, max_r, min_phi,
                                      max_phi, min_z, max_z, n_r_bins,
                                      n_phi_bins, n_z_bins) {}
+
+  /** Constructor arguments, to create a copy of the observable on the
+   *  other nodes. */
+  std::tuple<std::vector<int>, Utils::Vector3d, Utils::Vector3d, int, int, int,
+             double, double, double, double, double, double>
+  arguments() const {
+    return std::make_tuple(ids(), center, axis, static_cast<int>(n_r_bins),
+                           static_cast<int>(n_phi_bins),
+                           static_cast<int>(n_z_bins), min_r, min_phi, min_z,
+                           max_r, max_phi, max_z);
+  }
 };
 
 } // Namespace Observables
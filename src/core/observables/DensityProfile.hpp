@@ -20,14 +20,16 @@
 #define OBSERVABLES_DENSITYPROFILE_HPP
 
 #include "PidProfileObservable.hpp"
+#include "grid.hpp"
 #include <utils/Histogram.hpp>
 #include <vector>
 
 namespace Observables {
 
-class DensityProfile : public PidProfileObservable {
+class DensityProfile
+    : public PidReduction<DensityProfile, PidProfileObservable> {
 public:
-  using PidProfileObservable::PidProfileObservable;
+  using PidReduction<DensityProfile, PidProfileObservable>::PidReduction;
 
   std::vector<double>
   evaluate(Utils::Span<std::reference_wrapper<const Particle>> particles,
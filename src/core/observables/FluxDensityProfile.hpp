@@ -20,13 +20,15 @@
 #define OBSERVABLES_FLUXDENSITYPROFILE_HPP
 
 #include "PidProfileObservable.hpp"
+#include "grid.hpp"
 
 #include <vector>
 
 namespace Observables {
-class FluxDensityProfile : public PidProfileObservable {
+class FluxDensityProfile
+    : public PidReduction<FluxDensityProfile, PidProfileObservable> {
 public:
-  using PidProfileObservable::PidProfileObservable;
+  using PidReduction<FluxDensityProfile, PidProfileObservable>::PidReduction;
   std::vector<size_t> shape() const override {
     return {n_x_bins, n_y_bins, n_z_bins, 3};
   }
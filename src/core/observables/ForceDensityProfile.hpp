@@ -20,14 +20,16 @@
 #define OBSERVABLES_FORCEDENSITYPROFILE_HPP
 
 #include "PidProfileObservable.hpp"
+#include "grid.hpp"
 
 #include <vector>
 
 namespace Observables {
 
-class ForceDensityProfile : public PidProfileObservable {
+class ForceDensityProfile
+    : public PidReduction<ForceDensityProfile, PidProfileObservable> {
 public:
-  using PidProfileObservable::PidProfileObservable;
+  using PidReduction<ForceDensityProfile, PidProfileObservable>::PidReduction;
   std::vector<size_t> shape() const override {
     return {n_x_bins, n_y_bins, n_z_bins, 3};
   }
@@ -18,12 +18,45 @@
  */
 #include "PidObservable.hpp"
 
+#include "ComPosition.hpp"
+#include "ComVelocity.hpp"
+#include "Current.hpp"
+#include "CylindricalDensityProfile.hpp"
+#include "CylindricalFluxDensityProfile.hpp"
+#include "DensityProfile.hpp"
+#include "DipoleMoment.hpp"
+#include "FluxDensityProfile.hpp"
+#include "ForceDensityProfile.hpp"
+#include "MagneticDipoleMoment.hpp"
+#include "TotalForce.hpp"
+
+#include "cells.hpp"
 #include "fetch_particles.hpp"
+#include "grid.hpp"
 #include "particle_data.hpp"
 
+#include <utils/Vector.hpp>
+
 #include <functional>
 
 namespace Observables {
+namespace detail {
+std::vector<Particle> fetch_local_particles(std::vector<int> const &ids) {
+  std::vector<Particle> particles;
+  for (auto const id : ids) {
+    auto const p = cell_structure.get_local_particle(id);
+    if (p and not p->l.ghost) {
+      particles.push_back(*p);
+
+      auto &p_copy = particles.back();
+      p_copy.r.p += image_shift(p_copy.l.i, box_geo.length());
+      p_copy.l.i = {};
+    }
+  }
+  return particles;
+}
+} // namespace detail
+
 std::vector<double> PidObservable::operator()() const {
   std::vector<Particle> particles = fetch_particles(ids());
 
@@ -33,3 +66,38 @@ std::vector<double> PidObservable::operator()() const {
                         ParticleObservables::traits<Particle>{});
 }
 } // namespace Observables
+
+/** @name Callbacks of the reduction observables
+ *  Argument types have to match the tuple returned by `arguments()`.
+ */
+/*@{*/
+#define REGISTER_PID_REDUCTION(name, ...)                                      \
+  namespace Communication {                                                    \
+  static ::Communication::RegisterCallback register_pid_reduction_##name(      \
+      ::Communication::Result::MasterRank{},                                   \
+      &::Observables::detail::pid_reduction_local<::Observables::name,         \
+                                                  __VA_ARGS__>);               \
+  }
+
+#define PID_ARGUMENTS std::vector<int>
+#define PID_PROFILE_ARGUMENTS                                                  \
+  std::vector<int>, int, int, int, double, double, double, double, double,     \
+      double
+#define CYLINDRICAL_PID_PROFILE_ARGUMENTS                                      \
+  std::vector<int>, Utils::Vector3d, Utils::Vector3d, int, int, int, double,   \
+      double, double, double, double, double
+
+REGISTER_PID_REDUCTION(ComPosition, PID_ARGUMENTS)
+REGISTER_PID_REDUCTION(ComVelocity, PID_ARGUMENTS)
+REGISTER_PID_REDUCTION(Current, PID_ARGUMENTS)
+REGISTER_PID_REDUCTION(DipoleMoment, PID_ARGUMENTS)
+REGISTER_PID_REDUCTION(MagneticDipoleMoment, PID_ARGUMENTS)
+REGISTER_PID_REDUCTION(TotalForce, PID_ARGUMENTS)
+REGISTER_PID_REDUCTION(DensityProfile, PID_PROFILE_ARGUMENTS)
+REGISTER_PID_REDUCTION(FluxDensityProfile, PID_PROFILE_ARGUMENTS)
+REGISTER_PID_REDUCTION(ForceDensityProfile, PID_PROFILE_ARGUMENTS)
+REGISTER_PID_REDUCTION(CylindricalDensityProfile,
+                       CYLINDRICAL_PID_PROFILE_ARGUMENTS)
+REGISTER_PID_REDUCTION(CylindricalFluxDensityProfile,
+                       CYLINDRICAL_PID_PROFILE_ARGUMENTS)
+/*@}*/
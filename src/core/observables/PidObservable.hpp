@@ -25,10 +25,18 @@
 #include "Observable.hpp"
 #include "Particle.hpp"
 #include "ParticleTraits.hpp"
+#include "communication.hpp"
 
 #include <utils/Span.hpp>
 #include <utils/flatten.hpp>
+#include <utils/tuple.hpp>
 
+#include <boost/mpi/collectives/reduce.hpp>
+
+#include <functional>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
 #include <vector>
 
 namespace Observables {
@@ -45,16 +53,104 @@ class PidObservable : virtual public Observable {
   /** Identifiers of particles measured by this observable */
   std::vector<int> m_ids;
 
+public:
+  explicit PidObservable(std::vector<int> ids) : m_ids(std::move(ids)) {}
+  std::vector<double> operator()() const override;
+
   virtual std::vector<double>
   evaluate(ParticleReferenceRange particles,
            const ParticleObservables::traits<Particle> &traits) const = 0;
 
-public:
-  explicit PidObservable(std::vector<int> ids) : m_ids(std::move(ids)) {}
-  std::vector<double> operator()() const final;
-
   std::vector<int> &ids() { return m_ids; }
   std::vector<int> const &ids() const { return m_ids; }
+
+  /** Constructor arguments, to create a copy of the observable on the
+   *  other nodes. */
+  std::tuple<std::vector<int>> arguments() const {
+    return std::make_tuple(m_ids);
+  }
+};
+
+namespace detail {
+/** Copies of the particles with the given ids which are local to this
+ *  node, with positions in the current box like in @ref fetch_particles.
+ */
+std::vector<Particle> fetch_local_particles(std::vector<int> const &ids);
+
+/**
+ * @brief Partial result of an observable for the local particles, summed
+ * up over all nodes.
+ *
+ * Every node creates its instance of the observable from @p args.
+ * The number of particles found is appended to the result.
+ */
+template <class Obs, class... Args>
+std::vector<double> pid_reduction_local(Args... args) {
+  Obs const obs(args...);
+  auto const particles = fetch_local_particles(obs.ids());
+  std::vector<std::reference_wrapper<const Particle>> particle_refs(
+      particles.begin(), particles.end());
+
+  auto partial = obs.evaluate_partial(ParticleReferenceRange(particle_refs),
+                                      ParticleObservables::traits<Particle>{});
+  partial.push_back(static_cast<double>(particles.size()));
+
+  std::vector<double> result(partial.size());
+  boost::mpi::reduce(comm_cart, partial.data(),
+                     static_cast<int>(partial.size()), result.data(),
+                     std::plus<double>(), 0);
+  return result;
+}
+} // namespace detail
+
+/**
+ * @brief %Particle-based observable which is a reduction over its particles.
+ *
+ * Sums, averages and histograms over particles are evaluated by each node
+ * for its local particles, and only the partial results are summed up on
+ * the head node, instead of fetching the particles to the head node.
+ * The partial result is given by @c evaluate_partial, and turned into the
+ * value of the observable by @c finalize; both may be hidden in @p Derived.
+ * The default is a plain sum of @c evaluate over the nodes.
+ *
+ * @tparam Derived  The observable, it has to be constructible from
+ *                  the tuple returned by `arguments()`.
+ * @tparam Base     Base class of the observable.
+ */
+template <class Derived, class Base = PidObservable>
+class PidReduction : public Base {
+public:
+  using Base::Base;
+
+  std::vector<double> operator()() const override {
+    auto const &derived = static_cast<Derived const &>(*this);
+    auto partial = Utils::apply(
+        [](auto const &... args) {
+          return mpi_call(
+              ::Communication::Result::master_rank,
+              detail::pid_reduction_local<Derived,
+                                          std::decay_t<decltype(args)>...>,
+              args...);
+        },
+        derived.arguments());
+
+    auto const n_found = static_cast<std::size_t>(partial.back());
+    partial.pop_back();
+    if (n_found != this->ids().size()) {
+      throw std::runtime_error("Particles of the observable not found");
+    }
+    return derived.finalize(std::move(partial));
+  }
+
+  std::vector<double>
+  evaluate_partial(ParticleReferenceRange particles,
+                   const ParticleObservables::traits<Particle> &traits) const {
+    return this->evaluate(particles, traits);
+  }
+
+  std::vector<double> finalize(std::vector<double> partial) const {
+    return partial;
+  }
 };
 
 namespace detail {
@@ -79,6 +175,13 @@ template <class T> struct shape_impl<std::vector<T>> {
     return ret;
   }
 };
+
+template <class ObsType> std::vector<size_t> shape(size_t n_part) {
+  using std::declval;
+
+  return shape_impl<decltype(
+      declval<ObsType>()(declval<ParticleReferenceRange>()))>::eval(n_part);
+}
 } // namespace detail
 
 /**
@@ -99,10 +202,29 @@ template <class ObsType> class ParticleObservable : public PidObservable {
 public:
   using PidObservable::PidObservable;
   std::vector<size_t> shape() const override {
-    using std::declval;
+    return detail::shape<ObsType>(ids().size());
+  }
+
+  std::vector<double>
+  evaluate(ParticleReferenceRange particles,
+           const ParticleObservables::traits<Particle> &traits) const override {
+    std::vector<double> res;
+    Utils::flatten(ObsType{}(particles), std::back_inserter(res));
+    return res;
+  }
+};
+
+/** Sums of a particle property are added up over the nodes. */
+template <class ValueOp>
+class ParticleObservable<ParticleObservables::Sum<ValueOp>>
+    : public PidReduction<
+          ParticleObservable<ParticleObservables::Sum<ValueOp>>> {
+  using ObsType = ParticleObservables::Sum<ValueOp>;
 
-    return detail::shape_impl<decltype(declval<ObsType>()(
-        declval<ParticleReferenceRange>()))>::eval(ids().size());
+public:
+  using PidReduction<ParticleObservable<ObsType>>::PidReduction;
+  std::vector<size_t> shape() const override {
+    return detail::shape<ObsType>(this->ids().size());
   }
 
   std::vector<double>
@@ -114,5 +236,53 @@ public:
   }
 };
 
+/** Weighted averages of a particle property are built from the weighted sums
+ *  and the sums of the weights of all nodes. */
+template <class ValueOp, class WeightOp>
+class ParticleObservable<
+    ParticleObservables::WeightedAverage<ValueOp, WeightOp>>
+    : public PidReduction<ParticleObservable<
+          ParticleObservables::WeightedAverage<ValueOp, WeightOp>>> {
+  using ObsType = ParticleObservables::WeightedAverage<ValueOp, WeightOp>;
+
+public:
+  using PidReduction<ParticleObservable<ObsType>>::PidReduction;
+  std::vector<size_t> shape() const override {
+    return detail::shape<ObsType>(this->ids().size());
+  }
+
+  std::vector<double>
+  evaluate(ParticleReferenceRange particles,
+           const ParticleObservables::traits<Particle> &traits) const override {
+    std::vector<double> res;
+    Utils::flatten(ObsType{}(particles), std::back_inserter(res));
+    return res;
+  }
+
+  /** Weighted sum, followed by the sum of the weights */
+  std::vector<double>
+  evaluate_partial(ParticleReferenceRange particles,
+                   const ParticleObservables::traits<Particle> &traits) const {
+    auto const ws =
+        ParticleObservables::detail::WeightedSum<ValueOp, WeightOp>{}(
+            particles);
+    std::vector<double> res;
+    Utils::flatten(ws.first, std::back_inserter(res));
+    res.push_back(static_cast<double>(ws.second));
+    return res;
+  }
+
+  std::vector<double> finalize(std::vector<double> partial) const {
+    auto const weight = partial.back();
+    partial.pop_back();
+    if (weight != 0.) {
+      for (auto &v : partial) {
+        v /= weight;
+      }
+    }
+    return partial;
+  }
+};
+
 } // namespace Observables
 #endif
@@ -24,6 +24,7 @@
 #include "PidObservable.hpp"
 #include "ProfileObservable.hpp"
 #include "integrate.hpp"
+#include <tuple>
 #include <vector>
 
 namespace Observables {
@@ -37,6 +38,17 @@ public:
       : PidObservable(ids),
         ProfileObservable(min_x, max_x, min_y, max_y, min_z, max_z, n_x_bins,
                           n_y_bins, n_z_bins) {}
+
+  /** Constructor arguments, to create a copy of the observable on the
+   *  other nodes. */
+  std::tuple<std::vector<int>, int, int, int, double, double, double, double,
+             double, double>
+  arguments() const {
+    return std::make_tuple(ids(), static_cast<int>(n_x_bins),
+                           static_cast<int>(n_y_bins),
+                           static_cast<int>(n_z_bins), min_x, min_y, min_z,
+                           max_x, max_y, max_z);
+  }
 };
 
 } // Namespace Observables
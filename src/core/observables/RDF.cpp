@@ -18,18 +18,140 @@
  */
 #include "RDF.hpp"
 
+#include "cells.hpp"
+#include "communication.hpp"
+#include "event.hpp"
 #include "fetch_particles.hpp"
+#include "grid.hpp"
+#include "nonbonded_interactions/nonbonded_interaction_data.hpp"
 #include "particle_data.hpp"
+#include "short_range_loop.hpp"
 
 #include <utils/for_each_pair.hpp>
 #include <utils/math/int_pow.hpp>
 
+#include <boost/mpi/collectives/reduce.hpp>
+#include <boost/range/algorithm/max_element.hpp>
+#include <boost/range/algorithm/min_element.hpp>
 #include <boost/range/algorithm/transform.hpp>
+
+#include <algorithm>
 #include <cmath>
+#include <cstdint>
 #include <functional>
 
 namespace Observables {
+namespace {
+/** Selection flags of the particles, indexed by particle id. */
+enum Selection : std::uint8_t { IN_IDS1 = 1u, IN_IDS2 = 2u };
+
+std::vector<std::uint8_t> selection_flags(std::vector<int> const &ids1,
+                                          std::vector<int> const &ids2) {
+  auto const max_id = std::max(ids1.empty() ? -1 : *boost::max_element(ids1),
+                               ids2.empty() ? -1 : *boost::max_element(ids2));
+  std::vector<std::uint8_t> flags(max_id + 1, 0u);
+  for (auto const id : ids1)
+    flags[id] |= IN_IDS1;
+  for (auto const id : ids2)
+    flags[id] |= IN_IDS2;
+  return flags;
+}
+} // namespace
+
+/**
+ * @brief Histogram of the pair distances of an RDF.
+ *
+ * Visits the pairs of the local particles with the particles in the
+ * neighbor cells, including ghosts, so every pair within the range
+ * of the cells is binned on exactly one node. The local histograms
+ * are summed up on the head node.
+ */
+static std::vector<double> rdf_histogram_slave(std::vector<int> ids1,
+                                               std::vector<int> ids2,
+                                               double min_r, double max_r,
+                                               int n_r_bins) {
+  on_observable_calc();
+
+  auto const flags = selection_flags(ids1, ids2);
+  auto const flag = [&flags](Particle const &p) -> std::uint8_t {
+    auto const id = static_cast<std::size_t>(p.identity());
+    return (id < flags.size()) ? flags[id] : 0u;
+  };
+  auto const same_sets = ids2.empty();
+
+  auto const inv_bin_width = static_cast<double>(n_r_bins) / (max_r - min_r);
+  auto const min_r2 = min_r * min_r;
+  auto const max_r2 = max_r * max_r;
+  std::vector<double> hist(n_r_bins, 0.0);
+
+  auto const kernel = [&](Particle const &p1, Particle const &p2,
+                          Distance const &d) {
+    if (d.dist2 <= min_r2 or d.dist2 >= max_r2)
+      return;
+    auto const f1 = flag(p1);
+    auto const f2 = flag(p2);
+    /* Ordered pairs (ids1, ids2) are counted in both directions,
+     * unordered pairs within ids1 once. */
+    auto const n =
+        same_sets ? static_cast<int>((f1 & IN_IDS1) and (f2 & IN_IDS1))
+                  : static_cast<int>((f1 & IN_IDS1) and (f2 & IN_IDS2)) +
+                        static_cast<int>((f2 & IN_IDS1) and (f1 & IN_IDS2));
+    if (n) {
+      auto const ind = std::min(
+          static_cast<int>((std::sqrt(d.dist2) - min_r) * inv_bin_width),
+          n_r_bins - 1);
+      hist[ind] += n;
+    }
+  };
+
+  auto first =
+      boost::make_indirect_iterator(cell_structure.local_cells().begin());
+  auto last = boost::make_indirect_iterator(cell_structure.local_cells().end());
+  if (cell_structure.minimum_image_distance()) {
+    Algorithm::link_cell(first, last, [](Particle const &) {}, kernel,
+                         detail::MinimalImageDistance{box_geo});
+  } else {
+    Algorithm::link_cell(first, last, [](Particle const &) {}, kernel,
+                         detail::EuclidianDistance{});
+  }
+
+  std::vector<double> result(n_r_bins, 0.0);
+  boost::mpi::reduce(comm_cart, hist.data(), n_r_bins, result.data(),
+                     std::plus<double>(), 0);
+  return result;
+}
+
+REGISTER_CALLBACK_MASTER_RANK(rdf_histogram_slave)
+
+bool RDF::use_cell_lists() const {
+  /* Beyond half the box, the minimum image of a pair is not unique. */
+  auto const range = std::min(cells_neighbor_search_range(),
+                              0.5 * *boost::min_element(box_geo.length()));
+  return max_r <= range;
+}
+
 std::vector<double> RDF::operator()() const {
+  if (use_cell_lists()) {
+    auto hist = mpi_call(::Communication::Result::master_rank,
+                         rdf_histogram_slave, ids1(), ids2(), min_r, max_r,
+                         static_cast<int>(n_r_bins));
+
+    /* Number of pairs, the same particle is never paired with itself. */
+    auto const n1 = static_cast<long int>(ids1().size());
+    long int cnt = 0;
+    if (ids2().empty()) {
+      cnt = n1 * (n1 - 1) / 2;
+    } else {
+      auto const flags = selection_flags(ids1(), ids2());
+      auto const n_common =
+          std::count_if(ids1().begin(), ids1().end(),
+                        [&flags](int id) { return flags[id] & IN_IDS2; });
+      cnt = n1 * static_cast<long int>(ids2().size()) - n_common;
+    }
+    normalize(hist, cnt);
+    return hist;
+  }
+
   std::vector<Particle> particles1 = fetch_particles(ids1());
   std::vector<const Particle *> particles_ptrs1(particles1.size());
   boost::transform(particles1, particles_ptrs1.begin(),
@@ -66,12 +188,22 @@ RDF::evaluate(Utils::Span<const Particle *const> particles1,
   if (particles2.empty()) {
     Utils::for_each_pair(particles1, op);
   } else {
-    auto cmp = std::not_equal_to<const Particle *const>();
+    /* The particles are fetched separately for both sets, so the
+     * self-pairs of particles in both sets are excluded by id. */
+    auto cmp = [](const Particle *const p1, const Particle *const p2) {
+      return p1->identity() != p2->identity();
+    };
     Utils::for_each_cartesian_pair_if(particles1, particles2, op, cmp);
   }
-  if (cnt == 0)
-    return res;
-  // normalization
+  normalize(res, cnt);
+
+  return res;
+}
+
+void RDF::normalize(std::vector<double> &hist, long int n_pairs) const {
+  if (n_pairs == 0)
+    return;
+  auto const bin_width = (max_r - min_r) / static_cast<double>(n_r_bins);
   auto const volume = box_geo.volume();
   for (int i = 0; i < n_r_bins; ++i) {
     auto const r_in = i * bin_width + min_r;
@@ -79,9 +211,7 @@ RDF::evaluate(Utils::Span<const Particle *const> particles1,
     auto const bin_volume =
         (4.0 / 3.0) * Utils::pi() *
         (Utils::int_pow<3>(r_out) - Utils::int_pow<3>(r_in));
-    res[i] *= volume / (bin_volume * static_cast<double>(cnt));
+    hist[i] *= volume / (bin_volume * static_cast<double>(n_pairs));
   }
-
-  return res;
 }
 } // namespace Observables
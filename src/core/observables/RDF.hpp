@@ -41,6 +41,9 @@ class RDF : public Observable {
   evaluate(Utils::Span<const Particle *const> particles1,
            Utils::Span<const Particle *const> particles2) const;
 
+  /** Normalize a histogram of @p n_pairs pair distances. */
+  void normalize(std::vector<double> &hist, long int n_pairs) const;
+
 public:
   // Range of the profile.
   double min_r, max_r;
@@ -55,6 +58,12 @@ public:
         max_r(max_r), n_r_bins(n_r_bins) {}
   std::vector<double> operator()() const final;
 
+  /** Whether the pairs can be found in the cell neighbor lists on all
+   *  nodes, i.e. whether @ref max_r is within the range of the cells.
+   *  Otherwise, the particles are collected on the head node.
+   */
+  bool use_cell_lists() const;
+
   std::vector<int> &ids1() { return m_ids1; }
   std::vector<int> &ids2() { return m_ids2; }
   std::vector<int> const &ids1() const { return m_ids1; }
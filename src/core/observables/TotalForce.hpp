@@ -24,9 +24,9 @@
 #include <vector>
 
 namespace Observables {
-class TotalForce : public PidObservable {
+class TotalForce : public PidReduction<TotalForce> {
 public:
-  using PidObservable::PidObservable;
+  using PidReduction<TotalForce>::PidReduction;
   std::vector<size_t> shape() const override { return {3}; }
 
   std::vector<double>
@@ -21,8 +21,10 @@
 
 #include "Particle.hpp"
 #include "energy_inline.hpp"
+#include "nonbonded_interactions/nonbonded_interaction_data.hpp"
 #include "particle_data.hpp"
 
+#include <limits>
 #include <stdexcept>
 
 namespace PairCriteria {
@@ -40,6 +42,11 @@ public:
     const bool res = decide(p1, p2);
     return res;
   }
+  /** @brief Largest distance at which the criterion can be true for a pair.
+   *  Infinity if no such bound is known. */
+  virtual double max_range() const {
+    return std::numeric_limits<double>::infinity();
+  }
   virtual ~PairCriterion() = default;
 };
 
@@ -50,6 +57,7 @@ public:
   bool decide(const Particle &p1, const Particle &p2) const override {
     return get_mi_vector(p1.r.p, p2.r.p, box_geo).norm() <= m_cut_off;
   };
+  double max_range() const override { return m_cut_off; }
   double get_cut_off() { return m_cut_off; }
   void set_cut_off(double c) { m_cut_off = c; }
 
@@ -71,6 +79,12 @@ public:
     return (calc_non_bonded_pair_energy(p1, p2, ia_params, vec21,
                                         dist_betw_part)) >= m_cut_off;
   };
+  /** A positive energy threshold can only be reached within the range of
+   *  the non-bonded interactions. */
+  double max_range() const override {
+    return (m_cut_off > 0.) ? maximal_cutoff_nonbonded()
+                            : std::numeric_limits<double>::infinity();
+  }
   double get_cut_off() { return m_cut_off; }
   void set_cut_off(double c) { m_cut_off = c; }
 
@@ -85,6 +99,8 @@ public:
     return pair_bond_exists_on(p1.bonds(), p2.identity(), m_bond_type) ||
            pair_bond_exists_on(p2.bonds(), p1.identity(), m_bond_type);
   };
+  /** Bond partners are always within the range of the cell system. */
+  double max_range() const override { return 0.; }
   int get_bond_type() { return m_bond_type; };
   void set_bond_type(int t) { m_bond_type = t; }
 
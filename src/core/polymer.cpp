@@ -35,10 +35,15 @@
 
 #include <utils/Vector.hpp>
 #include <utils/constants.hpp>
+#include <utils/index.hpp>
 #include <utils/math/vec_rotate.hpp>
 
+#include <boost/algorithm/clamp.hpp>
+
+#include <algorithm>
 #include <cmath>
 #include <stdexcept>
+#include <vector>
 
 template <class RNG> static Utils::Vector3d random_position(RNG &rng) {
   Utils::Vector3d v;
@@ -58,57 +63,124 @@ template <class RNG> static Utils::Vector3d random_unit_vector(RNG &rng) {
   return v;
 }
 
+namespace {
+/**
+ * @brief Uniform grid of positions in the periodic box.
+ *
+ * The cells are at least as large as the minimal distance, so all
+ * positions closer than that to a trial position are found in the
+ * 27 cells around it.
+ */
+class PositionGrid {
+public:
+  /** @param min_distance  Smallest cell size
+   *  @param n_positions   Expected number of positions, which limits
+   *                       the number of cells
+   */
+  PositionGrid(double min_distance, std::size_t n_positions) {
+    auto const cell_size =
+        std::max(min_distance, std::cbrt(box_geo.volume() /
+                                         std::max<double>(n_positions, 1.)));
+    for (int i = 0; i < 3; ++i) {
+      m_n_cells[i] = std::max(
+          1, static_cast<int>(std::floor(box_geo.length()[i] / cell_size)));
+      m_inv_cell_size[i] = m_n_cells[i] / box_geo.length()[i];
+    }
+    m_cells.resize(m_n_cells[0] * m_n_cells[1] * m_n_cells[2]);
+  }
+
+  void insert(Utils::Vector3d const &pos) {
+    m_cells[cell_index(cell_coordinates(pos))].push_back(pos);
+  }
+
+  void erase(Utils::Vector3d const &pos) {
+    auto &cell = m_cells[cell_index(cell_coordinates(pos))];
+    auto const it = std::find(cell.rbegin(), cell.rend(), pos);
+    if (it != cell.rend()) {
+      std::swap(*it, cell.back());
+      cell.pop_back();
+    }
+  }
+
+  /** @brief Whether any position is closer than @p min_distance to @p pos */
+  bool has_neighbor(Utils::Vector3d const &pos, double min_distance) const {
+    auto const center = cell_coordinates(pos);
+    Utils::Vector3i c;
+    for (c[0] = center[0] - 1; c[0] <= center[0] + 1; ++c[0]) {
+      for (c[1] = center[1] - 1; c[1] <= center[1] + 1; ++c[1]) {
+        for (c[2] = center[2] - 1; c[2] <= center[2] + 1; ++c[2]) {
+          for (auto const &m : m_cells[cell_index(c)]) {
+            if (get_mi_vector(pos, m, box_geo).norm() < min_distance) {
+              return true;
+            }
+          }
+        }
+      }
+    }
+    return false;
+  }
+
+private:
+  Utils::Vector3i m_n_cells;
+  Utils::Vector3d m_inv_cell_size;
+  std::vector<std::vector<Utils::Vector3d>> m_cells;
+
+  /** Cell of a position. Positions outside of the box in non-periodic
+   *  directions are assigned to the boundary cells. */
+  Utils::Vector3i cell_coordinates(Utils::Vector3d const &pos) const {
+    auto const folded_pos = folded_position(pos, box_geo);
+    Utils::Vector3i c;
+    for (int i = 0; i < 3; ++i) {
+      c[i] = boost::algorithm::clamp(
+          static_cast<int>(std::floor(folded_pos[i] * m_inv_cell_size[i])), 0,
+          m_n_cells[i] - 1);
+    }
+    return c;
+  }
+
+  /** Linear index of a cell, with periodic wrapping of the coordinates. */
+  int cell_index(Utils::Vector3i const &c) const {
+    Utils::Vector3i w;
+    for (int i = 0; i < 3; ++i) {
+      w[i] = (c[i] % m_n_cells[i] + m_n_cells[i]) % m_n_cells[i];
+    }
+    return Utils::get_linear_index(w, m_n_cells);
+  }
+};
+} // namespace
+
 /** Determines whether a given position @p pos is valid, i.e., it doesn't
  *  collide with existing or buffered particles, nor with existing constraints
  *  (if @c respect_constraints).
  *  @param pos                   the trial position in question
- *  @param positions             buffered positions to respect
- *  @param partCfg               existing particles to respect
+ *  @param grid                  existing and buffered positions to respect
+ *  @param shapes                constraints to respect
  *  @param min_distance          threshold for the minimum distance between
  *                               trial position and buffered/existing particles
- *  @param respect_constraints   whether to respect constraints
  *  @return true if valid position, false if not.
  */
-static bool
-is_valid_position(Utils::Vector3d const &pos,
-                  std::vector<std::vector<Utils::Vector3d>> const &positions,
-                  PartCfg &partCfg, double const min_distance,
-                  int const respect_constraints) {
+static bool is_valid_position(
+    Utils::Vector3d const &pos, PositionGrid const &grid,
+    std::vector<Constraints::ShapeBasedConstraint const *> const &shapes,
+    double const min_distance) {
   // check if constraint is violated
-  if (respect_constraints) {
+  if (not shapes.empty()) {
     Utils::Vector3d const folded_pos = folded_position(pos, box_geo);
 
-    for (auto &c : Constraints::constraints) {
-      auto cs =
-          std::dynamic_pointer_cast<const Constraints::ShapeBasedConstraint>(c);
-      if (cs) {
-        double d;
-        Utils::Vector3d v;
+    for (auto const cs : shapes) {
+      double d;
+      Utils::Vector3d v;
 
-        cs->calc_dist(folded_pos, d, v);
+      cs->calc_dist(folded_pos, d, v);
 
-        if (d <= 0) {
-          return false;
-        }
+      if (d <= 0) {
+        return false;
       }
     }
   }
 
-  if (min_distance > 0) {
-    // check for collision with existing particles
-    if (distto(partCfg, pos, -1) < min_distance) {
-      return false;
-    }
-
-    for (auto const &p : positions) {
-      for (auto const &m : p) {
-        if (get_mi_vector(pos, m, box_geo).norm() < min_distance) {
-          return false;
-        }
-      }
-    }
-  }
-  return true;
+  // check for collision with existing and buffered particles
+  return (min_distance <= 0) or not grid.has_neighbor(pos, min_distance);
 }
 
 std::vector<std::vector<Utils::Vector3d>>
@@ -127,15 +199,49 @@ draw_polymer_positions(PartCfg &partCfg, int const n_polymers,
     p.reserve(beads_per_chain);
   }
 
-  auto is_valid_pos = [&positions, &partCfg, min_distance,
-                       respect_constraints](Utils::Vector3d const &v) {
-    return is_valid_position(v, positions, partCfg, min_distance,
-                             respect_constraints);
+  /* Existing particles and buffered monomers, only needed for the
+   * distance check. */
+  auto const n_positions =
+      (min_distance > 0)
+          ? partCfg.size() + static_cast<std::size_t>(n_polymers) *
+                                 static_cast<std::size_t>(beads_per_chain)
+          : 0;
+  PositionGrid grid(min_distance, n_positions);
+  if (min_distance > 0) {
+    for (auto const &p : partCfg) {
+      grid.insert(p.r.p);
+    }
+  }
+
+  std::vector<Constraints::ShapeBasedConstraint const *> shapes;
+  if (respect_constraints) {
+    for (auto const &c : Constraints::constraints) {
+      auto const cs =
+          dynamic_cast<Constraints::ShapeBasedConstraint const *>(c.get());
+      if (cs) {
+        shapes.push_back(cs);
+      }
+    }
+  }
+
+  auto is_valid_pos = [&grid, &shapes, min_distance](Utils::Vector3d const &v) {
+    return is_valid_position(v, grid, shapes, min_distance);
+  };
+  auto push_position = [&positions, &grid, min_distance](
+                           int p, Utils::Vector3d const &v) {
+    positions[p].push_back(v);
+    if (min_distance > 0)
+      grid.insert(v);
+  };
+  auto pop_position = [&positions, &grid, min_distance](int p) {
+    if (min_distance > 0)
+      grid.erase(positions[p].back());
+    positions[p].pop_back();
   };
 
   for (size_t p = 0; p < start_positions.size(); p++) {
     if (is_valid_pos(start_positions[p])) {
-      positions[p].push_back(start_positions[p]);
+      push_position(p, start_positions[p]);
     } else {
       throw std::runtime_error("Invalid start positions.");
     }
@@ -182,10 +288,10 @@ draw_polymer_positions(PartCfg &partCfg, int const n_polymers,
 
         if (pos) {
           /* Move on one position */
-          positions[p].push_back(*pos);
+          push_position(p, *pos);
         } else if (not positions[p].empty()) {
           /* Go back one position and try again */
-          positions[p].pop_back();
+          pop_position(p);
           rejections++;
           if (rejections > max_tries) {
             /* Give up for this try. */
@@ -83,12 +83,14 @@ void pressure_calc() {
     add_kinetic_virials(p, obs_pressure);
   }
 
-  short_range_loop([](Particle &p) { add_bonded_virials(p, obs_pressure); },
+  short_range_loop([](Particle &) {},
                    [](Particle &p1, Particle &p2, Distance const &d) {
                      add_non_bonded_pair_virials(p1, p2, d.vec21, sqrt(d.dist2),
                                                  obs_pressure);
                    });
 
+  add_bonded_virials(cell_structure.bond_lists(), obs_pressure);
+
   calc_long_range_virials(cell_structure.local_particles());
 
 #ifdef VIRTUAL_SITES
@@ -25,6 +25,7 @@
 #ifndef CORE_PRESSURE_INLINE_HPP
 #define CORE_PRESSURE_INLINE_HPP
 
+#include "BondLists.hpp"
 #include "Observable_stat.hpp"
 #include "exclusions.hpp"
 #include "forces_inline.hpp"
@@ -151,14 +152,14 @@ inline void add_kinetic_virials(Particle const &p1,
       obs_pressure.kinetic[k * 3 + l] += p1.m.v[k] * p1.m.v[l] * p1.p.mass;
 }
 
-/** Add bonded energies for one particle to the energy observable.
- *  @param[in] p   particle for which to calculate pressure
- *  @param[out]    obs_pressure   pressure observable
+/** Add the bonded virials of all local particles to the pressure observable.
+ *  @param[in] bond_lists    bonds of the local particles
+ *  @param[out] obs_pressure pressure observable
  */
-inline void add_bonded_virials(Particle &p, Observable_stat &obs_pressure) {
-  cell_structure.execute_bond_handler(p, [&obs_pressure](
-                                             Particle &p1, int bond_id,
-                                             Utils::Span<Particle *> partners) {
+inline void add_bonded_virials(BondLists &bond_lists,
+                               Observable_stat &obs_pressure) {
+  bond_lists.for_each_bond([&obs_pressure](Particle &p1, int bond_id,
+                                           Utils::Span<Particle *> partners) {
     auto const &iaparams = bonded_ia_params[bond_id];
     auto const result = calc_bonded_pressure_tensor(iaparams, p1, partners);
     if (result) {
@@ -21,6 +21,7 @@
 
 #include "reaction_ensemble.hpp"
 #include "Particle.hpp"
+#include "cells.hpp"
 #include "energy.hpp"
 #include "grid.hpp"
 #include "integrate.hpp"
@@ -83,6 +84,7 @@ void EnergyCollectiveVariable::load_CV_boundaries(
  * Performs a randomly selected reaction in the reaction ensemble
  */
 int ReactionAlgorithm::do_reaction(int reaction_steps) {
+  invalidate_particle_energies();
   for (int i = 0; i < reaction_steps; i++) {
     int reaction_id = i_random(reactions.size());
     generic_oneway_reaction(reaction_id);
@@ -402,15 +404,15 @@ void ReactionAlgorithm::generic_oneway_reaction(int reaction_id) {
 
   // calculate potential energy
   const double E_pot_old =
-      calculate_current_potential_energy_of_system(); // only consider potential
-                                                      // energy since we assume
-                                                      // that the kinetic part
-                                                      // drops out in the
-                                                      // process of calculating
-                                                      // ensemble averages
-                                                      // (kinetic part may be
-                                                      // separated and crossed
-                                                      // out)
+      potential_energy_before_trial_move(); // only consider potential
+                                            // energy since we assume
+                                            // that the kinetic part
+                                            // drops out in the
+                                            // process of calculating
+                                            // ensemble averages
+                                            // (kinetic part may be
+                                            // separated and crossed
+                                            // out)
 
   // find reacting molecules in reactants and save their properties for later
   // recreation if step is not accepted
@@ -432,7 +434,7 @@ void ReactionAlgorithm::generic_oneway_reaction(int reaction_id) {
   if (particle_inside_exclusion_radius_touched)
     E_pot_new = std::numeric_limits<double>::max();
   else
-    E_pot_new = calculate_current_potential_energy_of_system();
+    E_pot_new = potential_energy_after_trial_move();
 
   int new_state_index = -1; // save new_state_index for Wang-Landau algorithm
   int accepted_state = -1;  // for Wang-Landau algorithm
@@ -471,6 +473,8 @@ void ReactionAlgorithm::generic_oneway_reaction(int reaction_id) {
     for (int i = 0; i < len_hidden_particles_properties; i++) {
       delete_particle(to_be_deleted_hidden_ids[i]); // delete particle
     }
+    if (len_hidden_particles_properties > 0)
+      invalidate_particle_energies();
     current_reaction.accepted_moves += 1;
   } else {
     // reject
@@ -485,6 +489,7 @@ void ReactionAlgorithm::generic_oneway_reaction(int reaction_id) {
     // 3) restore previously changed reactant particles
     restore_properties(changed_particles_properties,
                        number_of_saved_properties);
+    on_trial_move_reverted();
   }
   on_end_reaction(accepted_state);
 }
@@ -506,15 +511,106 @@ int ReactionAlgorithm::calculate_nu_bar(
   return nu_bar;
 }
 
+/**
+ * Returns the potential energy before a trial move, the reference for
+ * @ref potential_energy_after_trial_move. If the short-range energy can be
+ * calculated particle by particle, only the long-range energy is calculated
+ * here, and the short-range energy change of the particles changed in the
+ * trial move is accumulated by @ref change_particle.
+ */
+double ReactionAlgorithm::potential_energy_before_trial_move() {
+  m_use_particle_energies = particle_energies_available();
+  m_particle_energy_change = 0.0;
+  m_trial_move_unchanged = true;
+  if (not m_use_particle_energies) {
+    invalidate_particle_energies();
+    return calculate_current_potential_energy_of_system();
+  }
+
+  return mpi_calculate_long_range_energy();
+}
+
+/**
+ * Returns the potential energy after a trial move. Only the difference to
+ * @ref potential_energy_before_trial_move is meaningful.
+ */
+double ReactionAlgorithm::potential_energy_after_trial_move() {
+  if (not m_use_particle_energies)
+    return calculate_current_potential_energy_of_system();
+
+  return mpi_calculate_long_range_energy() + m_particle_energy_change;
+}
+
+/**
+ * Applies a change to a single particle and accumulates the resulting
+ * change of the short-range energy, i.e. of the energy of the interactions
+ * of the particle with the (unchanged) rest of the system. The energy of
+ * the particle before the change is taken from @ref m_particle_energies if
+ * it is known for the current configuration.
+ */
+template <typename Change>
+void ReactionAlgorithm::change_particle(int p_id, Change &&change) {
+  if (not m_use_particle_energies) {
+    change();
+    return;
+  }
+
+  auto E_old = 0.0;
+  auto const cached = m_particle_energies.find(p_id);
+  if (cached != m_particle_energies.end()) {
+    E_old = cached->second;
+  } else if (particle_exists(p_id)) {
+    E_old = mpi_calculate_particle_energy(p_id);
+    m_particle_energies[p_id] = E_old;
+  }
+  if (m_trial_move_unchanged) {
+    m_particle_energies_before_trial = m_particle_energies;
+    m_trial_move_unchanged = false;
+  }
+
+  change();
+
+  /* The change invalidates the energies of all other particles. */
+  auto const E_new = mpi_calculate_particle_energy(p_id);
+  m_particle_energy_change += E_new - E_old;
+  m_particle_energies.clear();
+  m_particle_energies[p_id] = E_new;
+}
+
+/**
+ * Has to be called when the configuration before the current trial move
+ * has been restored, the particle energies known for that configuration
+ * are valid again.
+ */
+void ReactionAlgorithm::on_trial_move_reverted() {
+  if (not m_trial_move_unchanged)
+    m_particle_energies = m_particle_energies_before_trial;
+}
+
+/**
+ * Returns the distance of a particle to the closest other particle. The
+ * search is restricted to the neighbor cells if they cover the exclusion
+ * radius.
+ */
+double ReactionAlgorithm::nearest_neighbor_distance(int p_id) {
+  if (exclusion_radius <= cells_neighbor_search_range())
+    return mpi_get_nearest_neighbor_distance(p_id);
+
+  auto const &p = get_particle_data(p_id);
+  return distto(partCfg(), p.r.p, p_id);
+}
+
 /**
  * Replaces a particle with the given particle id to be of a certain type. This
  * especially means that the particle type and the particle charge are changed.
  */
 void ReactionAlgorithm::replace_particle(int p_id, int desired_type) {
-  set_particle_type(p_id, desired_type);
+  change_particle(p_id, [&]() {
+    set_particle_type(p_id, desired_type);
 #ifdef ELECTROSTATICS
-  set_particle_q(p_id, charges_of_types[desired_type]);
+    set_particle_q(p_id, charges_of_types[desired_type]);
 #endif
+  });
 }
 
 /**
@@ -535,17 +631,18 @@ void ReactionAlgorithm::replace_particle(int p_id, int desired_type) {
  */
 void ReactionAlgorithm::hide_particle(int p_id, int previous_type) {
 
-  auto const part = get_particle_data(p_id);
-  auto const d_min = distto(partCfg(), part.r.p, p_id);
+  auto const d_min = nearest_neighbor_distance(p_id);
   if (d_min < exclusion_radius)
     particle_inside_exclusion_radius_touched = true;
 
+  change_particle(p_id, [&]() {
 #ifdef ELECTROSTATICS
-  // set charge
-  set_particle_q(p_id, 0.0);
+    // set charge
+    set_particle_q(p_id, 0.0);
 #endif
-  // set type
-  set_particle_type(p_id, non_interacting_type);
+    // set type
+    set_particle_type(p_id, non_interacting_type);
+  });
 }
 
 /**
@@ -637,16 +734,18 @@ int ReactionAlgorithm::create_particle(int desired_type) {
 #endif
 
   pos_vec = get_random_position_in_box();
-  place_particle(p_id, pos_vec.data());
-  // set type
-  set_particle_type(p_id, desired_type);
+  change_particle(p_id, [&]() {
+    place_particle(p_id, pos_vec.data());
+    // set type
+    set_particle_type(p_id, desired_type);
 #ifdef ELECTROSTATICS
-  // set charge
-  set_particle_q(p_id, charge);
+    // set charge
+    set_particle_q(p_id, charge);
 #endif
+  });
   // set velocities
   set_particle_v(p_id, vel);
-  double d_min = distto(partCfg(), pos_vec, p_id);
+  double d_min = nearest_neighbor_distance(p_id);
   if (d_min < exclusion_radius) {
     // setting of a minimal distance is allowed to avoid overlapping
     // configurations if there is a repulsive potential. States with
@@ -684,6 +783,7 @@ int WangLandauReactionEnsemble::on_mc_use_WL_get_new_state() {
  */
 bool ReactionAlgorithm::do_global_mc_move_for_particles_of_type(
     int type, int particle_number_of_type_to_be_changed, bool use_wang_landau) {
+  invalidate_particle_energies();
   m_tried_configurational_MC_moves += 1;
   particle_inside_exclusion_radius_touched = false;
 
@@ -702,7 +802,7 @@ bool ReactionAlgorithm::do_global_mc_move_for_particles_of_type(
     return false;
   }
 
-  const double E_pot_old = calculate_current_potential_energy_of_system();
+  const double E_pot_old = potential_energy_before_trial_move();
 
   std::vector<double> particle_positions(3 *
                                          particle_number_of_type_to_be_changed);
@@ -739,8 +839,8 @@ bool ReactionAlgorithm::do_global_mc_move_for_particles_of_type(
     vel[1] = prefactor * m_normal_distribution(m_generator);
     vel[2] = prefactor * m_normal_distribution(m_generator);
     set_particle_v(p_id, vel);
-    place_particle(p_id, new_pos.data());
-    auto const d_min = distto(partCfg(), new_pos, p_id);
+    change_particle(p_id, [&]() { place_particle(p_id, new_pos.data()); });
+    auto const d_min = nearest_neighbor_distance(p_id);
     if (d_min < exclusion_radius)
       particle_inside_exclusion_radius_touched = true;
   }
@@ -749,7 +849,7 @@ bool ReactionAlgorithm::do_global_mc_move_for_particles_of_type(
   if (particle_inside_exclusion_radius_touched)
     E_pot_new = std::numeric_limits<double>::max();
   else
-    E_pot_new = calculate_current_potential_energy_of_system();
+    E_pot_new = potential_energy_after_trial_move();
 
   double beta = 1.0 / temperature;
 
@@ -795,6 +895,7 @@ bool ReactionAlgorithm::do_global_mc_move_for_particles_of_type(
   // create particles again at the positions they were
   for (int i = 0; i < particle_number_of_type_to_be_changed; i++)
     place_particle(p_id_s_changed_particles[i], &particle_positions[3 * i]);
+  on_trial_move_reverted();
   return false;
 }
 
@@ -1130,6 +1231,7 @@ double WangLandauReactionEnsemble::calculate_acceptance_probability(
  *  as needed to get to a new conformation.
  */
 int WangLandauReactionEnsemble::do_reaction(int reaction_steps) {
+  invalidate_particle_energies();
   m_WL_tries += reaction_steps;
   for (int step = 0; step < reaction_steps; step++) {
     int reaction_id = i_random(reactions.size());
@@ -1512,6 +1614,7 @@ int ConstantpHEnsemble::get_random_valid_p_id() {
  *Performs a reaction in the constant pH ensemble
  */
 int ConstantpHEnsemble::do_reaction(int reaction_steps) {
+  invalidate_particle_energies();
 
   for (int i = 0; i < reaction_steps; ++i) {
     // get a list of reactions where a randomly selected particle type occurs in
@@ -1580,7 +1683,8 @@ WidomInsertion::measure_excess_chemical_potential(int reaction_id) {
                              "from the system via the inverse Widom scheme.");
 
   SingleReaction &current_reaction = reactions[reaction_id];
-  const double E_pot_old = calculate_current_potential_energy_of_system();
+  invalidate_particle_energies();
+  const double E_pot_old = potential_energy_before_trial_move();
 
   // make reaction attempt
   std::vector<int> p_ids_created_particles;
@@ -1591,7 +1695,7 @@ WidomInsertion::measure_excess_chemical_potential(int reaction_id) {
          // need to hide the particle and recover it
   make_reaction_attempt(current_reaction, changed_particles_properties,
                         p_ids_created_particles, hidden_particles_properties);
-  const double E_pot_new = calculate_current_potential_energy_of_system();
+  const double E_pot_new = potential_energy_after_trial_move();
   // reverse reaction attempt
   // reverse reaction
   // 1) delete created product particles
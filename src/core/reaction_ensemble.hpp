@@ -27,6 +27,7 @@
 
 #include <map>
 #include <string>
+#include <unordered_map>
 
 namespace ReactionEnsemble {
 
@@ -199,6 +200,10 @@ protected:
   }
   bool all_reactant_particles_exist(int reaction_id);
 
+  double potential_energy_before_trial_move();
+  double potential_energy_after_trial_move();
+  void invalidate_particle_energies() { m_particle_energies.clear(); }
+
 private:
   std::mt19937 m_generator;
   std::normal_distribution<double> m_normal_distribution;
@@ -214,6 +219,25 @@ private:
   int create_particle(int desired_type);
   void hide_particle(int p_id, int previous_type);
 
+  /** Whether the potential energy change of the current trial move is
+   *  accumulated from the changes of the single particles */
+  bool m_use_particle_energies = false;
+  /** Short-range potential energy change of the current trial move */
+  double m_particle_energy_change = 0.0;
+  /** Short-range energies of particles in the current configuration, which
+   *  are reused instead of being recalculated before the next change.
+   *  Invalidated on entry of the public methods, since the configuration
+   *  may have been changed by other means in between. */
+  std::unordered_map<int, double> m_particle_energies;
+  /** Short-range energies of particles in the configuration before the
+   *  current trial move, valid again once the move has been reverted */
+  std::unordered_map<int, double> m_particle_energies_before_trial;
+  /** Whether no particle has been changed in the current trial move yet */
+  bool m_trial_move_unchanged = true;
+  template <typename Change> void change_particle(int p_id, Change &&change);
+  void on_trial_move_reverted();
+  double nearest_neighbor_distance(int p_id);
+
   void append_particle_property_of_random_particle(
       int type, std::vector<StoredParticleProperty> &list_of_particles);
 
@@ -19,10 +19,13 @@
 #ifndef CORE_SHORT_RANGE_HPP
 #define CORE_SHORT_RANGE_HPP
 
+#include "algorithm/colored_cells.hpp"
 #include "algorithm/for_each_pair.hpp"
+#include "algorithm/link_cell_soa.hpp"
 #include "cells.hpp"
 #include "grid.hpp"
 #include "integrate.hpp"
+#include "timings.hpp"
 
 #include <boost/iterator/indirect_iterator.hpp>
 #include <profiler/profiler.hpp>
@@ -47,12 +50,20 @@ struct MinimalImageDistance {
   Distance operator()(Particle const &p1, Particle const &p2) const {
     return Distance(get_mi_vector(p1.r.p, p2.r.p, box));
   }
+  Distance operator()(Utils::Vector3d const &a,
+                      Utils::Vector3d const &b) const {
+    return Distance(get_mi_vector(a, b, box));
+  }
 };
 
 struct EuclidianDistance {
   Distance operator()(Particle const &p1, Particle const &p2) const {
     return Distance(p1.r.p - p2.r.p);
   }
+  Distance operator()(Utils::Vector3d const &a,
+                      Utils::Vector3d const &b) const {
+    return Distance(a - b);
+  }
 };
 
 /**
@@ -93,6 +104,7 @@ void short_range_loop(ParticleKernel &&particle_kernel,
                       PairKernel &&pair_kernel,
                       const VerletCriterion &verlet_criterion = {}) {
   ESPRESSO_PROFILER_CXX_MARK_FUNCTION;
+  Timings::ScopedTimer timer(Timings::Section::SHORT_RANGE_LOOP);
 
   assert(cell_structure.get_resort_particles() == Cells::RESORT_NONE);
 
@@ -106,6 +118,9 @@ void short_range_loop(ParticleKernel &&particle_kernel,
         first, last, std::forward<ParticleKernel>(particle_kernel),
         std::forward<PairKernel>(pair_kernel), verlet_criterion);
 
+    if (cell_structure.use_verlet_list and rebuild_verletlist) {
+      cell_structure.verlet_list_rebuilds++;
+    }
     rebuild_verletlist = false;
   } else {
     for (auto &p : cell_structure.local_particles()) {
@@ -114,4 +129,173 @@ void short_range_loop(ParticleKernel &&particle_kernel,
   }
 }
 
+namespace detail {
+/**
+ * @brief Run the particle kernel on all local particles, and
+ *        @p cell_loop on every local cell with the packed
+ *        structure-of-arrays mirror, if there are interactions.
+ *
+ * The cells are visited color by color (see
+ * @ref CellStructure::cell_colors), using
+ * CellStructure::n_threads threads, so @p cell_loop
+ * has to be thread-safe as long as it only writes to
+ * the mirror of the cell and its red neighbors.
+ *
+ * The interior cells are visited first. Their pairs do not
+ * involve ghost particles, so a ghost update started by
+ * @ref CellStructure::ghosts_update_begin proceeds in the
+ * meantime, and is only completed before the boundary cells.
+ *
+ * @return Sum of the virials accumulated in the mirrors
+ *         of the local cells.
+ */
+template <class ParticleKernel, class CellLoop>
+Utils::Vector3d with_soa_mirror(ParticleKernel &&particle_kernel,
+                                CellLoop &&cell_loop) {
+  assert(cell_structure.get_resort_particles() == Cells::RESORT_NONE);
+
+  if (interaction_range() == INACTIVE_CUTOFF) {
+    cell_structure.ghosts_wait();
+    for (auto &p : cell_structure.local_particles()) {
+      particle_kernel(p);
+    }
+    return {};
+  }
+
+  auto const &colors = cell_structure.cell_colors();
+
+  cell_structure.update_soa_mirror(cell_structure.local_cells());
+  Algorithm::for_each_colored_cell(colors.interior, cell_structure.n_threads,
+                                   cell_loop,
+                                   []() { cell_structure.ghosts_progress(); });
+
+  cell_structure.ghosts_wait();
+
+  for (auto &p : cell_structure.local_particles()) {
+    particle_kernel(p);
+  }
+
+  cell_structure.update_soa_mirror(cell_structure.ghost_cells());
+  Algorithm::for_each_colored_cell(colors.boundary, cell_structure.n_threads,
+                                   cell_loop);
+
+  cell_structure.scatter_soa_forces();
+
+  Utils::Vector3d virial{};
+  for (auto const cell : cell_structure.local_cells()) {
+    virial += cell->m_soa.virial();
+  }
+
+  return virial;
+}
+} // namespace detail
+
+/**
+ * @brief Run the pair kernel on the structure-of-arrays
+ *        mirror of the cells.
+ *
+ * The mirror is packed before the loop, and the forces
+ * accumulated in it are added to the particles afterwards.
+ * The particle kernel is run on the particles directly.
+ * No Verlet lists are used. If CellStructure::n_threads
+ * is larger than one, the pair kernel is called concurrently
+ * for different cells, so it may only write to the mirrors
+ * it is handed.
+ *
+ * @param particle_kernel Called with every local particle.
+ * @param pair_kernel Called as pair_kernel(soa1, i, soa2, j, distance)
+ *                    for every pair of particles.
+ * @return Sum of the virials the pair kernel added to soa1.
+ */
+template <class ParticleKernel, class PairKernel>
+Utils::Vector3d short_range_loop_soa(ParticleKernel &&particle_kernel,
+                          PairKernel &&pair_kernel) {
+  ESPRESSO_PROFILER_CXX_MARK_FUNCTION;
+  Timings::ScopedTimer timer(Timings::Section::SHORT_RANGE_LOOP);
+
+  return detail::with_soa_mirror(
+      std::forward<ParticleKernel>(particle_kernel),
+      [&pair_kernel,
+       minimum_image = cell_structure.minimum_image_distance()](Cell &cell) {
+        if (minimum_image) {
+          Algorithm::link_cell_soa(cell, pair_kernel,
+                                   detail::MinimalImageDistance{box_geo});
+        } else {
+          Algorithm::link_cell_soa(cell, pair_kernel,
+                                   detail::EuclidianDistance{});
+        }
+      });
+}
+
+/**
+ * @brief Run a block kernel on the structure-of-arrays
+ *        mirror of the cells.
+ *
+ * Like @ref short_range_loop_soa, but the kernel is handed
+ * blocks of pair candidates instead of single pairs, see
+ * @ref Algorithm::link_cell_soa_batched. The kernel has to
+ * apply the cutoffs and, if
+ * CellStructure::minimum_image_distance() is true, the
+ * minimum image convention.
+ *
+ * @param particle_kernel Called with every local particle.
+ * @param block_kernel Called as block_kernel(soa1, i, soa2, first, last).
+ * @return Sum of the virials the block kernel added to soa1.
+ */
+template <class ParticleKernel, class BlockKernel>
+Utils::Vector3d short_range_loop_soa_batched(ParticleKernel &&particle_kernel,
+                                  BlockKernel &&block_kernel) {
+  ESPRESSO_PROFILER_CXX_MARK_FUNCTION;
+  Timings::ScopedTimer timer(Timings::Section::SHORT_RANGE_LOOP);
+
+  return detail::with_soa_mirror(
+      std::forward<ParticleKernel>(particle_kernel),
+      [&block_kernel](Cell &cell) {
+        Algorithm::link_cell_soa_batched(cell, block_kernel);
+      });
+}
+
+/**
+ * @brief Run the pair kernel on a local particle and every other
+ *        particle in its cell and in the neighbor cells.
+ *
+ * These are all particles within the interaction range of @p p,
+ * so the contributions of a single particle to the short-range
+ * interactions can be evaluated without a loop over all pairs.
+ *
+ * @param p Local particle.
+ * @param pair_kernel Called as pair_kernel(p, p2, distance)
+ *                    for every neighbor p2 of @p p.
+ */
+template <class PairKernel>
+void particle_neighbor_loop(Particle &p, PairKernel &&pair_kernel) {
+  assert(cell_structure.get_resort_particles() == Cells::RESORT_NONE);
+
+  auto const cell = find_current_cell(p);
+  assert(cell);
+
+  auto const minimum_image = cell_structure.minimum_image_distance();
+  auto const visit = [&](Cell *neighbor) {
+    for (auto &p2 : neighbor->particles()) {
+      if (p2.identity() == p.identity())
+        continue;
+
+      if (minimum_image) {
+        pair_kernel(p, p2, detail::MinimalImageDistance{box_geo}(p, p2));
+      } else {
+        pair_kernel(p, p2, detail::EuclidianDistance{}(p, p2));
+      }
+    }
+  };
+
+  /* The neighbors of a cell of the domain decomposition contain the
+   * cell itself, those of the atom decomposition do not. */
+  visit(cell);
+  for (auto neighbor : cell->neighbors().all()) {
+    if (neighbor != cell) {
+      visit(neighbor);
+    }
+  }
+}
+
 #endif
@@ -39,7 +39,12 @@
 #include <utils/contains.hpp>
 #include <utils/math/sqr.hpp>
 
+#include <boost/mpi/collectives/reduce.hpp>
+
+#include <algorithm>
+#include <cmath>
 #include <cstdlib>
+#include <functional>
 #include <limits>
 
 /****************************************************************************************
@@ -263,14 +268,109 @@ void calc_part_distribution(PartCfg &partCfg, std::vector<int> const &p1_types,
     dist[i] /= (double)cnt;
 }
 
-std::vector<double> calc_structurefactor(PartCfg &partCfg,
-                                         std::vector<int> const &p_types,
+namespace {
+/** Row of wave vectors (i, j, k) with fixed i, j and |k| <= k_max,
+ *  stored from @c offset in the list of all wave vectors. */
+struct WaveVectorRow {
+  int i, j, k_max, offset;
+};
+
+/** Rows of the wave vectors of the structure factor, i.e. all (i, j, k)
+ *  with i >= 0 and i^2 + j^2 + k^2 <= order^2. */
+std::vector<WaveVectorRow> structure_factor_rows(int order) {
+  auto const order2 = order * order;
+  std::vector<WaveVectorRow> rows;
+  int offset = 0;
+  for (int i = 0; i <= order; i++) {
+    for (int j = -order; j <= order; j++) {
+      auto const n_ij = i * i + j * j;
+      if (n_ij <= order2) {
+        auto k_max = static_cast<int>(std::sqrt(order2 - n_ij));
+        /* Guard against rounding of the square root */
+        while (n_ij + (k_max + 1) * (k_max + 1) <= order2)
+          k_max++;
+        while (n_ij + k_max * k_max > order2)
+          k_max--;
+        rows.push_back({i, j, k_max, offset});
+        offset += 2 * k_max + 1;
+      }
+    }
+  }
+  return rows;
+}
+
+/** Phase factors exp(i m x) for m = -order, ..., order by recurrence,
+ *  as interleaved real and imaginary parts. */
+void phase_factors(double x, int order, std::vector<double> &e) {
+  e.resize(2 * (2 * order + 1));
+  auto const c = std::cos(x);
+  auto const s = std::sin(x);
+  auto *e0 = e.data() + 2 * order;
+  e0[0] = 1.;
+  e0[1] = 0.;
+  for (int m = 1; m <= order; m++) {
+    e0[2 * m] = e0[2 * m - 2] * c - e0[2 * m - 1] * s;
+    e0[2 * m + 1] = e0[2 * m - 2] * s + e0[2 * m - 1] * c;
+    e0[-2 * m] = e0[2 * m];
+    e0[-2 * m + 1] = -e0[2 * m + 1];
+  }
+}
+} // namespace
+
+/**
+ * @brief Sums of the phase factors exp(i q r) of the local particles.
+ *
+ * The phase factors of each particle are built by recurrence from one
+ * sine and cosine per direction. The sums of all nodes, followed by the
+ * number of particles, are added up on the head node.
+ */
+static std::vector<double> structure_factor_slave(std::vector<int> p_types,
+                                                  int order) {
+  auto const rows = structure_factor_rows(order);
+  auto const n_q = rows.empty() ? 0 : rows.back().offset +
+                                          2 * rows.back().k_max + 1;
+  auto const twoPI_L = 2 * Utils::pi() / box_geo.length()[0];
+
+  std::vector<double> sums(2 * n_q + 1, 0.0);
+  std::vector<double> ex, ey, ez;
+  for (auto const &p : cell_structure.local_particles()) {
+    auto const weight = static_cast<double>(
+        std::count(p_types.begin(), p_types.end(), p.p.type));
+    if (weight == 0.)
+      continue;
+
+    phase_factors(twoPI_L * p.r.p[0], order, ex);
+    phase_factors(twoPI_L * p.r.p[1], order, ey);
+    phase_factors(twoPI_L * p.r.p[2], order, ez);
+
+    for (auto const &row : rows) {
+      auto const *exi = ex.data() + 2 * (order + row.i);
+      auto const *eyj = ey.data() + 2 * (order + row.j);
+      auto const re_xy = weight * (exi[0] * eyj[0] - exi[1] * eyj[1]);
+      auto const im_xy = weight * (exi[0] * eyj[1] + exi[1] * eyj[0]);
+      auto const *ezk = ez.data() + 2 * (order - row.k_max);
+      auto *sum = sums.data() + 2 * row.offset;
+      for (int k = 0; k < 2 * row.k_max + 1; k++) {
+        sum[2 * k] += re_xy * ezk[2 * k] - im_xy * ezk[2 * k + 1];
+        sum[2 * k + 1] += re_xy * ezk[2 * k + 1] + im_xy * ezk[2 * k];
+      }
+    }
+    sums.back() += weight;
+  }
+
+  std::vector<double> result(sums.size(), 0.0);
+  boost::mpi::reduce(comm_cart, sums.data(), static_cast<int>(sums.size()),
+                     result.data(), std::plus<double>(), 0);
+  return result;
+}
+
+REGISTER_CALLBACK_MASTER_RANK(structure_factor_slave)
+
+std::vector<double> calc_structurefactor(std::vector<int> const &p_types,
                                          int order) {
   auto const order2 = order * order;
   std::vector<double> ff;
   ff.resize(2 * order2);
-  ff[2 * order2] = 0;
-  auto const twoPI_L = 2 * Utils::pi() / box_geo.length()[0];
 
   if (order < 1) {
     fprintf(stderr,
@@ -278,38 +378,21 @@ std::vector<double> calc_structurefactor(PartCfg &partCfg,
     fflush(nullptr);
     errexit();
   } else {
-    for (int qi = 0; qi < 2 * order2; qi++) {
-      ff[qi] = 0.0;
-    }
-    for (int i = 0; i <= order; i++) {
-      for (int j = -order; j <= order; j++) {
-        for (int k = -order; k <= order; k++) {
-          auto const n = i * i + j * j + k * k;
-          if ((n <= order2) && (n >= 1)) {
-            double C_sum = 0.0, S_sum = 0.0;
-            for (auto const &p : partCfg) {
-              for (int t : p_types) {
-                if (p.p.type == t) {
-                  auto const qr =
-                      twoPI_L * (Utils::Vector3i{{i, j, k}} * p.r.p);
-                  C_sum += cos(qr);
-                  S_sum += sin(qr);
-                }
-              }
-            }
-            ff[2 * n - 2] += C_sum * C_sum + S_sum * S_sum;
-            ff[2 * n - 1]++;
-          }
+    auto const sums = mpi_call(::Communication::Result::master_rank,
+                               structure_factor_slave, p_types, order);
+
+    /* Spherical average over the shells of equal n = |q|^2 L^2 / (2 pi)^2 */
+    for (auto const &row : structure_factor_rows(order)) {
+      for (int k = -row.k_max; k <= row.k_max; k++) {
+        auto const n = row.i * row.i + row.j * row.j + k * k;
+        if (n >= 1) {
+          auto const *sum = sums.data() + 2 * (row.offset + k + row.k_max);
+          ff[2 * n - 2] += sum[0] * sum[0] + sum[1] * sum[1];
+          ff[2 * n - 1]++;
         }
       }
     }
-    int n = 0;
-    for (auto const &p : partCfg) {
-      for (int t : p_types) {
-        if (p.p.type == t)
-          n++;
-      }
-    }
+    auto const n = sums.back();
     for (int qi = 0; qi < order2; qi++)
       if (ff[2 * qi + 1] != 0)
         ff[2 * qi] /= n * ff[2 * qi + 1];
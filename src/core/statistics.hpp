@@ -96,11 +96,13 @@ void calc_part_distribution(PartCfg &partCfg, std::vector<int> const &p1_types,
  *  and sf[1]=1. For q=7, there are no possible wave vectors, so
  *  sf[2*(7-1)]=sf[2*(7-1)+1]=0.
  *
+ *  The phase factors of the particles are computed by recurrence on the
+ *  nodes which hold them, and summed up on the head node.
+ *
  *  @param p_types   list with types of particles to be analyzed
  *  @param order     the maximum wave vector length in 2PI/L
  */
-std::vector<double> calc_structurefactor(PartCfg &partCfg,
-                                         std::vector<int> const &p_types,
+std::vector<double> calc_structurefactor(std::vector<int> const &p_types,
                                          int order);
 
 std::vector<std::vector<double>> modify_stucturefactor(int order,
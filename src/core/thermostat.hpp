@@ -98,6 +98,10 @@ public:
   void rng_initialize(uint64_t const seed) {
     rng_counter = Utils::Counter<uint64_t>(seed);
   }
+  /** Restore the RNG counter from its seed and its current value. */
+  void rng_restore(uint64_t const seed, uint64_t const value) {
+    rng_counter = Utils::Counter<uint64_t>(seed, value);
+  }
   /** Increment the RNG counter */
   void rng_increment() {
     if (!rng_counter) {
@@ -112,6 +116,13 @@ public:
     }
     return rng_counter.get().value();
   }
+  /** Get the seed the RNG counter was initialized with */
+  uint64_t rng_seed() const {
+    if (!rng_counter) {
+      throw "The RNG counter is not initialized";
+    }
+    return rng_counter.get().initial_value();
+  }
   /** Is the RNG counter initialized */
   bool rng_is_initialized() const { return static_cast<bool>(rng_counter); }
 
@@ -352,6 +363,10 @@ NEW_THERMOSTAT(dpd)
 extern LangevinThermostat langevin;
 extern BrownianThermostat brownian;
 extern IsotropicNptThermostat npt_iso;
+extern ThermalizedBondThermostat thermalized_bond;
+#ifdef DPD
+extern DPDThermostat dpd;
+#endif
 
 /** Initialize constants of the thermostat at the start of integration */
 void thermo_init();
@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2021 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+/** \file
+ *
+ *  Implementation of \ref timings.hpp
+ */
+#include "timings.hpp"
+
+#include "communication.hpp"
+
+#include <boost/mpi/collectives/reduce.hpp>
+#include <boost/mpi/operations.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace Timings {
+std::array<Record, n_sections> local_records;
+
+std::string section_name(Section section) {
+  switch (section) {
+  case Section::FORCE_CALC:
+    return "force_calc";
+  case Section::SHORT_RANGE_LOOP:
+    return "short_range_loop";
+  case Section::GHOST_COMMUNICATION:
+    return "ghost_communication";
+  case Section::RESORT:
+    return "resort";
+  case Section::P3M_CHARGE_ASSIGNMENT:
+    return "p3m_charge_assignment";
+  case Section::P3M_FFT:
+    return "p3m_fft";
+  case Section::P3M_BACK_INTERPOLATION:
+    return "p3m_back_interpolation";
+  case Section::LB_COLLIDE_STREAM:
+    return "lb_collide_stream";
+  case Section::LB_COUPLING:
+    return "lb_coupling";
+  default:
+    return "";
+  }
+}
+
+namespace {
+/**
+ * @brief Reduce the local records to the head node.
+ *
+ * @return Minimum, maximum and sum of the times, followed by
+ *         the maximum of the calls, for each section.
+ */
+std::vector<double> statistics_local() {
+  std::vector<double> times(n_sections), calls(n_sections);
+  std::transform(local_records.begin(), local_records.end(), times.begin(),
+                 [](Record const &r) { return r.time; });
+  std::transform(local_records.begin(), local_records.end(), calls.begin(),
+                 [](Record const &r) { return static_cast<double>(r.calls); });
+
+  std::vector<double> result(4 * n_sections);
+  auto const n = static_cast<int>(n_sections);
+  boost::mpi::reduce(comm_cart, times.data(), n, result.data(),
+                     boost::mpi::minimum<double>(), 0);
+  boost::mpi::reduce(comm_cart, times.data(), n, result.data() + n,
+                     boost::mpi::maximum<double>(), 0);
+  boost::mpi::reduce(comm_cart, times.data(), n, result.data() + 2 * n,
+                     std::plus<double>(), 0);
+  boost::mpi::reduce(comm_cart, calls.data(), n, result.data() + 3 * n,
+                     boost::mpi::maximum<double>(), 0);
+  return result;
+}
+
+REGISTER_CALLBACK_MASTER_RANK(statistics_local)
+
+void reset_local() { local_records.fill(Record{}); }
+
+REGISTER_CALLBACK(reset_local)
+} // namespace
+
+std::vector<Statistics> statistics() {
+  auto const reduced =
+      mpi_call(::Communication::Result::master_rank, statistics_local);
+  auto const n_ranks = static_cast<double>(comm_cart.size());
+
+  std::vector<Statistics> result;
+  for (std::size_t i = 0; i < n_sections; i++) {
+    result.push_back({section_name(static_cast<Section>(i)),
+                      static_cast<long>(reduced[3 * n_sections + i]),
+                      reduced[i], reduced[n_sections + i],
+                      reduced[2 * n_sections + i] / n_ranks});
+  }
+  return result;
+}
+
+void reset() { mpi_call_all(reset_local); }
+} // namespace Timings
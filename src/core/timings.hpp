@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2021 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef CORE_TIMINGS_HPP
+#define CORE_TIMINGS_HPP
+/** \file
+ *  Wall-clock timings of the hot paths of the integration.
+ *
+ *  Every rank accumulates the time spent in a fixed set of sections
+ *  (@ref Timings::Section) by means of @ref Timings::ScopedTimer.
+ *  The accumulated times can be collected on the head node with
+ *  @ref Timings::statistics, which reduces them over all ranks.
+ *
+ *  Implementation in timings.cpp.
+ */
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace Timings {
+/** @brief Timed sections. */
+enum class Section : std::size_t {
+  FORCE_CALC,
+  SHORT_RANGE_LOOP,
+  GHOST_COMMUNICATION,
+  RESORT,
+  P3M_CHARGE_ASSIGNMENT,
+  P3M_FFT,
+  P3M_BACK_INTERPOLATION,
+  LB_COLLIDE_STREAM,
+  LB_COUPLING,
+  N_SECTIONS
+};
+
+constexpr auto n_sections = static_cast<std::size_t>(Section::N_SECTIONS);
+
+/** @brief Time and number of calls of a section on this rank. */
+struct Record {
+  double time = 0.;
+  long calls = 0;
+};
+
+/** @brief Records of this rank, indexed by @ref Section. */
+extern std::array<Record, n_sections> local_records;
+
+/**
+ * @brief Accumulate the time from construction to destruction.
+ *
+ * Timers of the same section must not be nested, otherwise the
+ * time of the inner scope is counted twice.
+ */
+class ScopedTimer {
+  using clock = std::chrono::steady_clock;
+
+  Record &m_record;
+  clock::time_point m_start;
+
+public:
+  explicit ScopedTimer(Section section)
+      : m_record(local_records[static_cast<std::size_t>(section)]),
+        m_start(clock::now()) {}
+  ScopedTimer(ScopedTimer const &) = delete;
+  ScopedTimer &operator=(ScopedTimer const &) = delete;
+  ~ScopedTimer() {
+    m_record.time +=
+        std::chrono::duration<double>(clock::now() - m_start).count();
+    m_record.calls++;
+  }
+};
+
+/** @brief Timings of a section reduced over all ranks. */
+struct Statistics {
+  std::string name;
+  /** Largest number of calls on any rank. */
+  long calls;
+  /** Smallest accumulated time of any rank in seconds. */
+  double min;
+  /** Largest accumulated time of any rank in seconds. */
+  double max;
+  /** Accumulated time averaged over the ranks in seconds. */
+  double avg;
+};
+
+/** @brief Name of a section. */
+std::string section_name(Section section);
+
+/**
+ * @brief Collect the timings of all sections from all ranks.
+ *
+ * Only valid on the head node.
+ */
+std::vector<Statistics> statistics();
+
+/** @brief Clear the timings on all ranks. */
+void reset();
+} // namespace Timings
+
+#endif
@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2021 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#define BOOST_TEST_MODULE BondLists test
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include "BondLists.hpp"
+#include "Particle.hpp"
+
+#include <utils/Span.hpp>
+
+#include <array>
+#include <tuple>
+#include <vector>
+
+BOOST_AUTO_TEST_CASE(empty) {
+  BondLists lists;
+  BOOST_CHECK(not lists.valid());
+  lists.clear();
+  BOOST_CHECK(lists.valid());
+  BOOST_CHECK(lists.groups().empty());
+  lists.invalidate();
+  BOOST_CHECK(not lists.valid());
+}
+
+BOOST_AUTO_TEST_CASE(groups) {
+  std::vector<Particle> p(4);
+  for (int i = 0; i < 4; i++) {
+    p[i].identity() = i;
+  }
+
+  BondLists lists;
+  lists.clear();
+
+  std::array<Particle *, 1> const pair{{&p[1]}};
+  std::array<Particle *, 2> const angle{{&p[0], &p[2]}};
+  lists.add(p[0], 3, Utils::make_const_span(pair));
+  lists.add(p[1], 1, Utils::make_const_span(angle));
+  lists.add(p[2], 3, Utils::make_const_span(angle));
+  lists.add(p[3], 3, Utils::make_const_span(pair));
+
+  /* Bonds are grouped by id and number of partners,
+   * in the order of their first appearance. */
+  auto &groups = lists.groups();
+  BOOST_REQUIRE_EQUAL(groups.size(), 3);
+  BOOST_CHECK_EQUAL(groups[0].bond_id(), 3);
+  BOOST_CHECK_EQUAL(groups[0].n_partners(), 1);
+  BOOST_REQUIRE_EQUAL(groups[0].size(), 2);
+  BOOST_CHECK_EQUAL(groups[1].bond_id(), 1);
+  BOOST_CHECK_EQUAL(groups[1].size(), 1);
+  BOOST_CHECK_EQUAL(groups[2].bond_id(), 3);
+  BOOST_CHECK_EQUAL(groups[2].n_partners(), 2);
+
+  auto const bond = groups[0][1];
+  BOOST_REQUIRE_EQUAL(bond.size(), 2);
+  BOOST_CHECK(bond[0] == &p[3]);
+  BOOST_CHECK(bond[1] == &p[1]);
+
+  /* for_each_bond visits every bond with its partners */
+  std::vector<std::tuple<int, int, int>> visited;
+  lists.for_each_bond(
+      [&](Particle &p1, int bond_id, Utils::Span<Particle *> partners) {
+        visited.emplace_back(p1.identity(), bond_id,
+                             partners[partners.size() - 1]->identity());
+        return false;
+      });
+  std::vector<std::tuple<int, int, int>> const expected{
+      {0, 3, 1}, {3, 3, 1}, {1, 1, 2}, {2, 3, 2}};
+  BOOST_CHECK(visited == expected);
+
+  /* Clearing keeps the groups, but removes the bonds */
+  lists.invalidate();
+  lists.clear();
+  BOOST_CHECK(lists.valid());
+  BOOST_CHECK_EQUAL(groups.size(), 3);
+  for (auto const &g : groups) {
+    BOOST_CHECK_EQUAL(g.size(), 0);
+  }
+}
@@ -0,0 +1,65 @@
+/*
+ * Copyright (C) 2021 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#define BOOST_TEST_MODULE CubicSplineTable test
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include "CubicSplineTable.hpp"
+
+#include <cmath>
+#include <limits>
+
+BOOST_AUTO_TEST_CASE(empty) {
+  CubicSplineTable table;
+  BOOST_CHECK_EQUAL(table.n_intervals(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(cubic_polynomials_are_exact) {
+  auto const f = [](double x) {
+    return 2. - x + 0.5 * x * x - 0.1 * x * x * x;
+  };
+  CubicSplineTable table(f, -1., 3., 4);
+
+  BOOST_CHECK_EQUAL(table.n_intervals(), 4);
+  BOOST_CHECK_EQUAL(table.minval(), -1.);
+  BOOST_CHECK_EQUAL(table.maxval(), 3.);
+  for (double x = -1.; x <= 3.; x += 0.01) {
+    BOOST_CHECK_SMALL(table(x) - f(x), 1e-12);
+  }
+  BOOST_CHECK_SMALL(table.max_relative_deviation(f), 1e-12);
+}
+
+BOOST_AUTO_TEST_CASE(convergence) {
+  /* Force factor of the Lennard-Jones potential in the squared
+   * distance, the error is of fourth order in the interval size,
+   * up to the variation of the relative error close to the zero. */
+  auto const f = [](double r2) {
+    auto const frac6 = 1. / (r2 * r2 * r2);
+    return 48. * frac6 * (frac6 - 0.5) / r2;
+  };
+
+  double previous = std::numeric_limits<double>::max();
+  for (int n = 64; n <= 1024; n *= 2) {
+    CubicSplineTable table(f, 0.8, 6.25, n);
+    auto const deviation = table.max_relative_deviation(f);
+    BOOST_CHECK_LT(deviation, previous / 8.);
+    previous = deviation;
+  }
+  BOOST_CHECK_LT(previous, 1e-6);
+}
@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) 2021 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#define BOOST_TEST_MODULE ParticleIndex test
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include "Particle.hpp"
+#include "ParticleIndex.hpp"
+
+#include <map>
+#include <random>
+#include <vector>
+
+BOOST_AUTO_TEST_CASE(empty) {
+  for (auto const sparse : {false, true}) {
+    ParticleIndex index;
+    index.set_sparse(sparse);
+    BOOST_CHECK_EQUAL(index.sparse(), sparse);
+    BOOST_CHECK(index.get(0) == nullptr);
+    BOOST_CHECK(index.get(12345) == nullptr);
+    BOOST_CHECK_EQUAL(index.max_id(), -1);
+
+    /* Removing an entry that does not exist does not allocate */
+    index.set(1000, nullptr);
+    BOOST_CHECK_EQUAL(index.memory(), 0);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(set_get_remove) {
+  std::vector<Particle> particles(3);
+  for (auto const sparse : {false, true}) {
+    ParticleIndex index;
+    index.set_sparse(sparse);
+
+    index.set(5, &particles[0]);
+    index.set(100000, &particles[1]);
+    index.set(7, &particles[2]);
+    BOOST_CHECK(index.get(5) == &particles[0]);
+    BOOST_CHECK(index.get(100000) == &particles[1]);
+    BOOST_CHECK(index.get(7) == &particles[2]);
+    BOOST_CHECK(index.get(6) == nullptr);
+    BOOST_CHECK_EQUAL(index.max_id(), 100000);
+
+    /* Overwrite */
+    index.set(5, &particles[2]);
+    BOOST_CHECK(index.get(5) == &particles[2]);
+
+    index.set(100000, nullptr);
+    BOOST_CHECK(index.get(100000) == nullptr);
+    BOOST_CHECK_EQUAL(index.max_id(), 7);
+
+    auto const memory = index.memory();
+    index.clear();
+    BOOST_CHECK(index.get(5) == nullptr);
+    BOOST_CHECK(index.get(7) == nullptr);
+    BOOST_CHECK_EQUAL(index.max_id(), -1);
+    if (sparse) {
+      BOOST_CHECK_EQUAL(index.memory(), memory);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(sparse_memory) {
+  std::vector<Particle> particles(10);
+  ParticleIndex dense, sparse;
+  sparse.set_sparse(true);
+  for (int i = 0; i < 10; i++) {
+    dense.set(1000000 + i, &particles[i]);
+    sparse.set(1000000 + i, &particles[i]);
+  }
+
+  BOOST_CHECK_LT(sparse.memory(), dense.memory() / 100);
+}
+
+BOOST_AUTO_TEST_CASE(sparse_random_operations) {
+  /* Compare against a reference map under random insertions and
+   * removals, which exercises the growth of the table and the
+   * backward shift of the probe sequences on removal. */
+  std::vector<Particle> particles(64);
+  std::map<int, Particle *> reference;
+
+  ParticleIndex index;
+  index.set_sparse(true);
+  index.reserve(8);
+
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int> id_dist(0, 500);
+  std::uniform_int_distribution<int> p_dist(0, 63);
+
+  for (int step = 0; step < 20000; step++) {
+    auto const id = id_dist(gen);
+    /* Every third update is a removal */
+    if (step % 3 == 0) {
+      index.set(id, nullptr);
+      reference.erase(id);
+    } else {
+      auto const p = &particles[p_dist(gen)];
+      index.set(id, p);
+      reference[id] = p;
+    }
+
+    if (step % 1000 == 0) {
+      for (int j = 0; j <= 500; j++) {
+        auto const it = reference.find(j);
+        auto const expected = (it == reference.end()) ? nullptr : it->second;
+        BOOST_REQUIRE(index.get(j) == expected);
+      }
+      auto const max_id = reference.empty() ? -1 : reference.rbegin()->first;
+      BOOST_REQUIRE_EQUAL(index.max_id(), max_id);
+    }
+  }
+}
@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2020 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#define BOOST_TEST_MODULE VerletList test
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include "ParticleList.hpp"
+#include "VerletList.hpp"
+
+#include <utility>
+#include <vector>
+
+static ParticleList make_particles(int first_id, int n) {
+  ParticleList particles;
+  for (int i = 0; i < n; i++) {
+    Particle p;
+    p.p.identity = first_id + i;
+    particles.insert(std::move(p));
+  }
+  return particles;
+}
+
+BOOST_AUTO_TEST_CASE(empty) {
+  VerletList vl;
+  vl.clear();
+
+  BOOST_CHECK_EQUAL(vl.size(), 0);
+  BOOST_CHECK_EQUAL(vl.n_rows(), 0);
+
+  auto n_pairs = 0;
+  vl.for_each_pair([&n_pairs](Particle &, Particle &) { n_pairs++; });
+  BOOST_CHECK_EQUAL(n_pairs, 0);
+}
+
+BOOST_AUTO_TEST_CASE(sources_and_rows) {
+  auto cell = make_particles(0, 3);
+  auto empty_neighbor = make_particles(10, 0);
+  auto neighbor = make_particles(20, 4);
+
+  VerletList vl;
+  vl.clear();
+  BOOST_CHECK_EQUAL(vl.add_source(cell), 0);
+  BOOST_CHECK_EQUAL(vl.add_source(empty_neighbor), 3);
+  BOOST_CHECK_EQUAL(vl.add_source(neighbor), 3);
+
+  /* Particle 0: partners 1 (cell) and 21, 23 (neighbor) */
+  vl.begin_row();
+  vl.add_partner(1);
+  vl.add_partner(4);
+  vl.add_partner(6);
+  /* Particle 1: no partners */
+  vl.begin_row();
+  /* Particle 2: partner 20 */
+  vl.begin_row();
+  vl.add_partner(3);
+
+  BOOST_CHECK_EQUAL(vl.size(), 4);
+  BOOST_CHECK_EQUAL(vl.n_rows(), 3);
+  BOOST_CHECK_GT(vl.memory(), 0);
+
+  std::vector<std::pair<int, int>> pairs;
+  vl.for_each_pair([&pairs](Particle &p1, Particle &p2) {
+    pairs.emplace_back(p1.identity(), p2.identity());
+  });
+
+  std::vector<std::pair<int, int>> const expected = {
+      {0, 1}, {0, 21}, {0, 23}, {2, 20}};
+  BOOST_CHECK(pairs == expected);
+
+  /* Clearing keeps the memory */
+  auto const memory = vl.memory();
+  vl.clear();
+  BOOST_CHECK_EQUAL(vl.size(), 0);
+  BOOST_CHECK_EQUAL(vl.memory(), memory);
+}
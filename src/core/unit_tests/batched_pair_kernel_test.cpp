@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2020 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/* Unit tests for the batched non-bonded pair kernel. */
+
+#define BOOST_TEST_MODULE Batched pair kernel test
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include "config.hpp"
+
+#include "BoxGeometry.hpp"
+#include "Particle.hpp"
+#include "ParticleList.hpp"
+#include "ParticleSoA.hpp"
+#include "forces_inline.hpp"
+#include "nonbonded_interactions/batched_pair_kernel.hpp"
+#include "nonbonded_interactions/nonbonded_interaction_data.hpp"
+
+#include <utils/Vector.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+
+auto const tol = 100 * 100 * std::numeric_limits<double>::epsilon();
+
+BOOST_AUTO_TEST_CASE(batched_vs_pairwise) {
+  /* Three types: LJ between 0 and 0, WCA between 0 and 1,
+   * soft-sphere between 1 and 2, nothing otherwise. */
+  make_particle_type_exist_local(2);
+#ifdef LENNARD_JONES
+  get_ia_param(0, 0)->lj = {1.2, 1.0, 2.5, 0.0, 0.1, 0.0};
+#endif
+#ifdef WCA
+  get_ia_param(0, 1)->wca = {0.8, 1.1, 1.1 * std::pow(2., 1. / 6.)};
+#endif
+#ifdef SOFT_SPHERE
+  get_ia_param(1, 2)->soft_sphere = {2.0, 3.5, 2.0, 0.2};
+#endif
+  recalc_nonbonded_ia_params();
+  BOOST_REQUIRE(BatchedPairKernel::applicable());
+
+  /* Particles on a slightly perturbed line, at distances between
+   * 0.8 and 3.1 from the first one, more than one block */
+  ParticleList particles;
+  for (int i = 0; i < 150; i++) {
+    Particle p;
+    p.p.identity = i;
+    p.p.type = i % 3;
+    p.r.p = {(i == 0) ? 0. : 0.8 + 0.015 * i, 0.01 * (i % 7),
+             -0.01 * (i % 5)};
+    particles.insert(std::move(p));
+  }
+
+  ParticleSoA soa;
+  soa.pack(particles);
+
+  BatchedPairKernel::add_forces(soa, 0, soa, 1, soa.size(),
+                                BatchedPairKernel::MinimalImage{});
+
+  Utils::Vector3d f0{};
+  for (std::size_t j = 1; j < soa.size(); j++) {
+    auto const d = soa.pos(0) - soa.pos(j);
+    auto const &ia = *get_ia_param(soa.type(0), soa.type(j));
+    auto const f = calc_central_radial_force_factor(ia, d.norm()) * d;
+    f0 += f;
+    for (int k = 0; k < 3; k++) {
+      BOOST_CHECK_SMALL(soa.force(j)[k] + f[k], tol * (1. + f.norm()));
+    }
+  }
+  BOOST_CHECK(f0.norm() > 0.);
+  for (int k = 0; k < 3; k++) {
+    BOOST_CHECK_SMALL(soa.force(0)[k] - f0[k], tol * f0.norm());
+  }
+}
+
+BOOST_AUTO_TEST_CASE(minimal_image) {
+  BoxGeometry box;
+  box.set_length({10., 20., 30.});
+  box.set_periodic(2, false);
+
+  auto const mi = BatchedPairKernel::minimal_image(box);
+  BOOST_CHECK(mi.length == Utils::Vector3d({10., 20., 0.}));
+  BOOST_CHECK(mi.length_inv == Utils::Vector3d({0.1, 0.05, 0.}));
+}
@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2020 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <atomic>
+#include <set>
+#include <vector>
+
+#define BOOST_TEST_MODULE colored cells test
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include "algorithm/colored_cells.hpp"
+
+#include <utils/Vector.hpp>
+
+/** Periodic grid of cells with a half-shell of red neighbors. */
+struct Cell {
+  std::vector<Cell *> m_red;
+  int visits = 0;
+
+  struct NeighborRange {
+    std::vector<Cell *> const &red_;
+    std::vector<Cell *> const &red() const { return red_; }
+  };
+  NeighborRange neighbors() const { return {m_red}; }
+};
+
+static std::vector<Cell> make_grid(Utils::Vector3i const &n) {
+  std::vector<Cell> cells(n[0] * n[1] * n[2]);
+  auto index = [&n](int x, int y, int z) {
+    return ((x + n[0]) % n[0]) + n[0] * (((y + n[1]) % n[1]) +
+                                         n[1] * ((z + n[2]) % n[2]));
+  };
+
+  for (int x = 0; x < n[0]; x++)
+    for (int y = 0; y < n[1]; y++)
+      for (int z = 0; z < n[2]; z++) {
+        auto &c = cells[index(x, y, z)];
+        /* The 13 neighbors with a lexicographically larger offset */
+        for (int dx = -1; dx <= 1; dx++)
+          for (int dy = -1; dy <= 1; dy++)
+            for (int dz = -1; dz <= 1; dz++) {
+              if ((dx > 0) or (dx == 0 and dy > 0) or
+                  (dx == 0 and dy == 0 and dz > 0)) {
+                c.m_red.push_back(&cells[index(x + dx, y + dy, z + dz)]);
+              }
+            }
+      }
+
+  return cells;
+}
+
+BOOST_AUTO_TEST_CASE(color_cells) {
+  auto cells = make_grid({6, 5, 4});
+
+  auto const colors = Algorithm::color_cells(cells.begin(), cells.end());
+
+  /* Every cell has exactly one color */
+  std::set<Cell const *> colored;
+  for (auto const &color : colors) {
+    for (auto c : color) {
+      BOOST_CHECK(colored.insert(c).second);
+    }
+  }
+  BOOST_CHECK_EQUAL(colored.size(), cells.size());
+
+  /* The write sets of the cells of one color are disjoint */
+  for (auto const &color : colors) {
+    std::set<Cell const *> written;
+    for (auto c : color) {
+      BOOST_CHECK(written.insert(c).second);
+      for (auto n : c->m_red) {
+        BOOST_CHECK(written.insert(n).second);
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(for_each_colored_cell) {
+  auto cells = make_grid({4, 4, 4});
+  auto const colors = Algorithm::color_cells(cells.begin(), cells.end());
+
+  /* Emulate a half-shell pair loop: write to the cell and its neighbors */
+  Algorithm::for_each_colored_cell(colors, 4, [](Cell &c) {
+    c.visits++;
+    for (auto n : c.m_red) {
+      n->visits++;
+    }
+  });
+
+  /* Every cell is written by itself and by the 13 cells
+   * that have it as a red neighbor */
+  for (auto const &c : cells) {
+    BOOST_CHECK_EQUAL(c.visits, 14);
+  }
+}
@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) 2020 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_NO_MAIN
+#define BOOST_TEST_MODULE ghost communication test
+#define BOOST_TEST_ALTERNATIVE_INIT_API
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include "ghosts.hpp"
+
+#include <boost/mpi.hpp>
+
+#include <cstddef>
+
+namespace {
+/**
+ * @brief Ghost layers on a ring of ranks.
+ *
+ * Every rank has one list of real particles, and receives the
+ * real particles of its left neighbor into @c ghosts1, which
+ * are forwarded into @c ghosts2 of the right neighbor. Rank r
+ * has r + 1 real particles.
+ */
+struct Ring {
+  boost::mpi::communicator comm;
+  int left, right;
+  ParticleList local, ghosts1, ghosts2;
+  GhostCommunicator exchange, collect;
+
+  Ring()
+      : left((comm.rank() + comm.size() - 1) % comm.size()),
+        right((comm.rank() + 1) % comm.size()), exchange(comm, 4),
+        collect(comm, 4) {
+    auto const n_part = [this](int rank) {
+      return ((rank + comm.size()) % comm.size()) + 1;
+    };
+
+    for (int i = 0; i < n_part(comm.rank()); i++) {
+      Particle p;
+      p.r.p = {1. * comm.rank(), 1. * i, 0.};
+      local.insert(p);
+    }
+    ghosts1.resize(n_part(comm.rank() - 1));
+    ghosts2.resize(n_part(comm.rank() - 2));
+
+    exchange.communications[0] = {GHOST_SEND, right, {&local}, {1., 0., 0.}};
+    exchange.communications[1] = {GHOST_RECV, left, {&ghosts1}};
+    /* Depends on the previous receive */
+    exchange.communications[2] = {GHOST_SEND, right, {&ghosts1}, {0., 1., 0.}};
+    exchange.communications[3] = {GHOST_RECV, left, {&ghosts2}};
+
+    collect.communications[0] = {GHOST_SEND, left, {&ghosts2}};
+    collect.communications[1] = {GHOST_RECV, right, {&ghosts1}};
+    collect.communications[2] = {GHOST_SEND, left, {&ghosts1}};
+    collect.communications[3] = {GHOST_RECV, right, {&local}};
+  }
+
+  int origin(int shift) const {
+    return (comm.rank() + comm.size() - shift) % comm.size();
+  }
+
+  void check_positions() const {
+    for (std::size_t i = 0; i < ghosts1.size(); i++) {
+      auto const expected = Utils::Vector3d{1. * origin(1) + 1., 1. * i, 0.};
+      BOOST_CHECK(ghosts1.begin()[i].r.p == expected);
+    }
+    for (std::size_t i = 0; i < ghosts2.size(); i++) {
+      auto const expected =
+          Utils::Vector3d{1. * origin(2) + 1., 1. * i + 1., 0.};
+      BOOST_CHECK(ghosts2.begin()[i].r.p == expected);
+    }
+  }
+
+  void set_forces() {
+    for (auto list : {&local, &ghosts1, &ghosts2}) {
+      for (auto &p : *list) {
+        p.f.f = {1., 0., 0.};
+      }
+    }
+  }
+
+  void check_forces() const {
+    for (auto const &p : local) {
+      BOOST_CHECK((p.f.f == Utils::Vector3d{3., 0., 0.}));
+    }
+  }
+};
+} // namespace
+
+BOOST_AUTO_TEST_CASE(blocking) {
+  Ring ring;
+
+  ghost_communicator(ring.exchange, GHOSTTRANS_POSITION);
+  ring.check_positions();
+
+  ring.set_forces();
+  ghost_communicator(ring.collect, GHOSTTRANS_FORCE);
+  ring.check_forces();
+}
+
+BOOST_AUTO_TEST_CASE(async) {
+  Ring ring;
+  AsyncGhostCommunication async_comm;
+
+  async_comm.begin(ring.exchange, GHOSTTRANS_POSITION);
+  /* The real particles can be accessed in the meantime */
+  for (auto const &p : ring.local) {
+    BOOST_CHECK_EQUAL(p.r.p[0], 1. * ring.comm.rank());
+  }
+  async_comm.progress();
+  async_comm.wait();
+  BOOST_CHECK(not async_comm.pending());
+  ring.check_positions();
+
+  ring.set_forces();
+  async_comm.begin(ring.collect, GHOSTTRANS_FORCE);
+  while (async_comm.pending()) {
+    async_comm.progress();
+  }
+  ring.check_forces();
+}
+
+int main(int argc, char **argv) {
+  boost::mpi::environment mpi_env(argc, argv);
+
+  return boost::unit_test::unit_test_main(init_unit_test, argc, argv);
+}
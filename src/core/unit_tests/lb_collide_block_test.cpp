@@ -0,0 +1,218 @@
+/*
+ * Copyright (C) 2020 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE LB block collision test
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include "grid_based_algorithms/lb-d3q19.hpp"
+#include "grid_based_algorithms/lb_collide_block.hpp"
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <random>
+#include <utility>
+
+namespace {
+using Vector19 = std::array<double, 19>;
+
+/** Mode basis vectors e_ki, from their definition in @cite dunweg07a */
+std::array<Vector19, 19> mode_basis() {
+  std::array<Vector19, 19> e{};
+  for (int i = 0; i < 19; i++) {
+    auto const x = D3Q19::c[i][0], y = D3Q19::c[i][1], z = D3Q19::c[i][2];
+    auto const c2 = x * x + y * y + z * z;
+    e[0][i] = 1.;
+    e[1][i] = x;
+    e[2][i] = y;
+    e[3][i] = z;
+    e[4][i] = c2 - 1.;
+    e[5][i] = x * x - y * y;
+    e[6][i] = c2 - 3. * z * z;
+    e[7][i] = x * y;
+    e[8][i] = x * z;
+    e[9][i] = y * z;
+    e[10][i] = (3. * c2 - 5.) * x;
+    e[11][i] = (3. * c2 - 5.) * y;
+    e[12][i] = (3. * c2 - 5.) * z;
+    e[13][i] = (y * y - z * z) * x;
+    e[14][i] = (x * x - z * z) * y;
+    e[15][i] = (x * x - y * y) * z;
+    e[16][i] = 3. * c2 * c2 - 6. * c2 + 1.;
+    e[17][i] = (2. * c2 - 3.) * (x * x - y * y);
+    e[18][i] = (2. * c2 - 3.) * (c2 - 3. * z * z);
+  }
+  return e;
+}
+
+/** Straightforward collision of one node in mode space */
+Vector19 reference_collision(Vector19 const &n, Utils::Vector3d const &f,
+                             Vector19 const &noise, LB_Parameters const &p) {
+  auto const e = mode_basis();
+
+  Vector19 m{};
+  for (int k = 0; k < 19; k++) {
+    for (int i = 0; i < 19; i++) {
+      m[k] += e[k][i] * n[i];
+    }
+  }
+
+  auto const density = m[0] + p.density;
+  auto const j = Utils::Vector3d{m[1], m[2], m[3]} + 0.5 * f;
+  auto const u = j / density;
+
+  Vector19 stress_eq{};
+  stress_eq[4] = j.norm2() / density;
+  stress_eq[5] = (j[0] * j[0] - j[1] * j[1]) / density;
+  stress_eq[6] = (j.norm2() - 3. * j[2] * j[2]) / density;
+  stress_eq[7] = j[0] * j[1] / density;
+  stress_eq[8] = j[0] * j[2] / density;
+  stress_eq[9] = j[1] * j[2] / density;
+
+  m[4] = stress_eq[4] + p.gamma_bulk * (m[4] - stress_eq[4]);
+  for (int k = 5; k < 10; k++) {
+    m[k] = stress_eq[k] + p.gamma_shear * (m[k] - stress_eq[k]);
+  }
+  for (int k = 10; k < 16; k++) {
+    m[k] *= p.gamma_odd;
+  }
+  for (int k = 16; k < 19; k++) {
+    m[k] *= p.gamma_even;
+  }
+
+  if (p.kT > 0.) {
+    for (int k = 4; k < 19; k++) {
+      m[k] += std::sqrt(12. * std::fabs(density)) * p.phi[k] * noise[k - 4];
+    }
+  }
+
+  /* Forcing, the stress modes get C_ab projected onto the basis */
+  double C[3][3];
+  for (int a = 0; a < 3; a++) {
+    for (int b = 0; b < 3; b++) {
+      C[a][b] = 0.5 * (1. + p.gamma_shear) * (u[a] * f[b] + u[b] * f[a]);
+    }
+    C[a][a] = (1. + p.gamma_bulk) * u[a] * f[a] +
+              1. / 3. * (p.gamma_bulk - p.gamma_shear) * (u * f);
+  }
+  for (int k = 1; k < 4; k++) {
+    m[k] += f[k - 1];
+  }
+  m[4] += C[0][0] + C[1][1] + C[2][2];
+  m[5] += C[0][0] - C[1][1];
+  m[6] += C[0][0] + C[1][1] - 2. * C[2][2];
+  m[7] += C[0][1];
+  m[8] += C[0][2];
+  m[9] += C[1][2];
+
+  Vector19 result{};
+  for (int i = 0; i < 19; i++) {
+    for (int k = 0; k < 19; k++) {
+      result[i] += D3Q19::w[i] * e[k][i] * m[k] / D3Q19::w_k[k];
+    }
+  }
+  return result;
+}
+
+LB_Parameters parameters(double kT) {
+  LB_Parameters p{};
+  p.density = 0.9;
+  p.gamma_bulk = -0.2;
+  p.gamma_shear = 0.3;
+  p.gamma_odd = 0.4;
+  p.gamma_even = -0.5;
+  p.kT = kT;
+  for (int k = 4; k < 19; k++) {
+    p.phi[k] = 0.01 * k;
+  }
+  return p;
+}
+
+void check_against_reference(LB_Parameters const &p, std::size_t n_nodes) {
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<double> dist(-0.01, 0.01);
+
+  LB_NodeBlock block;
+  std::array<Vector19, lb_block_size> n{}, noise{};
+  std::array<Utils::Vector3d, lb_block_size> f{};
+  for (std::size_t j = 0; j < n_nodes; j++) {
+    for (int i = 0; i < 19; i++) {
+      n[j][i] = block.n[i][j] = dist(gen);
+    }
+    for (int c = 0; c < 3; c++) {
+      f[j][c] = block.force_density[c][j] = dist(gen);
+    }
+    for (int k = 0; k < 15; k++) {
+      noise[j][k] = block.noise[k][j] = 50. * dist(gen);
+    }
+  }
+
+  lb_collide_block(block, n_nodes, p);
+
+  for (std::size_t j = 0; j < n_nodes; j++) {
+    auto const expected = reference_collision(n[j], f[j], noise[j], p);
+    for (int i = 0; i < 19; i++) {
+      BOOST_CHECK_SMALL(block.n[i][j] - expected[i], 1e-14);
+    }
+  }
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(athermal) {
+  check_against_reference(parameters(0.), lb_block_size);
+  check_against_reference(parameters(0.), 3);
+}
+
+BOOST_AUTO_TEST_CASE(thermalized) {
+  check_against_reference(parameters(1.), lb_block_size);
+}
+
+BOOST_AUTO_TEST_CASE(conservation) {
+  auto const p = parameters(0.);
+  LB_NodeBlock block;
+  Utils::Vector3d const f = {0.001, -0.002, 0.003};
+  for (int i = 0; i < 19; i++) {
+    block.n[i][0] = 0.001 * i;
+  }
+  for (int c = 0; c < 3; c++) {
+    block.force_density[c][0] = f[c];
+  }
+
+  auto const moments = [&block]() {
+    double mass = 0.;
+    Utils::Vector3d momentum{};
+    for (int i = 0; i < 19; i++) {
+      mass += block.n[i][0];
+      for (int c = 0; c < 3; c++) {
+        momentum[c] += D3Q19::c[i][c] * block.n[i][0];
+      }
+    }
+    return std::make_pair(mass, momentum);
+  };
+
+  auto const before = moments();
+  lb_collide_block(block, 1, p);
+  auto const after = moments();
+
+  BOOST_CHECK_SMALL(after.first - before.first, 1e-15);
+  for (int c = 0; c < 3; c++) {
+    BOOST_CHECK_SMALL(after.second[c] - before.second[c] - f[c], 1e-15);
+  }
+}
@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2020 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#define BOOST_TEST_MODULE link_cell_soa test
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include "Cell.hpp"
+#include "algorithm/link_cell_soa.hpp"
+
+#include <utils/Vector.hpp>
+
+BOOST_AUTO_TEST_CASE(link_cell_soa) {
+  const unsigned n_cells = 10;
+  const auto n_part_per_cell = 10;
+  const auto n_part = n_cells * n_part_per_cell;
+
+  std::vector<Cell> cells(n_cells);
+
+  auto id = 0;
+  for (auto it = cells.begin(); it != cells.end(); ++it) {
+    auto &c = *it;
+    /* Half-shell: every pair of cells is visited once */
+    std::vector<Cell *> neighbors;
+    for (auto jt = std::next(it); jt != cells.end(); ++jt) {
+      neighbors.push_back(&(*jt));
+    }
+
+    c.m_neighbors = Neighbors<Cell *>(neighbors, {});
+
+    c.particles().resize(n_part_per_cell);
+
+    for (auto &p : c.particles()) {
+      p.p.identity = id;
+      p.p.type = id % 3;
+      p.r.p = {1. * id, 0., 0.};
+      id++;
+    }
+
+    c.m_soa.pack(c.particles());
+  }
+
+  std::vector<std::pair<int, int>> lc_pairs;
+  lc_pairs.reserve((n_part * (n_part - 1)) / 2);
+
+  Algorithm::link_cell_soa(
+      cells.begin(), cells.end(),
+      [&lc_pairs](ParticleSoA &soa1, std::size_t i, ParticleSoA &soa2,
+                  std::size_t j, Utils::Vector3d const &d) {
+        auto const &p1 = soa1.particle(i);
+        auto const &p2 = soa2.particle(j);
+        /* Check that the mirror is consistent with the particles */
+        BOOST_CHECK(soa1.type(i) == p1.p.type);
+        BOOST_CHECK(soa2.type(j) == p2.p.type);
+        /* Check that the "distance function" has been called with the correct
+         * arguments */
+        BOOST_CHECK(d == p1.r.p - p2.r.p);
+
+        /* Forces are accumulated in the mirror */
+        soa1.add_force(i, {1., 0., 0.});
+        soa2.add_force(j, {1., 0., 0.});
+
+        lc_pairs.emplace_back(std::min(p1.p.identity, p2.p.identity),
+                              std::max(p1.p.identity, p2.p.identity));
+      },
+      [](Utils::Vector3d const &a, Utils::Vector3d const &b) { return a - b; });
+
+  BOOST_CHECK(lc_pairs.size() == (n_part * (n_part - 1) / 2));
+
+  std::sort(lc_pairs.begin(), lc_pairs.end());
+  auto it = lc_pairs.begin();
+  for (int i = 0; i < n_part; i++)
+    for (int j = i + 1; j < n_part; j++) {
+      BOOST_CHECK((it->first == i) && (it->second == j));
+      ++it;
+    }
+
+  /* Every particle takes part in n_part - 1 pairs */
+  for (auto &c : cells) {
+    c.m_soa.scatter_forces();
+    for (auto const &p : c.particles()) {
+      BOOST_CHECK(p.f.f == Utils::Vector3d({n_part - 1., 0., 0.}));
+    }
+  }
+}
@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2020 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+/* Unit tests for the dispatch of the non-bonded potentials by type pair. */
+
+#define BOOST_TEST_MODULE Non-bonded dispatch test
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include "config.hpp"
+
+#include "forces_inline.hpp"
+#include "nonbonded_interactions/nonbonded_interaction_data.hpp"
+
+#include <cmath>
+#include <limits>
+
+auto const tol = 100 * std::numeric_limits<double>::epsilon();
+
+BOOST_AUTO_TEST_CASE(default_parameters) {
+  /* No potential is active for the default parameters */
+  BOOST_CHECK_EQUAL(IA_parameters{}.potentials, 0u);
+
+  /* New type pairs are initialized with the default parameters */
+  make_particle_type_exist_local(1);
+  BOOST_CHECK_EQUAL(get_ia_param(0, 1)->potentials, 0u);
+  BOOST_CHECK_LE(get_ia_param(0, 1)->max_cut, 0.);
+}
+
+BOOST_AUTO_TEST_CASE(dispatch) {
+  /* Type pairs without potential, with a single potential,
+   * and with several potentials */
+  make_particle_type_exist_local(3);
+#ifdef WCA
+  get_ia_param(0, 1)->wca = {0.8, 1.1, 1.1 * std::pow(2., 1. / 6.)};
+  get_ia_param(2, 2)->wca = {1.0, 1.0, std::pow(2., 1. / 6.)};
+#endif
+#ifdef LENNARD_JONES
+  get_ia_param(1, 1)->lj = {1.2, 1.0, 2.5, 0.0, 0.1, 0.0};
+  get_ia_param(2, 2)->lj = {0.5, 1.2, 2.0, 0.1, 0.0, 0.0};
+#endif
+#ifdef GAUSSIAN
+  get_ia_param(2, 2)->gaussian = {2.0, 0.7, 1.8};
+#endif
+  recalc_nonbonded_ia_params();
+
+  BOOST_CHECK_EQUAL(get_ia_param(0, 0)->potentials, 0u);
+#ifdef WCA
+  BOOST_CHECK_EQUAL(get_ia_param(0, 1)->potentials, unsigned(NB_WCA));
+#endif
+#ifdef LENNARD_JONES
+  BOOST_CHECK_EQUAL(get_ia_param(1, 1)->potentials,
+                    unsigned(NB_LENNARD_JONES));
+#endif
+
+  /* The selected kernel agrees with the evaluation of all potentials */
+  for (int i = 0; i < 3; i++) {
+    for (int j = i; j < 3; j++) {
+      auto const &ia = *get_ia_param(i, j);
+      for (double dist = 0.5; dist < 3.; dist += 0.01) {
+        auto const expected =
+            calc_central_radial_force_factor(ia, dist, NB_ALL_POTENTIALS);
+        BOOST_CHECK_SMALL(calc_central_radial_force_factor(ia, dist) -
+                              expected,
+                          tol * (1. + std::abs(expected)));
+      }
+    }
+  }
+}
@@ -25,6 +25,10 @@ from .utils cimport Vector3i
 cdef extern from "communication.hpp":
     void mpi_bcast_cell_structure(int cs)
     void mpi_set_use_verlet_lists(bool use_verlet_lists)
+    void mpi_set_use_soa_mirror(bool use_soa_mirror)
+    void mpi_set_n_threads(int n_threads)
+    void mpi_set_overlap_ghost_communication(bool overlap)
+    void mpi_set_use_sparse_particle_index(bool sparse)
     int n_nodes
     vector[int] mpi_resort_particles(int global_flag)
 
@@ -35,6 +39,10 @@ cdef extern from "cells.hpp":
     ctypedef struct CellStructure:
         int decomposition_type()
         bool use_verlet_list
+        bool use_soa_mirror
+        int n_threads
+        bool overlap_ghost_communication
+        bool use_sparse_particle_index()
 
     CellStructure cell_structure
 
@@ -42,6 +50,15 @@ cdef extern from "cells.hpp":
 
     vector[pair[int, int]] mpi_get_pairs(double distance)
 
+    ctypedef struct VerletListStats:
+        int n_rebuilds
+        double pairs_per_particle
+        double memory
+
+    VerletListStats mpi_get_verlet_list_stats()
+
+    double mpi_get_particle_index_memory()
+
 cdef extern from "tuning.hpp":
     cdef void c_tune_skin "tune_skin" (double min_skin, double max_skin, double tol, int int_steps, bool adjust_max_skin)
 
@@ -16,6 +16,7 @@
 # You should have received a copy of the GNU General Public License
 # along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #
+include "myconfig.pxi"
 import numpy as np
 from libcpp.cast cimport dynamic_cast
 from .grid cimport node_grid
@@ -63,7 +64,13 @@ cdef class CellSystem:
         return True
 
     def get_state(self):
-        s = {"use_verlet_list": cell_structure.use_verlet_list}
+        s = {"use_verlet_list": cell_structure.use_verlet_list,
+             "use_soa_mirror": cell_structure.use_soa_mirror,
+             "n_threads": cell_structure.n_threads,
+             "overlap_ghost_communication":
+             cell_structure.overlap_ghost_communication,
+             "use_sparse_particle_index":
+             cell_structure.use_sparse_particle_index()}
 
         if cell_structure.decomposition_type() == CELL_STRUCTURE_DOMDEC:
             dd = get_domain_decomposition()
@@ -78,13 +85,26 @@ cdef class CellSystem:
 
         s["skin"] = skin
         s["verlet_reuse"] = verlet_reuse
+
+        vl_stats = mpi_get_verlet_list_stats()
+        s["verlet_list_rebuilds"] = vl_stats.n_rebuilds
+        s["verlet_list_pairs_per_particle"] = vl_stats.pairs_per_particle
+        s["verlet_list_memory"] = vl_stats.memory
+        s["particle_index_memory"] = mpi_get_particle_index_memory()
+
         s["n_nodes"] = n_nodes
         s["node_grid"] = np.array([node_grid[0], node_grid[1], node_grid[2]])
 
         return s
 
     def __getstate__(self):
-        s = {"use_verlet_list": cell_structure.use_verlet_list}
+        s = {"use_verlet_list": cell_structure.use_verlet_list,
+             "use_soa_mirror": cell_structure.use_soa_mirror,
+             "n_threads": cell_structure.n_threads,
+             "overlap_ghost_communication":
+             cell_structure.overlap_ghost_communication,
+             "use_sparse_particle_index":
+             cell_structure.use_sparse_particle_index()}
 
         if cell_structure.decomposition_type() == CELL_STRUCTURE_DOMDEC:
             s["type"] = "domain_decomposition"
@@ -100,6 +120,14 @@ cdef class CellSystem:
         for key in d:
             if key == "use_verlet_list":
                 use_verlet_lists = d[key]
+            elif key == "use_soa_mirror":
+                self.use_soa_mirror = d[key]
+            elif key == "n_threads":
+                self.n_threads = d[key]
+            elif key == "overlap_ghost_communication":
+                self.overlap_ghost_communication = d[key]
+            elif key == "use_sparse_particle_index":
+                self.use_sparse_particle_index = d[key]
             elif key == "type":
                 if d[key] == "domain_decomposition":
                     self.set_domain_decomposition(
@@ -151,6 +179,73 @@ cdef class CellSystem:
         def __get__(self):
             return np.array([node_grid[0], node_grid[1], node_grid[2]])
 
+    property use_soa_mirror:
+        """
+        Evaluate the non-bonded pair forces on a structure-of-arrays
+        copy of the particle positions, types and charges. Only used
+        if all active pair interactions are central potentials, i.e.
+        without electrostatics, magnetostatics, DPD, exclusions or
+        collision detection. Otherwise the regular pair loop is used.
+
+        """
+
+        def __set__(self, bool _use_soa_mirror):
+            mpi_set_use_soa_mirror(_use_soa_mirror)
+
+        def __get__(self):
+            return cell_structure.use_soa_mirror
+
+    property n_threads:
+        """
+        Number of threads used by each MPI rank for the non-bonded pair
+        forces on the structure-of-arrays copy, see :attr:`use_soa_mirror`.
+        Values larger than one require the ``OPENMP`` feature.
+
+        """
+
+        def __set__(self, int _n_threads):
+            if _n_threads < 1:
+                raise ValueError("n_threads must be >= 1")
+            IF OPENMP != 1:
+                if _n_threads > 1:
+                    raise RuntimeError(
+                        "n_threads > 1 requires the feature OPENMP")
+            mpi_set_n_threads(_n_threads)
+
+        def __get__(self):
+            return cell_structure.n_threads
+
+    property overlap_ghost_communication:
+        """
+        Overlap the update of the ghost particles in the integration
+        loop with the non-bonded pair forces between particles of the
+        same MPI rank. Only effective if the structure-of-arrays copy
+        is used (see :attr:`use_soa_mirror`) and no long-range
+        interactions are active.
+
+        """
+
+        def __set__(self, bool _overlap):
+            mpi_set_overlap_ghost_communication(_overlap)
+
+        def __get__(self):
+            return cell_structure.overlap_ghost_communication
+
+    property use_sparse_particle_index:
+        """
+        Store the map from particle ids to the particles of each MPI rank
+        in a hash table instead of an array indexed by the id. The memory
+        of the array grows with the largest particle id in the system, that
+        of the hash table with the number of particles on the rank.
+
+        """
+
+        def __set__(self, bool _sparse):
+            mpi_set_use_sparse_particle_index(_sparse)
+
+        def __get__(self):
+            return cell_structure.use_sparse_particle_index()
+
     property skin:
         """
         Value of the skin layer expects a floating point number.
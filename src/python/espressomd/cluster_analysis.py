@@ -88,7 +88,7 @@ class ClusterStructure(ScriptInterfaceHelper):
 
     """
     _so_name = "ClusterAnalysis::ClusterStructure"
-    _so_creation_policy = "LOCAL"
+    _so_creation_policy = "GLOBAL"
 
     def __init__(self, *args, **kwargs):
         super().__init__(*args, **kwargs)
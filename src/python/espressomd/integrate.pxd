@@ -28,7 +28,7 @@ cdef extern from "config.hpp":
 cdef extern from "integrate.hpp" nogil:
     cdef int python_integrate(int n_steps, cbool recalc_forces, int reuse_forces)
     cdef void integrate_set_sd()
-    cdef void integrate_set_nvt()
+    cdef int integrate_set_nvt(int long_range_interval)
     cdef int integrate_set_steepest_descent(const double f_max, const double gamma,
                                             const int max_steps, const double max_displacement)
     cdef extern cbool skin_set
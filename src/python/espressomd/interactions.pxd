@@ -37,6 +37,19 @@ cdef extern from "TabulatedPotential.hpp":
         vector[double] energy_tab
         vector[double] force_tab
 
+cdef extern from "nonbonded_interactions/spline_tabulation.hpp":
+    cdef struct SplineTabulationInfo "SplineTabulation::Info":
+        int type_a
+        int type_b
+        int n_intervals
+        double deviation
+        cbool tabulated
+
+    void spline_tabulation_set_parameters "SplineTabulation::set_parameters" (double tolerance, double min_distance)
+    double spline_tabulation_tolerance "SplineTabulation::tolerance" ()
+    double spline_tabulation_min_distance "SplineTabulation::min_distance" ()
+    vector[SplineTabulationInfo] spline_tabulation_info "SplineTabulation::info" ()
+
 cdef extern from "dpd.hpp":
     cdef struct DPDParameters:
         double gamma
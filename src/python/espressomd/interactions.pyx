@@ -1652,6 +1652,66 @@ cdef class NonBondedInteractions:
 
         reset_ia_params()
 
+    def set_spline_tabulation(self, tolerance=1e-6, min_distance=0.5):
+        """
+        Evaluate the forces of the central non-bonded potentials and of
+        the real-space electrostatics from cubic spline tables.
+
+        The tables are built per pair of particle types on the next force
+        calculation, and whenever the interactions or the box change.
+        Type pairs whose table does not reach the tolerance, or which have
+        non-central potentials (Thole, Gay-Berne), are evaluated
+        analytically. Energies and pressures are always evaluated
+        analytically.
+
+        Parameters
+        ----------
+        tolerance : :obj:`float`
+            Largest deviation of a table from the analytic force,
+            relative to the largest force in the vicinity.
+        min_distance : :obj:`float`
+            Start of the tables, particles closer than this are
+            evaluated analytically.
+
+        """
+        if tolerance <= 0.:
+            raise ValueError("tolerance has to be positive")
+        if min_distance <= 0.:
+            raise ValueError("min_distance has to be positive")
+        spline_tabulation_set_parameters(tolerance, min_distance)
+
+    def disable_spline_tabulation(self):
+        """
+        Evaluate all non-bonded forces analytically.
+
+        """
+        spline_tabulation_set_parameters(0., 0.)
+
+    def get_spline_tabulation(self):
+        """
+        Parameters of the spline tables, see :meth:`set_spline_tabulation`.
+
+        Returns
+        -------
+        :obj:`dict`
+            ``tolerance`` and ``min_distance``, the tolerance is 0 if the
+            tables are disabled. ``tables`` is a list with one :obj:`dict`
+            per table, with the particle types ``type_a`` and ``type_b``
+            (-1 for the electrostatics), the number of intervals
+            ``n_intervals``, the relative ``deviation`` from the analytic
+            force and whether the table is used (``tabulated``). The list
+            is empty if the tables are disabled or not applicable.
+
+        """
+        cdef vector[SplineTabulationInfo] tables = spline_tabulation_info()
+        return {"tolerance": spline_tabulation_tolerance(),
+                "min_distance": spline_tabulation_min_distance(),
+                "tables": [{"type_a": t.type_a,
+                            "type_b": t.type_b,
+                            "n_intervals": t.n_intervals,
+                            "deviation": t.deviation,
+                            "tabulated": t.tabulated} for t in tables]}
+
 cdef class BondedInteraction:
     """
     Base class for bonded interactions.
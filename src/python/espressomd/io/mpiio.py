@@ -14,6 +14,8 @@
 #
 # You should have received a copy of the GNU General Public License
 # along with this program.  If not, see <http://www.gnu.org/licenses/>.
+import atexit
+
 from ..script_interface import PScriptInterface
 
 
@@ -30,9 +32,10 @@ class Mpiio:
     def __init__(self):
         self._instance = PScriptInterface(
             "ScriptInterface::MPIIO::MPIIOScript")
+        self._wait_at_exit = False
 
     def write(self, prefix=None, positions=False, velocities=False,
-              types=False, bonds=False):
+              types=False, bonds=False, asynchronous=False):
         """MPI-IO write.
 
         Outputs binary data using MPI-IO to several files starting with prefix.
@@ -62,6 +65,11 @@ class Mpiio:
             Indicates if types should be dumped.
         bonds : :obj:`bool`, optional
             Indicates if bonds should be dumped.
+        asynchronous : :obj:`bool`, optional
+            Return as soon as the particle data is copied into a staging
+            buffer, while the files are written in the background. Call
+            :meth:`wait` before using the files. A write still pending
+            when the interpreter exits is completed at exit.
 
         Raises
         ------
@@ -75,8 +83,63 @@ class Mpiio:
         if not positions and not velocities and not types and not bonds:
             raise ValueError("No output fields chosen.")
 
+        if asynchronous and not self._wait_at_exit:
+            # the write has to be completed on all nodes
+            # while they still run the MPI callback loop
+            atexit.register(self.wait)
+            self._wait_at_exit = True
+
         self._instance.call_method(
-            "write", prefix=prefix, pos=positions, vel=velocities, typ=types, bond=bonds)
+            "write", prefix=prefix, pos=positions, vel=velocities, typ=types,
+            bond=bonds, asynchronous=asynchronous)
+
+    def write_checkpoint(self, filename=None):
+        """MPI-IO checkpoint.
+
+        Writes the full state of all particles (properties, positions,
+        orientations, velocities, angular velocities, image boxes, bonds
+        and exclusions) and the RNG states of the thermostats to a single
+        binary file. An existing file is overwritten.
+
+        .. note::
+            Do not read the file on a machine with a different architecture
+            or with ESPResSo compiled with a different set of features!
+
+        Parameters
+        ----------
+        filename : :obj:`str`
+            Name of the checkpoint file.
+
+        """
+        if filename is None:
+            raise ValueError(
+                "Need to supply a file name via the 'filename' argument.")
+        self._instance.call_method("write_checkpoint", filename=filename)
+
+    def read_checkpoint(self, filename=None):
+        """Read an MPI-IO checkpoint.
+
+        Replaces all particles by the ones stored with
+        :meth:`write_checkpoint` and restores the RNG states of the
+        thermostats. The file can be read on a different number of
+        processes than the one it was written on.
+
+        Parameters
+        ----------
+        filename : :obj:`str`
+            Name of the checkpoint file.
+
+        """
+        if filename is None:
+            raise ValueError(
+                "Need to supply a file name via the 'filename' argument.")
+        self._instance.call_method("read_checkpoint", filename=filename)
+
+    def wait(self):
+        """Wait for the completion of an asynchronous :meth:`write`.
+
+        """
+        self._instance.call_method("wait")
 
     def read(self, prefix=None, positions=False, velocities=False,
              types=False, bonds=False):
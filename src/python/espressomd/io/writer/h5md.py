@@ -73,17 +73,22 @@ else:
             Path to the trajectory file.
         unit_system : :obj:`UnitSystem`, optional	
             Physical units for the data.
+        chunk_size : :obj:`int`, optional
+            Number of particles per HDF5 chunk of the particle datasets
+            of a new file.
 
         """
 
-        def __init__(self, file_path, unit_system=UnitSystem()):
+        def __init__(self, file_path, unit_system=UnitSystem(),
+                     chunk_size=1000):
             self.h5md_instance = PScriptInterface(
                 "ScriptInterface::Writer::H5md", file_path=file_path, script_path=sys.argv[0],
                 mass_unit=unit_system.mass, length_unit=unit_system.length, 
                 time_unit=unit_system.time,	
                 force_unit=unit_system.force,	
                 velocity_unit=unit_system.velocity,	
-                charge_unit=unit_system.charge
+                charge_unit=unit_system.charge,
+                chunk_size=chunk_size
             )
 
         def get_params(self):
@@ -88,6 +88,8 @@ cdef extern from "grid_based_algorithms/lb_interface.hpp":
     void lb_lbfluid_set_rng_state(stdint.uint64_t) except +
     void lb_lbfluid_set_kT(double) except +
     double lb_lbfluid_get_kT() except +
+    void lb_lbfluid_set_n_threads(int) except +
+    int lb_lbfluid_get_n_threads() except +
     double lb_lbfluid_get_lattice_speed() except +
     void check_tau_time_step_consistency(double tau, double time_s) except +
     const Vector3d lb_lbfluid_get_interpolated_velocity(Vector3d & p) except +
@@ -312,6 +312,50 @@ cdef class LBFluid(HydrodynamicInteraction):
 
     """
 
+    def validate_params(self):
+        HydrodynamicInteraction.validate_params(self)
+
+        utils.check_type_or_throw_except(
+            self._params["n_threads"], 1, int, "n_threads must be an integer")
+        if self._params["n_threads"] < 1:
+            raise ValueError("n_threads must be >= 1")
+        IF OPENMP != 1:
+            if self._params["n_threads"] > 1:
+                raise RuntimeError("n_threads > 1 requires the feature OPENMP")
+
+    def valid_keys(self):
+        return HydrodynamicInteraction.valid_keys(self) + ("n_threads",)
+
+    def default_params(self):
+        params = HydrodynamicInteraction.default_params(self)
+        params["n_threads"] = 1
+        return params
+
+    def _set_params_in_es_core(self):
+        HydrodynamicInteraction._set_params_in_es_core(self)
+        self.n_threads = self._params["n_threads"]
+
+    def _get_params_from_es_core(self):
+        params = HydrodynamicInteraction._get_params_from_es_core(self)
+        params["n_threads"] = self.n_threads
+        return params
+
+    property n_threads:
+        """
+        Number of threads used by each MPI rank for the fluid update and
+        the particle coupling. The z-slabs of the local lattice are
+        distributed over the threads. The result, including the thermal
+        fluctuations, does not depend on the number of threads.
+
+        """
+
+        def __get__(self):
+            return lb_lbfluid_get_n_threads()
+
+        def __set__(self, n_threads):
+            cdef int _n_threads = n_threads
+            lb_lbfluid_set_n_threads(_n_threads)
+
     def _set_lattice_switch(self):
         lb_lbfluid_set_lattice_switch(CPU)
 
@@ -57,7 +57,7 @@ class DistanceCriterion(_PairCriterion):
         distance cutoff for the criterion
     """
     _so_name = "PairCriteria::DistanceCriterion"
-    _so_creation_policy = "LOCAL"
+    _so_creation_policy = "GLOBAL"
 
 
 @script_interface_register
@@ -78,7 +78,7 @@ class EnergyCriterion(_PairCriterion):
         energy cutoff for the criterion
     """
     _so_name = "PairCriteria::EnergyCriterion"
-    _so_creation_policy = "LOCAL"
+    _so_creation_policy = "GLOBAL"
 
 
 @script_interface_register
@@ -95,4 +95,4 @@ class BondCriterion(_PairCriterion):
         numeric type of the bond
     """
     _so_name = "PairCriteria::BondCriterion"
-    _so_creation_policy = "LOCAL"
+    _so_creation_policy = "GLOBAL"
@@ -42,6 +42,7 @@ if LB_BOUNDARIES or LB_BOUNDARIES_GPU:
     from .lbboundaries import LBBoundaries
     from .ekboundaries import EKBoundaries
 from .comfixed import ComFixed
+from .timings import Timings
 from .globals import Globals
 from .globals cimport FIELD_SIMTIME, FIELD_MAX_OIF_OBJECTS
 from .globals cimport integ_switch, max_oif_objects, sim_time
@@ -108,6 +109,8 @@ cdef class System:
         """:class:`espressomd.cuda_init.CudaInitHandle`"""
         comfixed
         """:class:`espressomd.comfixed.ComFixed`"""
+        timings
+        """:class:`espressomd.timings.Timings`"""
         _active_virtual_sites_handle
 
     def __init__(self, **kwargs):
@@ -143,6 +146,7 @@ cdef class System:
             self.non_bonded_inter = interactions.NonBondedInteractions()
             self.part = particle_data.ParticleList()
             self.thermostat = Thermostat()
+            self.timings = Timings()
             IF VIRTUAL_SITES:
                 self._active_virtual_sites_handle = ActiveVirtualSitesHandle(
                     implementation=VirtualSitesOff())
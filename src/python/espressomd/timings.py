@@ -0,0 +1,59 @@
+# Copyright (C) 2021 The ESPResSo project
+#
+# This file is part of ESPResSo.
+#
+# ESPResSo is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# ESPResSo is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+from .script_interface import ScriptInterfaceHelper, script_interface_register
+
+
+@script_interface_register
+class Timings(ScriptInterfaceHelper):
+
+    """Wall-clock timings of the hot paths of the integration.
+
+    Every MPI rank accumulates the time spent in the force calculation,
+    the short-range loop, the ghost communication, the particle resort,
+    the P3M charge assignment, FFT and back-interpolation and the LB
+    collide-stream step and particle coupling.
+
+    """
+
+    _so_name = "Timings"
+    _so_creation_policy = "LOCAL"
+
+    def get(self):
+        """
+        Collect the timings from all ranks.
+
+        Returns
+        -------
+        :obj:`dict`
+            For each section, a dict with the largest number of calls on
+            any rank (``calls``) and the smallest, largest and average
+            accumulated time over the ranks in seconds (``min``, ``max``,
+            ``avg``).
+
+        """
+        timings = {}
+        for name, calls, t_min, t_max, t_avg in self.call_method("get"):
+            timings[name] = {"calls": calls, "min": t_min, "max": t_max,
+                             "avg": t_avg}
+        return timings
+
+    def reset(self):
+        """
+        Clear the timings on all ranks.
+
+        """
+        self.call_method("reset")
@@ -0,0 +1,52 @@
+/*
+ * Copyright (C) 2021 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SCRIPT_INTERFACE_TIMINGS_HPP
+#define SCRIPT_INTERFACE_TIMINGS_HPP
+
+#include "script_interface/ScriptInterface.hpp"
+
+#include "core/timings.hpp"
+
+#include <string>
+#include <vector>
+
+namespace ScriptInterface {
+
+class Timings : public ObjectHandle {
+public:
+  Variant do_call_method(std::string const &method,
+                         VariantMap const &) override {
+    if (method == "get") {
+      std::vector<Variant> ret;
+      for (auto const &s : ::Timings::statistics()) {
+        ret.emplace_back(std::vector<Variant>{
+            s.name, static_cast<int>(s.calls), s.min, s.max, s.avg});
+      }
+      return ret;
+    }
+    if (method == "reset") {
+      ::Timings::reset();
+    }
+
+    return none;
+  }
+};
+} // namespace ScriptInterface
+#endif
@@ -23,6 +23,7 @@
 #define SCRIPT_INTERFACE_CLUSTER_ANALYSIS_CLUSTER_HPP
 
 #include "core/cluster_analysis/Cluster.hpp"
+#include "core/communication.hpp"
 
 #include "script_interface/ScriptInterface.hpp"
 
@@ -34,6 +35,10 @@ public:
   Cluster() = default;
   Variant do_call_method(std::string const &method,
                          VariantMap const &parameters) override {
+    // The cluster data only exists on the head node
+    if (this_node != 0) {
+      return {};
+    }
     if (method == "particle_ids") {
       return m_cluster->particles;
     }
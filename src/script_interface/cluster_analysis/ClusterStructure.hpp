@@ -23,6 +23,7 @@
 #define SCRIPT_INTERFACE_CLUSTER_ANALYSIS_CLUSTER_STRUCTURE_HPP
 
 #include "core/cluster_analysis/ClusterStructure.hpp"
+#include "core/communication.hpp"
 
 #include "script_interface/ScriptInterface.hpp"
 #include "script_interface/pair_criteria/pair_criteria.hpp"
@@ -46,6 +47,22 @@ public:
   };
   Variant do_call_method(std::string const &method,
                          VariantMap const &parameters) override {
+    if (method == "clear") {
+      m_cluster_structure.clear();
+      return true;
+    }
+    if (method == "run_for_all_pairs") {
+      m_cluster_structure.run_for_all_pairs();
+      return true;
+    }
+    if (method == "run_for_bonded_particles") {
+      m_cluster_structure.run_for_bonded_particles();
+      return true;
+    }
+    // The results of the analysis only exist on the head node
+    if (this_node != 0) {
+      return {};
+    }
     if (method == "get_cluster") {
       // Note: Cluster objects are generated on the fly, to avoid having to
       // store a script interface object for all clusters (which can by
@@ -71,18 +88,6 @@ public:
       return m_cluster_structure.cluster_id.at(
           get_value<int>(parameters.at("pid")));
     }
-    if (method == "clear") {
-      m_cluster_structure.clear();
-      return true;
-    }
-    if (method == "run_for_all_pairs") {
-      m_cluster_structure.run_for_all_pairs();
-      return true;
-    }
-    if (method == "run_for_bonded_particles") {
-      m_cluster_structure.run_for_bonded_particles();
-      return true;
-    }
     return true;
   }
 
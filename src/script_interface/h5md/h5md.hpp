@@ -42,7 +42,8 @@ public:
          {"time_unit", m_h5md, &::Writer::H5md::File::time_unit},
          {"force_unit", m_h5md, &::Writer::H5md::File::force_unit},
          {"velocity_unit", m_h5md, &::Writer::H5md::File::velocity_unit},
-         {"charge_unit", m_h5md, &::Writer::H5md::File::charge_unit}});
+         {"charge_unit", m_h5md, &::Writer::H5md::File::charge_unit},
+         {"chunk_size", m_h5md, &::Writer::H5md::File::chunk_size}});
   };
 
 private:
@@ -53,9 +54,10 @@ private:
     m_h5md =
         make_shared_from_args<::Writer::H5md::File, std::string, std::string,
                               std::string, std::string, std::string,
-                              std::string, std::string, std::string>(
+                              std::string, std::string, std::string, int>(
             params, "file_path", "script_path", "mass_unit", "length_unit",
-            "time_unit", "force_unit", "velocity_unit", "charge_unit");
+            "time_unit", "force_unit", "velocity_unit", "charge_unit",
+            "chunk_size");
   }
 
   std::shared_ptr<::Writer::H5md::File> m_h5md;
@@ -41,6 +41,24 @@ public:
   Variant do_call_method(const std::string &name,
                          const VariantMap &parameters) override {
 
+    if (name == "wait") {
+      Mpiio::mpi_mpiio_common_wait();
+      return {};
+    }
+
+    if (name == "write_checkpoint") {
+      auto const filename = get_value<std::string>(parameters.at("filename"));
+      Mpiio::mpi_mpiio_checkpoint_write(filename.c_str(),
+                                        cell_structure.local_particles());
+      return {};
+    }
+
+    if (name == "read_checkpoint") {
+      auto const filename = get_value<std::string>(parameters.at("filename"));
+      Mpiio::mpi_mpiio_checkpoint_read(filename.c_str());
+      return {};
+    }
+
     auto pref = get_value<std::string>(parameters.at("prefix"));
     auto pos = get_value<bool>(parameters.at("pos"));
     auto vel = get_value<bool>(parameters.at("vel"));
@@ -53,8 +71,9 @@ public:
                  field_value(bond, Mpiio::MPIIO_OUT_BND);
 
     if (name == "write")
-      Mpiio::mpi_mpiio_common_write(pref.c_str(), v,
-                                    cell_structure.local_particles());
+      Mpiio::mpi_mpiio_common_write(
+          pref.c_str(), v, cell_structure.local_particles(),
+          get_value<bool>(parameters.at("asynchronous")));
     else if (name == "read")
       Mpiio::mpi_mpiio_common_read(pref.c_str(), v);
 
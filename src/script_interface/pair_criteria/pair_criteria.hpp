@@ -23,6 +23,7 @@
 #define SCRIPT_INTERFACE_PAIR_CRITERIA_PAIR_CRITERIA_HPP
 
 #include "../auto_parameters/AutoParameters.hpp"
+#include "core/communication.hpp"
 #include "core/pair_criteria/pair_criteria.hpp"
 #include <string>
 
@@ -36,6 +37,10 @@ public:
   Variant do_call_method(std::string const &method,
                          VariantMap const &parameters) override {
     if (method == "decide") {
+      // Particle data can only be retrieved on the head node
+      if (this_node != 0) {
+        return {};
+      }
       return pair_criterion()->decide(get_value<int>(parameters.at("id1")),
                                       get_value<int>(parameters.at("id2")));
     }
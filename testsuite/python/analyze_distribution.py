@@ -80,6 +80,31 @@ class AnalyzeDistributions(ut.TestCase):
         np.testing.assert_allclose(core_rdf[1],
                                    np.cumsum(self.calc_min_distribution(bins)))
 
+    # test system.analysis.structure_factor()
+    def test_structure_factor(self):
+        order = 5
+        sf = self.system.analysis.structure_factor(sf_types=[0],
+                                                   sf_order=order)
+        # direct summation over all wave vectors of each shell
+        pos = self.system.part[:].pos
+        shells = {}
+        for i in range(order + 1):
+            for j in range(-order, order + 1):
+                for k in range(-order, order + 1):
+                    n = i**2 + j**2 + k**2
+                    if n < 1 or n > order**2:
+                        continue
+                    qr = 2. * np.pi / self.system.box_l[0] * \
+                        np.dot(pos, [i, j, k])
+                    s = (np.sum(np.cos(qr))**2 + np.sum(np.sin(qr))**2) / \
+                        self.num_part
+                    shells.setdefault(n, []).append(s)
+        n_ref = sorted(shells)
+        np.testing.assert_allclose(
+            sf[0], 2. * np.pi / self.system.box_l[0] * np.sqrt(n_ref))
+        np.testing.assert_allclose(
+            sf[1], [np.mean(shells[n]) for n in n_ref], rtol=1e-10)
+
 
 if __name__ == "__main__":
     ut.main()
@@ -17,6 +17,7 @@
 # along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #
 import unittest as ut
+import unittest_decorators as utx
 import espressomd
 import numpy as np
 
@@ -34,6 +35,58 @@ class CellSystem(ut.TestCase):
         self.assertEqual(
             [s['use_verlet_list'], s['type']], [1, "domain_decomposition"])
 
+    @utx.skipIfMissingFeatures(["WCA"])
+    def test_verlet_list_stats(self):
+        self.system.cell_system.set_domain_decomposition(use_verlet_lists=True)
+        self.system.part.add(pos=[[0., 0., 0.], [0.5, 0., 0.], [2.5, 0., 0.]])
+        self.system.non_bonded_inter[0, 0].wca.set_params(
+            epsilon=1., sigma=1.)
+        s = self.system.cell_system.get_state()
+        n_rebuilds = s['verlet_list_rebuilds']
+        self.system.integrator.run(0)
+        s = self.system.cell_system.get_state()
+        self.assertEqual(s['verlet_list_rebuilds'], n_rebuilds + 1)
+        # only the first two particles are within the cutoff
+        self.assertAlmostEqual(s['verlet_list_pairs_per_particle'], 1. / 3.)
+        self.assertGreater(s['verlet_list_memory'], 0)
+        self.system.non_bonded_inter[0, 0].wca.set_params(
+            epsilon=0., sigma=0.)
+        self.system.part.clear()
+
+    def test_sparse_particle_index(self):
+        system = self.system
+        system.cell_system.set_domain_decomposition()
+        ids = [3, 1000, 123456]
+        for pid in ids:
+            system.part.add(id=pid, pos=np.random.random(3) * system.box_l)
+        dense_memory = system.cell_system.get_state()['particle_index_memory']
+
+        system.cell_system.use_sparse_particle_index = True
+        self.assertTrue(system.cell_system.use_sparse_particle_index)
+        s = system.cell_system.get_state()
+        self.assertTrue(s['use_sparse_particle_index'])
+        self.assertLess(s['particle_index_memory'], dense_memory)
+
+        # lookups, insertion and removal, also across a resort
+        for pid in ids:
+            self.assertEqual(system.part[pid].id, pid)
+        system.part.add(id=77, pos=[1., 1., 1.])
+        system.part[1000].remove()
+        system.part[3].pos = [4.9, 4.9, 4.9]
+        system.integrator.run(0)
+        self.assertEqual(system.part[77].id, 77)
+        np.testing.assert_allclose(np.copy(system.part[3].pos), [4.9] * 3)
+        self.assertFalse(system.part.exists(1000))
+
+        system.cell_system.set_n_square()
+        self.assertTrue(system.cell_system.use_sparse_particle_index)
+        self.assertEqual(system.part[123456].id, 123456)
+
+        system.cell_system.use_sparse_particle_index = False
+        self.assertFalse(system.cell_system.use_sparse_particle_index)
+        self.assertEqual(system.part[123456].id, 123456)
+        system.part.clear()
+
     def test_node_grid(self):
         self.system.cell_system.set_domain_decomposition()
         n_nodes = self.system.cell_system.get_state()['n_nodes']
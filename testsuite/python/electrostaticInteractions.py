@@ -16,6 +16,7 @@
 # You should have received a copy of the GNU General Public License
 # along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #
+import math
 import unittest as ut
 import unittest_decorators as utx
 import numpy as np
@@ -102,6 +103,83 @@ class ElectrostaticInteractionsTests(ut.TestCase):
                                    [-p3m_force, 0, 0], atol=1E-5)
         self.system.actors.remove(p3m)
 
+    def calc_ewald_reference(self, alpha, k_max):
+        """Calculates the energy and the forces of all particles by a direct
+        Ewald summation with metallic boundary conditions"""
+
+        box_l = np.copy(self.system.box_l)
+        pos = np.copy(self.system.part[:].pos)
+        q = np.copy(self.system.part[:].q)
+        energy = -alpha / np.sqrt(np.pi) * np.sum(q**2)
+        forces = np.zeros_like(pos)
+
+        # real space, the minimum image suffices since erfc(alpha * L / 2)
+        # is negligible
+        for i in range(len(q)):
+            for j in range(i + 1, len(q)):
+                d = pos[i] - pos[j]
+                d -= box_l * np.round(d / box_l)
+                r = np.linalg.norm(d)
+                erfc = math.erfc(alpha * r)
+                energy += q[i] * q[j] * erfc / r
+                f = q[i] * q[j] * d / r**2 * (
+                    erfc / r + 2. * alpha / np.sqrt(np.pi) *
+                    np.exp(-(alpha * r)**2))
+                forces[i] += f
+                forces[j] -= f
+
+        # k-space, all wave vectors up to k_max
+        n_max = (k_max * box_l / (2. * np.pi)).astype(int)
+        n = np.array(np.meshgrid(
+            *[np.arange(-m, m + 1) for m in n_max],
+            indexing="ij")).reshape(3, -1).T
+        k = 2. * np.pi * n / box_l
+        k2 = np.sum(k**2, axis=1)
+        in_range = np.logical_and(k2 > 0., k2 <= k_max**2)
+        k, k2 = k[in_range], k2[in_range]
+        phases = np.exp(1j * k.dot(pos.T))
+        structure_factor = phases.dot(q)
+        f_k = 4. * np.pi / self.system.volume() * \
+            np.exp(-k2 / (4. * alpha**2)) / k2
+        energy += 0.5 * np.sum(f_k * np.abs(structure_factor)**2)
+        forces += q[:, np.newaxis] * np.imag(
+            np.conj(structure_factor)[:, np.newaxis] * phases).T.dot(
+                f_k[:, np.newaxis] * k)
+        return energy, forces
+
+    @utx.skipIfMissingFeatures(["P3M"])
+    def test_p3m_ewald_reference(self):
+        """Compares the P3M energy and forces of a neutral random
+        configuration in a non-cubic box to a direct Ewald summation. The
+        k-space part of P3M only stores half of the Fourier spectrum."""
+
+        prefactor = 1.1
+        alpha = 0.8
+        self.system.box_l = [12., 14., 13.]
+        self.system.cell_system.skin = 0.4
+        rng = np.random.RandomState(42)
+        for i in range(2, 20):
+            self.system.part.add(id=i, pos=rng.random_sample(3) *
+                                 self.system.box_l, q=(-1)**i)
+        energy, forces = self.calc_ewald_reference(alpha=alpha, k_max=8.5)
+
+        p3m = espressomd.electrostatics.P3M(prefactor=prefactor,
+                                            accuracy=1e-6,
+                                            mesh=[36, 40, 38],
+                                            cao=7,
+                                            r_cut=4.5,
+                                            alpha=alpha,
+                                            tune=False)
+        self.system.actors.add(p3m)
+        self.assertAlmostEqual(self.system.analysis.energy()['coulomb'],
+                               prefactor * energy, delta=1e-4)
+        self.system.integrator.run(0)
+        np.testing.assert_allclose(np.copy(self.system.part[:].f),
+                                   prefactor * forces, atol=1e-4)
+        self.system.actors.remove(p3m)
+        for i in range(2, 20):
+            self.system.part[i].remove()
+
     @utx.skipIfMissingFeatures(["P3M"])
     def test_p3m_non_metallic(self):
         prefactor = 1.1
@@ -37,6 +37,8 @@ except ImportError:
 
 
 N_PART = 26
+# the test runs with different numbers of ranks, which must not share a file
+FILE_PATH = os.path.splitext(os.path.basename(__file__))[0] + ".h5"
 
 
 @utx.skipIfMissingFeatures(['H5MD'])
@@ -77,17 +79,17 @@ class H5mdTests(ut.TestCase):
 
     @classmethod
     def setUpClass(cls):
-        if os.path.isfile('test.h5'):
-            os.remove('test.h5')
+        if os.path.isfile(FILE_PATH):
+            os.remove(FILE_PATH)
         h5_units = espressomd.io.writer.h5md.UnitSystem(
             time='ps', mass='u', length='m', charge='e')
         h5 = espressomd.io.writer.h5md.H5md(
-            file_path="test.h5", unit_system=h5_units)
+            file_path=FILE_PATH, unit_system=h5_units, chunk_size=8)
         h5.write()
         h5.write()
         h5.flush()
         h5.close()
-        cls.py_file = h5py.File("test.h5", 'r')
+        cls.py_file = h5py.File(FILE_PATH, 'r')
         cls.py_pos = cls.py_file['particles/atoms/position/value'][1]
         cls.py_img = cls.py_file['particles/atoms/image/value'][1]
         cls.py_mass = cls.py_file['particles/atoms/mass/value'][1]
@@ -97,17 +99,32 @@ class H5mdTests(ut.TestCase):
         cls.py_id = cls.py_file['particles/atoms/id/value'][1]
         cls.py_id_time = cls.py_file['particles/atoms/id/time'][1]
         cls.py_id_step = cls.py_file['particles/atoms/id/step'][1]
-        cls.py_bonds = cls.py_file['connectivity/atoms/value'][1]
+        cls.py_bonds = cls.py_file['connectivity/atoms/value'][0]
         cls.py_box = cls.py_file['particles/atoms/box/edges/value'][1]
 
     @classmethod
     def tearDownClass(cls):
-        os.remove("test.h5")
+        os.remove(FILE_PATH)
 
     def test_opening(self):
-        h5 = espressomd.io.writer.h5md.H5md(file_path="test.h5")
+        h5 = espressomd.io.writer.h5md.H5md(file_path=FILE_PATH)
         h5.close()
 
+    def test_chunks(self):
+        """Test if the particle datasets have the requested chunk shape."""
+        self.assertEqual(
+            self.py_file['particles/atoms/position/value'].chunks, (1, 8, 3))
+        self.assertEqual(
+            self.py_file['particles/atoms/id/value'].chunks, (1, 8))
+
+    def test_ids(self):
+        """Test if every rank wrote its particles to a separate part of the
+        collectively written datasets. The particles lie on the diagonal of
+        the box, so on four ranks two of them take part without particles.
+        """
+        np.testing.assert_array_equal(np.sort(self.py_id), np.arange(N_PART))
+        self.assertEqual(len(self.py_pos), N_PART)
+
     def test_box(self):
         np.testing.assert_allclose(self.py_box, self.box_l)
 
@@ -178,6 +195,37 @@ class H5mdTests(ut.TestCase):
             self.assertEqual(bond[0], i + 0)
             self.assertEqual(bond[1], i + 1)
 
+    def test_connectivity_change(self):
+        """Test if the connectivity is written again when the bonds change,
+        with the time of that frame."""
+        file_path = "topology_" + FILE_PATH
+        if os.path.isfile(file_path):
+            os.remove(file_path)
+        h5 = espressomd.io.writer.h5md.H5md(file_path=file_path)
+        h5.write()
+        self.system.time = 13.3
+        self.system.part[0].add_bond((self.vb, N_PART - 1))
+        h5.write()
+        h5.write()
+        h5.flush()
+        h5.close()
+        self.system.part[0].delete_bond((self.vb, N_PART - 1))
+        self.system.time = 12.3
+
+        with h5py.File(file_path, 'r') as py_file:
+            np.testing.assert_allclose(
+                py_file['connectivity/atoms/time'], [12.3, 13.3])
+            self.assertEqual(len(py_file['connectivity/atoms/step']), 2)
+            bonds = py_file['connectivity/atoms/value']
+            self.assertEqual(bonds.shape, (2, N_PART, 2))
+            # the first record has one bond less, its last row is not set
+            old_bonds = {tuple(x) for x in bonds[0] if x[0] >= 0}
+            new_bonds = {tuple(x) for x in bonds[1]}
+            self.assertEqual(
+                old_bonds, {(i, i + 1) for i in range(N_PART - 1)})
+            self.assertEqual(new_bonds, old_bonds | {(0, N_PART - 1)})
+        os.remove(file_path)
+
     def test_script(self):
         with open(sys.argv[0], 'r') as f:
             ref = f.read()
@@ -211,9 +259,12 @@ class H5mdTests(ut.TestCase):
             self.assertEqual(time, time_ref)
             self.assertEqual(step, step_ref)
 
-        bond_time = self.py_file['connectivity/atoms/time'][1]
+        # the bonds did not change, hence only one connectivity record
+        self.assertEqual(len(self.py_file['connectivity/atoms/step']), 1)
+        self.assertEqual(len(self.py_file['connectivity/atoms/value']), 1)
+        bond_time = self.py_file['connectivity/atoms/time'][0]
         self.assertEqual(bond_time, time_ref)
-        bond_step = self.py_file['connectivity/atoms/step'][1]
+        bond_step = self.py_file['connectivity/atoms/step'][0]
         self.assertEqual(bond_step, step_ref)
         box_time = self.py_file['particles/atoms/box/edges/time'][1]
         self.assertEqual(box_time, time_ref)
@@ -0,0 +1,106 @@
+# Copyright (C) 2021 The ESPResSo project
+#
+# This file is part of ESPResSo.
+#
+# ESPResSo is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# ESPResSo is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+import unittest as ut
+import unittest_decorators as utx
+import numpy as np
+
+import espressomd
+import espressomd.magnetostatics
+
+
+@utx.skipIfMissingFeatures(["WCA", "DIPOLES", "DIPOLAR_DIRECT_SUM"])
+class IntegratorRESPA(ut.TestCase):
+    """
+    Multiple time stepping of the long-range forces, tested with the
+    dipolar direct sum, whose forces are computed as long-range forces.
+    The box is not periodic, so that the dipolar energy is continuous.
+
+    """
+
+    system = espressomd.System(box_l=[12., 12., 12.])
+    system.periodicity = [False, False, False]
+    system.time_step = 0.001
+    system.cell_system.skin = 0.3
+
+    def setUp(self):
+        np.random.seed(42)
+        grid = np.mgrid[0:6, 0:6, 0:6].reshape(3, -1).T
+        self.system.part.add(
+            pos=3. + 1.2 * grid + np.random.normal(0., 0.05, grid.shape),
+            v=np.random.normal(0., 0.5, grid.shape),
+            dip=np.random.normal(0., 1., grid.shape))
+        self.system.non_bonded_inter[0, 0].wca.set_params(
+            epsilon=1., sigma=1.)
+
+    def tearDown(self):
+        self.system.actors.clear()
+        self.system.part.clear()
+        self.system.non_bonded_inter[0, 0].wca.set_params(
+            epsilon=0., sigma=0.)
+        self.system.integrator.set_vv()
+
+    def forces(self):
+        self.system.integrator.run(0, recalc_forces=True)
+        return np.copy(self.system.part[:].f)
+
+    def total_energy(self):
+        return self.system.analysis.energy()["total"]
+
+    def test_parameters(self):
+        integrator = self.system.integrator
+        integrator.set_vv(long_range_interval=4)
+        self.assertEqual(
+            integrator.get_state().get_params()["long_range_interval"], 4)
+        integrator.set_vv()
+        self.assertEqual(
+            integrator.get_state().get_params()["long_range_interval"], 1)
+        with self.assertRaises(ValueError):
+            integrator.set_vv(long_range_interval=0)
+
+    def test_long_range_weight(self):
+        f_short = self.forces()
+        self.system.actors.add(
+            espressomd.magnetostatics.DipolarDirectSumCpu(prefactor=1.))
+        f_long = self.forces() - f_short
+        self.assertGreater(np.max(np.abs(f_long)), 0.1)
+
+        # the long-range forces are applied with the number of inner steps
+        self.system.integrator.set_vv(long_range_interval=3)
+        np.testing.assert_allclose(self.forces(), f_short + 3. * f_long,
+                                   atol=1e-10)
+
+        # and omitted on the steps in between
+        self.system.integrator.run(1)
+        f_1 = np.copy(self.system.part[:].f)
+        self.system.actors.clear()
+        self.system.integrator.set_vv(long_range_interval=1)
+        np.testing.assert_allclose(self.forces(), f_1, atol=1e-10)
+
+    def test_energy_conservation(self):
+        self.system.actors.add(
+            espressomd.magnetostatics.DipolarDirectSumCpu(prefactor=1.))
+        self.system.integrator.set_vv(long_range_interval=4)
+        self.system.integrator.run(0)
+        energy = self.total_energy()
+        for _ in range(10):
+            self.system.integrator.run(40)
+            self.assertAlmostEqual(
+                self.total_energy() / energy, 1., delta=5e-4)
+
+
+if __name__ == "__main__":
+    ut.main()
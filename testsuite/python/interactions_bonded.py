@@ -137,6 +137,48 @@ class InteractionsBondedTest(ut.TestCase):
                           k0=quartic_k0, k1=quartic_k1, r=quartic_r, r_cut=quartic_r_cut, scalar_r=r),
                       0.01, quartic_r_cut, True)
 
+    def test_bond_change_between_resorts(self):
+        """Tests that bonds which are added or removed between two force
+           calculations are used on the next one, for bonded particles on
+           different ranks"""
+
+        hb_1 = espressomd.interactions.HarmonicBond(k=5., r_0=0.5)
+        hb_2 = espressomd.interactions.HarmonicBond(k=2., r_0=0.1)
+        self.system.bonded_inter.add(hb_1)
+        self.system.bonded_inter.add(hb_2)
+        # the particles lie on both sides of the central planes of the box,
+        # so they belong to different ranks for every node grid
+        p0 = self.system.part[0]
+        p1 = self.system.part[1]
+        p0.pos = 0.5 * self.system.box_l - 0.3
+        p1.pos = 0.5 * self.system.box_l + 0.3
+        dist = 0.6 * np.sqrt(3.)
+        axis = np.ones(3) / np.sqrt(3.)
+        self.system.integrator.run(steps=0)
+        np.testing.assert_allclose(np.copy(p1.f), 0.)
+
+        def check(k, r_0):
+            self.system.integrator.run(steps=0)
+            f1_ref = axis * tests_common.harmonic_force(
+                scalar_r=dist, k=k, r_0=r_0)
+            np.testing.assert_allclose(np.copy(p1.f), f1_ref, atol=1e-10)
+            np.testing.assert_allclose(np.copy(p0.f), -f1_ref, atol=1e-10)
+            self.assertAlmostEqual(
+                self.system.analysis.energy()["bonded"],
+                tests_common.harmonic_potential(scalar_r=dist, k=k, r_0=r_0),
+                delta=1e-10)
+
+        # add a bond
+        p0.add_bond((hb_1, 1))
+        check(k=5., r_0=0.5)
+        # replace it by a bond stored on the other particle
+        p0.delete_bond((hb_1, 1))
+        p1.add_bond((hb_2, 0))
+        check(k=2., r_0=0.1)
+        # remove all bonds
+        p1.delete_bond((hb_2, 0))
+        check(k=0., r_0=0.)
+
     def run_test(self, bond_instance, force_func, energy_func, min_dist,
                  cutoff, test_breakage=False):
         self.system.bonded_inter.add(bond_instance)
@@ -442,6 +442,43 @@ class TestLBCPU(TestLB, ut.TestCase):
         self.lb_class = espressomd.lb.LBFluid
         self.params.update({"mom_prec": 1E-9, "mass_prec_per_node": 5E-8})
 
+    @utx.skipIfMissingFeatures("OPENMP")
+    def test_n_threads(self):
+        """The thermalized fluid and the coupling forces do not depend
+        on the number of threads.
+
+        """
+        def run(n_threads):
+            self.system.part.clear()
+            self.system.part.add(
+                pos=np.random.RandomState(42).random_sample((20, 3)) *
+                self.params['box_l'], v=[0.1, 0.2, 0.3])
+            lbf = self.lb_class(
+                kT=self.params['temp'],
+                visc=self.params['viscosity'],
+                dens=self.params['dens'],
+                agrid=self.params['agrid'],
+                tau=self.system.time_step,
+                seed=4, n_threads=n_threads)
+            self.system.actors.add(lbf)
+            self.assertEqual(lbf.n_threads, n_threads)
+            self.system.thermostat.set_lb(
+                LB_fluid=lbf, seed=3, gamma=self.params['friction'])
+            self.system.integrator.run(10)
+            populations = np.array([node.population for node in lbf.nodes()])
+            forces = np.copy(self.system.part[:].f)
+            self.tearDown()
+            return populations, forces
+
+        pop1, f1 = run(1)
+        pop3, f3 = run(3)
+        np.testing.assert_array_equal(pop1, pop3)
+        np.testing.assert_array_equal(f1, f3)
+
+        with self.assertRaises(ValueError):
+            self.system.actors.add(self.lb_class(
+                visc=1.0, dens=1.0, agrid=1.0, tau=0.1, n_threads=0))
+
 
 @utx.skipIfMissingGPU()
 class TestLBGPU(TestLB, ut.TestCase):
@@ -40,6 +40,8 @@ class LennardJonesTest(ut.TestCase):
             epsilon=lj_eps, sigma=lj_sig, cutoff=lj_cut, shift="auto")
 
         self.system.cell_system.skin = 0.4
+        self.system.cell_system.use_soa_mirror = False
+        self.system.cell_system.n_threads = 1
         self.system.time_step = .1
 
         for i in range(self.data.shape[0]):
@@ -80,6 +82,54 @@ class LennardJonesTest(ut.TestCase):
         self.system.integrator.run(recalc_forces=True, steps=0)
         self.check()
 
+    def test_dd_soa(self):
+        self.system.cell_system.set_domain_decomposition(
+            use_verlet_lists=False)
+        self.system.cell_system.use_soa_mirror = True
+        self.system.integrator.run(recalc_forces=True, steps=0)
+
+        self.check()
+
+    @utx.skipIfMissingFeatures(["OPENMP"])
+    def test_dd_soa_threads(self):
+        self.system.cell_system.set_domain_decomposition(
+            use_verlet_lists=False)
+        self.system.cell_system.use_soa_mirror = True
+        self.system.cell_system.n_threads = 2
+        self.system.integrator.run(recalc_forces=True, steps=0)
+
+        self.check()
+
+    def test_nsquare_soa(self):
+        self.system.cell_system.set_n_square(use_verlet_lists=False)
+        self.system.cell_system.use_soa_mirror = True
+        self.system.integrator.run(recalc_forces=True, steps=0)
+
+        self.check()
+
+    @utx.skipIfMissingFeatures(["GAUSSIAN"])
+    def test_nsquare_soa_new_potential(self):
+        # a potential the batched kernel can not evaluate is added to an
+        # existing type pair, the force calculation has to fall back to
+        # the pairwise kernels right away
+        self.system.cell_system.set_n_square(use_verlet_lists=False)
+        self.system.cell_system.use_soa_mirror = True
+        self.system.integrator.run(recalc_forces=True, steps=0)
+        self.check()
+
+        gaussian = self.system.non_bonded_inter[0, 0].gaussian
+        gaussian.set_params(eps=1., sig=1., cutoff=2.)
+        self.system.integrator.run(recalc_forces=True, steps=0)
+        f_soa = numpy.copy(self.system.part[:].f)
+        self.system.cell_system.use_soa_mirror = False
+        self.system.integrator.run(recalc_forces=True, steps=0)
+        f_aos = numpy.copy(self.system.part[:].f)
+        gaussian.deactivate()
+
+        self.assertGreater(numpy.max(numpy.abs(f_aos - self.data[:, 4:7])),
+                           1e-2)
+        numpy.testing.assert_allclose(f_soa, f_aos, rtol=0., atol=1e-10)
+
 
 if __name__ == '__main__':
     ut.main()
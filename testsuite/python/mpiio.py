@@ -100,6 +100,7 @@ class MPIIOTest(ut.TestCase):
 
     def tearDown(self):
         clean_files()
+        self.s.part.clear()
 
     def check_files_exist(self):
         """Checks if all necessary files have been written."""
@@ -134,6 +135,58 @@ class MPIIOTest(ut.TestCase):
 
         self.check_sample_system()
 
+    def test_mpiio_asynchronous(self):
+        espressomd.io.mpiio.mpiio.write(
+            filename, types=True, positions=True, velocities=True, bonds=True,
+            asynchronous=True)
+        # the staging buffer is independent of the particle data
+        self.s.part.clear()
+        espressomd.io.mpiio.mpiio.wait()
+
+        self.check_files_exist()
+
+        espressomd.io.mpiio.mpiio.read(
+            filename, types=True, positions=True, velocities=True, bonds=True)
+
+        self.check_sample_system()
+
+    def test_mpiio_checkpoint(self):
+        checkpoint = filename + ".ckpt"
+        espressomd.io.mpiio.mpiio.write_checkpoint(checkpoint)
+        self.assertTrue(os.path.isfile(checkpoint))
+
+        self.s.part.clear()
+        espressomd.io.mpiio.mpiio.read_checkpoint(checkpoint)
+        os.remove(checkpoint)
+
+        self.check_sample_system()
+
+    def test_mpiio_checkpoint_thermostat(self):
+        checkpoint = filename + ".ckpt"
+        self.s.time_step = 0.001
+        self.s.cell_system.skin = 0.1
+        self.s.thermostat.set_langevin(kT=1., gamma=1., seed=42)
+        self.s.integrator.run(2)
+        espressomd.io.mpiio.mpiio.write_checkpoint(checkpoint)
+
+        # uninterrupted run
+        self.s.integrator.run(1, recalc_forces=True)
+        pos_ref = numpy.copy(self.s.part[:].pos)
+        v_ref = numpy.copy(self.s.part[:].v)
+
+        # the restore overrides the RNG state of the thermostat
+        self.s.part.clear()
+        self.s.thermostat.set_langevin(kT=1., gamma=1., seed=7)
+        espressomd.io.mpiio.mpiio.read_checkpoint(checkpoint)
+        os.remove(checkpoint)
+        self.s.integrator.run(1)
+        self.s.thermostat.turn_off()
+
+        numpy.testing.assert_allclose(
+            numpy.copy(self.s.part[:].pos), pos_ref, rtol=0., atol=1e-10)
+        numpy.testing.assert_allclose(
+            numpy.copy(self.s.part[:].v), v_ref, rtol=0., atol=1e-10)
+
 
 if __name__ == '__main__':
     ut.main()
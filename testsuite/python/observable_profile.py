@@ -88,6 +88,50 @@ class ProfileObservablesTest(ut.TestCase):
             obs_data.shape, [self.kwargs['n_x_bins'], self.kwargs['n_y_bins'],
                              self.kwargs['n_z_bins'], 3])
 
+    def test_profiles_on_all_ranks(self):
+        """Compare the profiles of particles spread over all ranks, which
+        are reduced from the partial profiles of the ranks, with histograms
+        of the fetched particle data."""
+        n_part = 100
+        rng = np.random.RandomState(42)
+        ids = list(range(2, 2 + n_part))
+        self.system.part.add(
+            id=ids, pos=rng.random_sample((n_part, 3)) * self.system.box_l,
+            v=rng.random_sample((n_part, 3)) - 0.5)
+        if espressomd.has_features("EXTERNAL_FORCES"):
+            self.system.part[ids].ext_force = \
+                rng.random_sample((n_part, 3)) - 0.5
+        self.system.integrator.run(0)
+
+        n_bins = (3, 4, 5)
+        params = dict(self.kwargs, ids=ids, n_x_bins=n_bins[0],
+                      n_y_bins=n_bins[1], n_z_bins=n_bins[2])
+        bin_volume = np.prod(self.system.box_l / n_bins)
+        pos = np.copy(self.system.part[ids].pos)
+
+        def histogram(weights=None):
+            return np.histogramdd(pos, bins=n_bins, weights=weights,
+                                  range=list(zip(3 * [0.], self.system.box_l))
+                                  )[0] / bin_volume
+
+        def vector_histogram(prop):
+            values = np.copy(getattr(self.system.part[ids], prop))
+            return np.stack([histogram(values[:, i]) for i in range(3)],
+                            axis=-1)
+
+        np.testing.assert_array_almost_equal(
+            espressomd.observables.DensityProfile(**params).calculate(),
+            histogram())
+        np.testing.assert_array_almost_equal(
+            espressomd.observables.FluxDensityProfile(**params).calculate(),
+            vector_histogram("v"))
+        np.testing.assert_array_almost_equal(
+            espressomd.observables.ForceDensityProfile(**params).calculate(),
+            vector_histogram("f"))
+
+        for pid in ids:
+            self.system.part[pid].remove()
+
     def test_pid_profile_interface(self):
         # test setters and getters
         params = {'ids': [0, 1],
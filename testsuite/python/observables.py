@@ -228,6 +228,12 @@ class Observables(ut.TestCase):
             np.sum(particles.f, axis=0),
             espressomd.observables.TotalForce(ids=id_list).calculate())
 
+    def test_reduction_missing_particle(self):
+        # particle ids are odd, so the particle with id 4 does not exist
+        obs = espressomd.observables.ComPosition(ids=[3, 4, 5])
+        with self.assertRaises(RuntimeError):
+            obs.calculate()
+
 
 if __name__ == "__main__":
     ut.main()
@@ -0,0 +1,95 @@
+#
+# Copyright (C) 2020 The ESPResSo project
+#
+# This file is part of ESPResSo.
+#
+# ESPResSo is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# ESPResSo is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#
+
+"""Testmodule for the overlap of the ghost update with the pair forces.
+"""
+import unittest as ut
+import unittest_decorators as utx
+import numpy as np
+import espressomd
+import espressomd.interactions
+
+
+@utx.skipIfMissingFeatures(["LENNARD_JONES"])
+class OverlapGhostCommunicationTest(ut.TestCase):
+
+    """Integrate a Lennard-Jones fluid with harmonic bonds between
+       neighboring particles, with and without overlapping the ghost update
+       with the pair forces between particles of the same rank. The
+       trajectories, forces and energies have to agree up to rounding, since
+       only the order of the force summation differs."""
+
+    system = espressomd.System(box_l=3 * [10.0])
+    system.time_step = 0.005
+    system.cell_system.skin = 0.4
+    np.random.seed(42)
+
+    def setUp(self):
+        grid = 1.25 * np.array(np.meshgrid(*(3 * [np.arange(8)]),
+                                           indexing="ij")).reshape(3, -1).T
+        self.pos = grid + np.random.uniform(-0.1, 0.1, grid.shape)
+        self.vel = np.random.normal(size=grid.shape)
+        self.system.part.add(pos=self.pos, v=self.vel,
+                             type=np.arange(len(grid)) % 2)
+        for i in range(2):
+            for j in range(i, 2):
+                self.system.non_bonded_inter[i, j].lennard_jones.set_params(
+                    epsilon=1.0, sigma=1.0, cutoff=2.5, shift="auto")
+        # bonds along the y-axis, which cross the rank boundaries
+        bond = espressomd.interactions.HarmonicBond(k=10.0, r_0=1.25)
+        self.system.bonded_inter.add(bond)
+        for i in range(len(grid) - 8):
+            self.system.part[i].add_bond((bond, i + 8))
+        self.system.cell_system.set_domain_decomposition()
+        self.system.cell_system.use_soa_mirror = True
+
+    def tearDown(self):
+        self.system.part.clear()
+        self.system.bonded_inter.clear()
+        self.system.cell_system.use_soa_mirror = False
+        self.system.cell_system.overlap_ghost_communication = False
+
+    def run_trajectory(self, overlap):
+        self.system.cell_system.overlap_ghost_communication = overlap
+        self.system.part[:].pos = self.pos
+        self.system.part[:].v = self.vel
+        self.system.integrator.run(0)
+        forces = np.copy(self.system.part[:].f)
+        self.system.integrator.run(20)
+        energy = self.system.analysis.energy()
+        return {"initial forces": forces,
+                "pos": np.copy(self.system.part[:].pos),
+                "v": np.copy(self.system.part[:].v),
+                "f": np.copy(self.system.part[:].f),
+                "energy": energy["total"],
+                "non-bonded": energy["non_bonded"],
+                "bonded": energy["bonded"]}
+
+    def test_overlap(self):
+        ref = self.run_trajectory(overlap=False)
+        result = self.run_trajectory(overlap=True)
+        self.assertTrue(self.system.cell_system.overlap_ghost_communication)
+        self.assertGreater(np.max(np.abs(ref["initial forces"])), 1.0)
+        for key in ref:
+            np.testing.assert_allclose(result[key], ref[key], rtol=0,
+                                       atol=1e-9, err_msg=key)
+
+
+if __name__ == "__main__":
+    ut.main()
@@ -164,6 +164,54 @@ class LinearPolymerPositions(ut.TestCase):
         self.assertBondLength(positions, bond_length)
         self.assertMinDistGreaterEqual(positions, bond_length - 1e-10)
 
+    def test_min_dist_existing_particles(self):
+        """
+        Check that existing particles are rejected as neighbors if and
+        only if min_distance is given, also across the boundaries of the
+        cells in which the positions are looked up.
+
+        """
+        min_distance = 1.
+        np.random.seed(self.seed)
+
+        def positions_near_boundaries(n):
+            # 31 positions divide the box into 3 cells per direction,
+            # with boundaries at 0, box_l / 3 and 2 * box_l / 3
+            boundaries = np.random.randint(3, size=(n, 3)) * self.box_l / 3.
+            offsets = np.random.uniform(-0.6, 0.6, (n, 3))
+            return (boundaries + offsets) % self.box_l
+
+        existing = positions_near_boundaries(30)
+        self.system.part.add(pos=existing)
+
+        n_rejected = 0
+        for start in positions_near_boundaries(200):
+            start_positions = np.array([start])
+            positions = polymer.linear_polymer_positions(
+                n_polymers=1, beads_per_chain=1, bond_length=1.,
+                start_positions=start_positions, seed=self.seed)
+            np.testing.assert_array_equal(positions[0, 0], start)
+
+            d = existing - start
+            d -= self.box_l * np.round(d / self.box_l)
+            if np.min(np.linalg.norm(d, axis=1)) < min_distance:
+                n_rejected += 1
+                with self.assertRaisesRegex(Exception,
+                                            'Invalid start positions.'):
+                    polymer.linear_polymer_positions(
+                        n_polymers=1, beads_per_chain=1, bond_length=1.,
+                        start_positions=start_positions,
+                        min_distance=min_distance, seed=self.seed)
+            else:
+                positions = polymer.linear_polymer_positions(
+                    n_polymers=1, beads_per_chain=1, bond_length=1.,
+                    start_positions=start_positions,
+                    min_distance=min_distance, seed=self.seed)
+                np.testing.assert_array_equal(positions[0, 0], start)
+
+        self.assertGreater(n_rejected, 0)
+        self.system.part.clear()
+
     def test_respect_constraints_wall(self):
         """
         Check that constraints are respected.
@@ -18,6 +18,7 @@
 #
 
 import unittest as ut
+import unittest_decorators as utx
 import espressomd
 import espressomd.observables
 import numpy as np
@@ -104,6 +105,35 @@ class RdfTest(ut.TestCase):
 
         np.testing.assert_allclose(rdf10, rdf01)
 
+    @utx.skipIfMissingFeatures("LENNARD_JONES")
+    def test_cell_lists(self):
+        s = self.s
+        s.cell_system.skin = 0.4
+        s.non_bonded_inter[0, 0].lennard_jones.set_params(
+            epsilon=1., sigma=1., cutoff=1.5, shift="auto")
+        np.random.seed(42)
+        s.part.add(pos=np.random.random((500, 3)) * s.box_l,
+                   type=np.random.randint(2, size=500))
+        ids0 = s.part.select(type=0).id
+        ids1 = s.part.select(type=1).id
+
+        # overlapping sets, the common particles are not paired with
+        # themselves
+        ids_overlap = {'ids1': s.part[:].id[:300], 'ids2': s.part[:].id[200:]}
+        for ids in ({'ids1': s.part[:].id}, {'ids1': ids0, 'ids2': ids1},
+                    ids_overlap):
+            # within the range of the cells, evaluated on the cell lists
+            obs_cells = espressomd.observables.RDF(
+                min_r=0., max_r=1.5, n_r_bins=15, **ids)
+            # beyond the range of the cells, evaluated on the head node
+            obs_all = espressomd.observables.RDF(
+                min_r=0., max_r=4.5, n_r_bins=45, **ids)
+            np.testing.assert_allclose(
+                obs_cells.calculate(), obs_all.calculate()[:15],
+                rtol=1e-10, atol=1e-12)
+
+        s.non_bonded_inter[0, 0].lennard_jones.deactivate()
+
     def test_rdf_interface(self):
         # test setters and getters
         s = self.s
@@ -0,0 +1,137 @@
+#
+# Copyright (C) 2020 The ESPResSo project
+#
+# This file is part of ESPResSo.
+#
+# ESPResSo is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# ESPResSo is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#
+
+"""Testmodule for the energy change of the trial moves of the reaction
+methods, which is accumulated from the energies of the changed particles.
+"""
+import unittest as ut
+import unittest_decorators as utx
+import numpy as np
+import espressomd
+import espressomd.electrostatics
+import espressomd.interactions
+from espressomd import reaction_ensemble
+
+
+@utx.skipIfMissingFeatures(["LENNARD_JONES", "ELECTROSTATICS"])
+class ReactionParticleEnergiesTest(ut.TestCase):
+
+    """Compare the energy change of a Widom trial move, which is the excess
+       chemical potential of a single sample, to the difference of the total
+       potential energies of the system before and after the same change.
+       The reacting particle interacts via Lennard-Jones, Debye-Hueckel and
+       a harmonic bond with the surrounding particles."""
+
+    TYPE_REACTANT = 4
+    TYPE_PRODUCT = 5
+    CHARGE_REACTANT = -1.0
+    CHARGE_PRODUCT = 0.7
+    P_ID = 100
+
+    system = espressomd.System(box_l=3 * [9.0])
+    system.time_step = 0.01
+    system.cell_system.skin = 0.4
+    np.random.seed(42)
+
+    def setUp(self):
+        grid = 1.5 * np.array(np.meshgrid(*(3 * [np.arange(6)]),
+                                          indexing="ij")).reshape(3, -1).T
+        pos = grid + np.random.uniform(-0.1, 0.1, grid.shape)
+        types = np.arange(len(pos)) % 3
+        self.system.part.add(pos=pos, type=types,
+                             q=np.choose(types, [1.0, -1.0, 0.0]))
+        p = self.system.part[self.P_ID]
+        p.type = self.TYPE_REACTANT
+        p.q = self.CHARGE_REACTANT
+
+        for i in range(6):
+            for j in range(i, 6):
+                self.system.non_bonded_inter[i, j].lennard_jones.set_params(
+                    epsilon=1.0, sigma=1.0, cutoff=2.5, shift=0.0)
+        bond = espressomd.interactions.HarmonicBond(k=5.0, r_0=1.5)
+        self.system.bonded_inter.add(bond)
+        p.add_bond((bond, self.P_ID + 1))
+        self.system.actors.add(espressomd.electrostatics.DH(
+            prefactor=1.0, kappa=1.0, r_cut=2.0))
+
+    def tearDown(self):
+        self.system.actors.clear()
+        self.system.part.clear()
+        self.system.bonded_inter.clear()
+
+    def potential_energy(self):
+        energy = self.system.analysis.energy()
+        return energy["total"] - energy["kinetic"]
+
+    def reference_energy_change(self, new_type, new_charge):
+        p = self.system.part[self.P_ID]
+        E_old = self.potential_energy()
+        p.type = new_type
+        p.q = new_charge
+        E_new = self.potential_energy()
+        p.type = self.TYPE_REACTANT
+        p.q = self.CHARGE_REACTANT
+        return E_new - E_old
+
+    def widom_energy_change(self, product_types):
+        widom = reaction_ensemble.WidomInsertion(temperature=1.0, seed=42)
+        widom.add_reaction(
+            reactant_types=[self.TYPE_REACTANT],
+            reactant_coefficients=[1],
+            product_types=product_types,
+            product_coefficients=len(product_types) * [1],
+            default_charges={self.TYPE_REACTANT: self.CHARGE_REACTANT,
+                             self.TYPE_PRODUCT: self.CHARGE_PRODUCT},
+            check_for_electroneutrality=False)
+        # with a single sample, the excess chemical potential is the energy
+        # change of the trial move
+        return widom.measure_excess_chemical_potential(0)[0]
+
+    def check_energy_changes(self):
+        p = self.system.part[self.P_ID]
+        widom = reaction_ensemble.WidomInsertion(temperature=1.0, seed=42)
+        non_interacting_type = widom.get_non_interacting_type()
+
+        # replace the particle
+        ref = self.reference_energy_change(
+            self.TYPE_PRODUCT, self.CHARGE_PRODUCT)
+        self.assertGreater(abs(ref), 0.1)
+        self.assertAlmostEqual(
+            self.widom_energy_change([self.TYPE_PRODUCT]), ref, delta=1e-11)
+        # hide the particle
+        ref = self.reference_energy_change(non_interacting_type, 0.0)
+        self.assertGreater(abs(ref), 0.1)
+        self.assertAlmostEqual(
+            self.widom_energy_change([]), ref, delta=1e-11)
+
+        # the trial moves are reverted
+        self.assertEqual(p.type, self.TYPE_REACTANT)
+        self.assertEqual(p.q, self.CHARGE_REACTANT)
+
+    def test_domain_decomposition(self):
+        self.system.cell_system.set_domain_decomposition()
+        self.check_energy_changes()
+
+    def test_n_square(self):
+        self.system.cell_system.set_n_square()
+        self.check_energy_changes()
+
+
+if __name__ == "__main__":
+    ut.main()
@@ -0,0 +1,116 @@
+# Copyright (C) 2021 The ESPResSo project
+#
+# This file is part of ESPResSo.
+#
+# ESPResSo is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# ESPResSo is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+import unittest as ut
+import unittest_decorators as utx
+import numpy as np
+import espressomd
+import espressomd.electrostatics
+
+
+@utx.skipIfMissingFeatures(["LENNARD_JONES", "WCA"])
+class SplineTabulation(ut.TestCase):
+    system = espressomd.System(box_l=[10., 10., 10.])
+    system.time_step = 0.01
+    system.cell_system.skin = 0.4
+
+    def setUp(self):
+        np.random.seed(42)
+        grid = np.mgrid[0:10, 0:10, 0:5].reshape(3, -1).T
+        pos = grid * [1., 1., 2.] + np.random.normal(0., 0.05, grid.shape)
+        self.system.part.add(pos=pos, type=np.arange(len(pos)) % 2)
+        self.system.non_bonded_inter[0, 0].lennard_jones.set_params(
+            epsilon=1., sigma=1., cutoff=2.5, shift="auto")
+        self.system.non_bonded_inter[0, 1].lennard_jones.set_params(
+            epsilon=0.5, sigma=1.1, cutoff=2., shift="auto")
+        self.system.non_bonded_inter[1, 1].wca.set_params(
+            epsilon=1., sigma=1.)
+
+    def tearDown(self):
+        self.system.non_bonded_inter.disable_spline_tabulation()
+        self.system.non_bonded_inter.reset()
+        self.system.actors.clear()
+        self.system.part.clear()
+        self.system.cell_system.set_domain_decomposition()
+
+    def compare_forces(self):
+        self.system.integrator.run(0, recalc_forces=True)
+        f_analytic = np.copy(self.system.part[:].f)
+        self.system.non_bonded_inter.set_spline_tabulation(
+            tolerance=1e-7, min_distance=0.5)
+        self.system.integrator.run(0, recalc_forces=True)
+        f_tabulated = np.copy(self.system.part[:].f)
+        np.testing.assert_allclose(f_tabulated, f_analytic,
+                                   atol=1e-5 * np.max(np.abs(f_analytic)))
+
+    def test_parameters(self):
+        inter = self.system.non_bonded_inter
+        self.assertEqual(inter.get_spline_tabulation()["tolerance"], 0.)
+        self.assertEqual(inter.get_spline_tabulation()["tables"], [])
+
+        inter.set_spline_tabulation(tolerance=1e-5, min_distance=0.6)
+        params = inter.get_spline_tabulation()
+        self.assertEqual(params["tolerance"], 1e-5)
+        self.assertEqual(params["min_distance"], 0.6)
+        tables = {(t["type_a"], t["type_b"]): t for t in params["tables"]}
+        for key in [(0, 0), (0, 1), (1, 1)]:
+            self.assertTrue(tables[key]["tabulated"])
+            self.assertGreater(tables[key]["n_intervals"], 0)
+            self.assertLessEqual(tables[key]["deviation"], 1e-5)
+
+        inter.disable_spline_tabulation()
+        self.assertEqual(inter.get_spline_tabulation()["tables"], [])
+
+        with self.assertRaises(ValueError):
+            inter.set_spline_tabulation(tolerance=0.)
+        with self.assertRaises(ValueError):
+            inter.set_spline_tabulation(min_distance=-1.)
+
+    def test_forces(self):
+        self.compare_forces()
+
+    def test_forces_n_square(self):
+        # the N-square cell system does not update the cutoffs when the
+        # interactions change, the tables have to pick up the new potential
+        self.system.cell_system.set_n_square(use_verlet_lists=False)
+        inter = self.system.non_bonded_inter
+        inter.set_spline_tabulation(tolerance=1e-7, min_distance=0.5)
+        self.system.integrator.run(0, recalc_forces=True)
+        inter[0, 1].wca.set_params(epsilon=1., sigma=1.)
+        self.system.integrator.run(0, recalc_forces=True)
+        f_tabulated = np.copy(self.system.part[:].f)
+        inter.disable_spline_tabulation()
+        self.system.integrator.run(0, recalc_forces=True)
+        f_analytic = np.copy(self.system.part[:].f)
+        np.testing.assert_allclose(f_tabulated, f_analytic,
+                                   atol=1e-5 * np.max(np.abs(f_analytic)))
+
+    @utx.skipIfMissingFeatures(["ELECTROSTATICS"])
+    def test_forces_debye_hueckel(self):
+        self.system.part[:].q = np.resize([1., -1.], len(self.system.part))
+        self.system.actors.add(espressomd.electrostatics.DH(
+            prefactor=1.2, kappa=0.8, r_cut=3.))
+        self.compare_forces()
+
+        tables = self.system.non_bonded_inter.get_spline_tabulation()[
+            "tables"]
+        coulomb = [t for t in tables if t["type_a"] == -1][0]
+        self.assertTrue(coulomb["tabulated"])
+        self.assertLessEqual(coulomb["deviation"], 1e-7)
+
+
+if __name__ == "__main__":
+    ut.main()
@@ -0,0 +1,51 @@
+# Copyright (C) 2021 The ESPResSo project
+#
+# This file is part of ESPResSo.
+#
+# ESPResSo is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# ESPResSo is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+import unittest as ut
+import espressomd
+
+
+class Timings(ut.TestCase):
+    system = espressomd.System(box_l=[10., 10., 10.])
+    system.time_step = 0.01
+    system.cell_system.skin = 0.4
+
+    def test(self):
+        system = self.system
+        system.part.add(pos=[[1., 1., 1.], [1.5, 1., 1.], [5., 5., 5.]])
+        system.timings.reset()
+
+        timings = system.timings.get()
+        self.assertIn("force_calc", timings)
+        self.assertIn("ghost_communication", timings)
+        for t in timings.values():
+            self.assertEqual(t["calls"], 0)
+            self.assertEqual(t["max"], 0.)
+
+        system.integrator.run(10)
+        timings = system.timings.get()
+        self.assertEqual(timings["force_calc"]["calls"], 11)
+        for t in timings.values():
+            self.assertLessEqual(t["min"], t["avg"])
+            self.assertLessEqual(t["avg"], t["max"])
+        self.assertGreater(timings["force_calc"]["max"], 0.)
+
+        system.timings.reset()
+        self.assertEqual(system.timings.get()["force_calc"]["calls"], 0)
+
+
+if __name__ == "__main__":
+    ut.main()